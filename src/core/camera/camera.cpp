@@ -32,12 +32,14 @@ Point3 Camera::ToWorldSpace(const Point3& cameraSpacePoint)
 
 Vector3 Camera::ToCameraSpace(const Vector3& worldSpaceVector)
 {
-    return m_Transform.Inversed()(worldSpaceVector);
+    UpdateConstants();
+    return m_WorldToCamera(worldSpaceVector);
 }
 
 Point3 Camera::ToCameraSpace(const Point3& worldSpacePoint)
 {
-    return m_Transform.Inversed()(worldSpacePoint);
+    UpdateConstants();
+    return m_WorldToCamera(worldSpacePoint);
 }
 
 Point3 Camera::ToCameraSpace(const Point2i& filmSpacePoint)
@@ -47,3 +49,49 @@ Point3 Camera::ToCameraSpace(const Point2i& filmSpacePoint)
     return { filmSpacePoint.x - halfFilmWidth, halfFilmHeight - filmSpacePoint.y, 1.0 };
 }
 
+
+void Camera::GenerateRays(RayBuffer& rays)
+{
+    for (int i = 0; i < rays.GetSize(); ++i)
+        rays.SetRay(i, GenerateRay(rays.GetPixel(i), rays.GetOffset(i)));
+}
+
+void Camera::GenerateRays(const FilmTile& tile, RayBuffer& rays, const Vector2& offset)
+{
+    rays.SetTileSamples(tile, offset);
+    GenerateRays(rays);
+}
+
+void Camera::UpdateConstants()
+{
+    // Only explicit setters mark the constants dirty. The transform and film may
+    // be changed through references obtained earlier, so their state is compared.
+    if (AreConstantsCurrent(std::memory_order_acquire))
+        return;
+
+    std::lock_guard<std::mutex> lock(m_ConstantsMutex);
+    if (!AreConstantsCurrent(std::memory_order_relaxed))
+    {
+        ComputeConstants();
+        m_TransformRevision.store(m_Transform.GetRevision(), std::memory_order_relaxed);
+        m_FilmWidth.store(m_Film.GetResolution().GetWidth(), std::memory_order_relaxed);
+        m_FilmHeight.store(m_Film.GetResolution().GetHeight(), std::memory_order_relaxed);
+        m_ConstantsDirty.store(false, std::memory_order_release);
+    }
+}
+
+bool Camera::AreConstantsCurrent(std::memory_order order) const
+{
+    return !m_ConstantsDirty.load(order) &&
+           m_TransformRevision.load(std::memory_order_relaxed) == m_Transform.GetRevision() &&
+           m_FilmWidth.load(std::memory_order_relaxed) == m_Film.GetResolution().GetWidth() &&
+           m_FilmHeight.load(std::memory_order_relaxed) == m_Film.GetResolution().GetHeight();
+}
+
+void Camera::ComputeConstants()
+{
+    m_CameraToWorld = m_Transform.GetMatrix();
+    m_WorldToCamera = m_Transform.Inversed();
+    m_HalfFilmWidth = m_Film.GetResolution().GetWidth() / 2.0;
+    m_HalfFilmHeight = m_Film.GetResolution().GetHeight() / 2.0;
+}
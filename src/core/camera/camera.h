@@ -21,6 +21,9 @@
 #pragma once
 
 #include "core/film/film.h"
+#include "math/raybuffer.h"
+
+#include <atomic>
 
 class Camera
 {
@@ -29,18 +32,33 @@ public:
     ~Camera() = default;
 
 public:
+    // Callers may change the camera through the returned references. The cached
+    // per camera constants track the transform revision and film resolution,
+    // and are refreshed before the next ray once either changed.
     inline Transform& GetTransform() { return m_Transform; }
     inline Film& GetFilm() { return m_Film; }
+    inline const Transform& GetTransform() const { return m_Transform; }
+    inline const Film& GetFilm() const { return m_Film; }
 
 public:
     virtual Ray GenerateRay(const Point2i& filmSpacePos, const Vector2& offset) = 0;
 
+    // Generates the ray of every sample in rays, as GenerateRay would for its
+    // pixel and offset. Safe to call from several threads at once, as long as
+    // the camera is not changed at the same time. Cameras override this with
+    // a loop over the buffer's arrays, the default calls GenerateRay per ray.
+    virtual void GenerateRays(RayBuffer& rays);
+
+    // Fills rays with one ray per pixel of tile, in row-major order
+    void GenerateRays(const FilmTile& tile, RayBuffer& rays, const Vector2& offset = {});
+
 protected:
     friend class CameraTest_CanTransformCameraPointToWorldSpace_Test;
     friend class CameraTest_CanTransformCameraVectorToWorldSpace_Test;
     friend class CameraTest_CanTranformFilmPointToCameraSpace_Test;
     friend class CameraTest_CanTransformWorldVectorToCameraSpace_Test;
     friend class CameraTest_CanTransformWorldPointToCameraSpace_Test;
+    friend class CameraTest_CachedWorldToCameraFollowsTransform_Test;
 
     Vector3 ToWorldSpace(const Vector3& cameraSpaceVector);
     Point3 ToWorldSpace(const Point3& cameraSpacePoint);
@@ -49,8 +67,25 @@ protected:
     Point3 ToCameraSpace(const Point3& worldSpacePoint);
     Point3 ToCameraSpace(const Point2i& filmSpacePoint);
 
+protected:
+    // Recomputes the constants if the camera changed since the last call
+    void UpdateConstants();
+    bool AreConstantsCurrent(std::memory_order order) const;
+    virtual void ComputeConstants();
+
 protected:
     Transform m_Transform;
     Film m_Film;
+
+    std::atomic_bool m_ConstantsDirty = true;
+    std::atomic_uint64_t m_TransformRevision = 0;
+    std::atomic_int m_FilmWidth = 0;
+    std::atomic_int m_FilmHeight = 0;
+    std::mutex m_ConstantsMutex;
+
+    Matrix4x4 m_CameraToWorld;
+    Transform m_WorldToCamera;
+    double m_HalfFilmWidth = 0;
+    double m_HalfFilmHeight = 0;
 };
 
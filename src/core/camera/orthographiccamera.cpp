@@ -26,16 +26,60 @@ OrthographicCamera::OrthographicCamera(double size)
 }
 
 Ray OrthographicCamera::GenerateRay(const Point2i& filmSpacePos, const Vector2& offset)
+{
+    UpdateConstants();
+
+    Point3 cameraSpaceOrigin(
+        (filmSpacePos.x - m_HalfFilmWidth + offset.x) * m_ScaledSize,
+        (m_HalfFilmHeight - filmSpacePos.y + offset.y) * m_ScaledSize,
+        0);
+
+    return Ray(m_Transform(cameraSpaceOrigin), m_DirectionWs);
+}
+
+void OrthographicCamera::GenerateRays(RayBuffer& rays)
+{
+    UpdateConstants();
+
+    // Camera transforms are affine, so points need no perspective divide
+    const Matrix4x4& m = m_CameraToWorld;
+    const double m11 = m.m_11, m12 = m.m_12, m14 = m.m_14;
+    const double m21 = m.m_21, m22 = m.m_22, m24 = m.m_24;
+    const double m31 = m.m_31, m32 = m.m_32, m34 = m.m_34;
+    const double halfWidth = m_HalfFilmWidth;
+    const double halfHeight = m_HalfFilmHeight;
+    const double scale = m_ScaledSize;
+
+    const int* pixelX = rays.GetPixelX();
+    const int* pixelY = rays.GetPixelY();
+    const double* offsetX = rays.GetOffsetX();
+    const double* offsetY = rays.GetOffsetY();
+    double* originX = rays.GetOriginX();
+    double* originY = rays.GetOriginY();
+    double* originZ = rays.GetOriginZ();
+
+    int size = rays.GetSize();
+    for (int i = 0; i < size; ++i)
+    {
+        double x = (pixelX[i] - halfWidth + offsetX[i]) * scale;
+        double y = (halfHeight - pixelY[i] + offsetY[i]) * scale;
+
+        originX[i] = m11 * x + m12 * y + m14;
+        originY[i] = m21 * x + m22 * y + m24;
+        originZ[i] = m31 * x + m32 * y + m34;
+    }
+
+    std::fill(rays.GetDirectionX(), rays.GetDirectionX() + size, m_DirectionWs.x);
+    std::fill(rays.GetDirectionY(), rays.GetDirectionY() + size, m_DirectionWs.y);
+    std::fill(rays.GetDirectionZ(), rays.GetDirectionZ() + size, m_DirectionWs.z);
+}
+
+void OrthographicCamera::ComputeConstants()
 {
     // Add an empirical scale such that size=1 is consistent with perspective camera
     const double sizeScale = 0.005;
-    const double scaledSize = m_Size * sizeScale;
-    Point3 cameraSpaceFilmPoint = ToCameraSpace(filmSpacePos);
-    cameraSpaceFilmPoint.x += offset.x;
-    cameraSpaceFilmPoint.y += offset.y;
-
-    Point3 rayOriginWs = ToWorldSpace(Point3(cameraSpaceFilmPoint.x * scaledSize, cameraSpaceFilmPoint.y * scaledSize, 0));
-    Vector3 rayDirectionWs = ToWorldSpace(Vector3(0, 0, 1));
-    return Ray(rayOriginWs, rayDirectionWs);
-}
 
+    Camera::ComputeConstants();
+    m_ScaledSize = m_Size * sizeScale;
+    m_DirectionWs = m_Transform(Vector3(0, 0, 1)).Normalized();
+}
@@ -30,12 +30,20 @@ public:
 
 public:
     inline double GetSize() const { return m_Size; }
-    inline void SetSize(double size) { m_Size = size; }
+    inline void SetSize(double size) { m_Size = size; m_ConstantsDirty = true; }
 
 public:
     Ray GenerateRay(const Point2i& filmSpacePos, const Vector2& offset = {}) override;
+    void GenerateRays(RayBuffer& rays) override;
+    using Camera::GenerateRays;
+
+protected:
+    void ComputeConstants() override;
 
 protected:
     double m_Size;
+
+    double m_ScaledSize = 0;
+    Vector3 m_DirectionWs;
 };
 
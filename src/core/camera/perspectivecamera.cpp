@@ -27,16 +27,64 @@ PerspectiveCamera::PerspectiveCamera(double fovH)
 
 Ray PerspectiveCamera::GenerateRay(const Point2i& filmSpacePos, const Vector2& offset)
 {
-    double halfFovH = m_HorizontalFov / 2.0;
-    double filmZPlane = (m_Film.GetResolution().GetWidth() / 2.0) / std::tan(Math::DegToRad(halfFovH));
+    UpdateConstants();
 
-    Point3 cameraSpaceFilmPoint = ToCameraSpace(filmSpacePos);
-    cameraSpaceFilmPoint.x += offset.x;
-    cameraSpaceFilmPoint.y += offset.y;
-    cameraSpaceFilmPoint.z *= filmZPlane;
+    Vector3 cameraSpaceDirection(
+        filmSpacePos.x - m_HalfFilmWidth + offset.x,
+        m_HalfFilmHeight - filmSpacePos.y + offset.y,
+        m_FilmZPlane);
 
-    Point3 rayOriginWs = ToWorldSpace(Point3(0, 0, 0));
-    Vector3 rayDirectionWs = ToWorldSpace(cameraSpaceFilmPoint - Point3(0, 0, 0));
-    return Ray(rayOriginWs, rayDirectionWs);
+    return Ray(m_OriginWs, m_Transform(cameraSpaceDirection));
 }
 
+void PerspectiveCamera::GenerateRays(RayBuffer& rays)
+{
+    UpdateConstants();
+
+    const Matrix4x4& m = m_CameraToWorld;
+    const double m11 = m.m_11, m12 = m.m_12, m13 = m.m_13;
+    const double m21 = m.m_21, m22 = m.m_22, m23 = m.m_23;
+    const double m31 = m.m_31, m32 = m.m_32, m33 = m.m_33;
+    const double halfWidth = m_HalfFilmWidth;
+    const double halfHeight = m_HalfFilmHeight;
+    const double filmZ = m_FilmZPlane;
+
+    const int* pixelX = rays.GetPixelX();
+    const int* pixelY = rays.GetPixelY();
+    const double* offsetX = rays.GetOffsetX();
+    const double* offsetY = rays.GetOffsetY();
+    double* originX = rays.GetOriginX();
+    double* originY = rays.GetOriginY();
+    double* originZ = rays.GetOriginZ();
+    double* directionX = rays.GetDirectionX();
+    double* directionY = rays.GetDirectionY();
+    double* directionZ = rays.GetDirectionZ();
+
+    // Plain loops over the separate arrays, which compilers vectorize
+    int size = rays.GetSize();
+    for (int i = 0; i < size; ++i)
+    {
+        double x = pixelX[i] - halfWidth + offsetX[i];
+        double y = halfHeight - pixelY[i] + offsetY[i];
+
+        double dx = m11 * x + m12 * y + m13 * filmZ;
+        double dy = m21 * x + m22 * y + m23 * filmZ;
+        double dz = m31 * x + m32 * y + m33 * filmZ;
+        double invLength = 1.0 / std::sqrt(dx * dx + dy * dy + dz * dz);
+
+        directionX[i] = dx * invLength;
+        directionY[i] = dy * invLength;
+        directionZ[i] = dz * invLength;
+    }
+
+    std::fill(originX, originX + size, m_OriginWs.x);
+    std::fill(originY, originY + size, m_OriginWs.y);
+    std::fill(originZ, originZ + size, m_OriginWs.z);
+}
+
+void PerspectiveCamera::ComputeConstants()
+{
+    Camera::ComputeConstants();
+    m_FilmZPlane = m_HalfFilmWidth / std::tan(Math::DegToRad(m_HorizontalFov / 2.0));
+    m_OriginWs = m_Transform(Point3(0, 0, 0));
+}
@@ -30,11 +30,20 @@ public:
 
 public:
     inline double GetHorizontalFov() const { return m_HorizontalFov; }
-    inline void SetHorizontalFov(double fovH) { m_HorizontalFov = fovH; }
+    inline void SetHorizontalFov(double fovH) { m_HorizontalFov = fovH; m_ConstantsDirty = true; }
 
 public:
     Ray GenerateRay(const Point2i& filmSpacePos, const Vector2& offset = {}) override;
+    void GenerateRays(RayBuffer& rays) override;
+    using Camera::GenerateRays;
+
+protected:
+    void ComputeConstants() override;
 
 protected:
     double m_HorizontalFov;
+
+    // Distance of the film plane for which the film spans the horizontal fov
+    double m_FilmZPlane = 0;
+    Point3 m_OriginWs;
 };
@@ -0,0 +1,80 @@
+/*
+    This file is part of Spectre, an open-source physically based
+    spectral raytracing library.
+
+    Copyright (c) 2020-2023 Samuel Van Allen - All rights reserved.
+
+    Spectre is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "adaptivetilescheduler.h"
+
+AdaptiveTileScheduler::AdaptiveTileScheduler(const Film& film, const AdaptiveSamplingSettings& settings)
+    : m_Film(film)
+    , m_Settings(settings)
+    , m_NumSamples(film.GetNumTiles(), 0)
+    , m_NumPasses(0)
+{
+    if (!film.HasStatistics())
+        throw std::invalid_argument("Adaptive sampling needs a film that tracks statistics");
+
+    if (settings.m_TargetError <= 0.0 || settings.m_MinSamples <= 0 || settings.m_SamplesPerPass <= 0 || settings.m_MaxPassShare < 1 || settings.m_MaxSamples < settings.m_MinSamples)
+        throw std::invalid_argument("Invalid adaptive sampling settings");
+}
+
+std::vector<TileWork> AdaptiveTileScheduler::NextPass()
+{
+    std::vector<TileWork> work;
+    int numTiles = (int)m_NumSamples.size();
+
+    if (m_NumPasses == 0)
+    {
+        for (int i = 0; i < numTiles; ++i)
+            work.push_back({ i, 0, m_Settings.m_MinSamples });
+    }
+    else
+    {
+        // Error of every tile that is not done yet, relative to the target
+        std::vector<std::pair<int, double>> active;
+        double totalError = 0.0;
+        for (int i = 0; i < numTiles; ++i)
+        {
+            double error = m_Film.GetTile(i).GetError();
+            if (m_NumSamples[i] >= m_Settings.m_MaxSamples || error <= m_Settings.m_TargetError)
+                continue;
+
+            // Tiles without an estimate yet, such as a tile of single sample pixels, get the largest share
+            double weight = std::isfinite(error) ? error / m_Settings.m_TargetError : 1e3;
+            active.push_back({ i, weight });
+            totalError += weight;
+        }
+
+        double budget = (double)m_Settings.m_SamplesPerPass * numTiles;
+        double maxShare = (double)m_Settings.m_SamplesPerPass * m_Settings.m_MaxPassShare;
+        for (const auto& [index, weight] : active)
+        {
+            int share = std::max(1, (int)std::lround(std::min(budget * weight / totalError, maxShare)));
+            int numSamples = std::min(share, m_Settings.m_MaxSamples - m_NumSamples[index]);
+            work.push_back({ index, m_NumSamples[index], numSamples });
+        }
+    }
+
+    for (const TileWork& tile : work)
+        m_NumSamples[tile.m_TileIndex] += tile.m_NumSamples;
+
+    if (!work.empty())
+        m_NumPasses++;
+
+    return work;
+}
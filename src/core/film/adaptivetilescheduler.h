@@ -0,0 +1,80 @@
+/*
+    This file is part of Spectre, an open-source physically based
+    spectral raytracing library.
+
+    Copyright (c) 2020-2023 Samuel Van Allen - All rights reserved.
+
+    Spectre is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "film.h"
+
+struct AdaptiveSamplingSettings
+{
+    // Relative pixel error below which a tile counts as converged
+    double m_TargetError = 0.01;
+
+    // Samples per pixel every tile gets in the first pass, before any error is estimated
+    int m_MinSamples = 16;
+
+    // Samples per pixel no tile goes beyond, however noisy
+    int m_MaxSamples = 1024;
+
+    // Average samples per pixel handed out per tile and pass. The budget of
+    // converged tiles goes to the remaining ones, up to m_MaxPassShare.
+    int m_SamplesPerPass = 16;
+
+    // Most samples a single tile gets in one pass, as a multiple of
+    // m_SamplesPerPass. Keeps a few noisy tiles from turning a pass into one
+    // long serial task, and lets their error be checked again before they
+    // overshoot the target.
+    int m_MaxPassShare = 4;
+};
+
+struct TileWork
+{
+    int m_TileIndex;
+    int m_FirstSample;
+    int m_NumSamples;
+};
+
+// Decides per pass which tiles of a film still need samples, and how many.
+// Tiles whose error is below the target, or that reached the sample limit,
+// are done. The samples of each pass are split over the remaining tiles in
+// proportion to their error, so the noisiest regions converge fastest.
+//
+// The film must track statistics, and the tiles of one pass must be sampled
+// completely before asking for the next one.
+class AdaptiveTileScheduler
+{
+public:
+    AdaptiveTileScheduler(const Film& film, const AdaptiveSamplingSettings& settings = {});
+
+public:
+    inline const AdaptiveSamplingSettings& GetSettings() const { return m_Settings; }
+    inline int GetNumSamples(int tileIndex) const { return m_NumSamples[tileIndex]; }
+    inline int GetNumPasses() const { return m_NumPasses; }
+
+public:
+    // Work of the next pass, empty once every tile is done
+    std::vector<TileWork> NextPass();
+
+private:
+    const Film& m_Film;
+    AdaptiveSamplingSettings m_Settings;
+    std::vector<int> m_NumSamples;
+    int m_NumPasses;
+};
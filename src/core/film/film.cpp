@@ -21,7 +21,10 @@
 #include "film.h"
 
 Film::Film()
-    : m_TileSize(64)
+    : m_Filter(CreateFilter(FilterType::Box))
+    , m_FilterTable(std::make_shared<FilterTable>(*m_Filter))
+    , m_TrackStatistics(false)
+    , m_TileSize(64)
 {
     SetupTiles();
 }
@@ -31,6 +34,11 @@ FilmTile& Film::GetTile(int index)
     return m_Tiles[index];
 }
 
+const FilmTile& Film::GetTile(int index) const
+{
+    return m_Tiles[index];
+}
+
 FilmTile& Film::GetTile(const Point2i& position)
 {
     return GetTile(GetTileIndex(position));
@@ -40,21 +48,120 @@ void Film::SetResolution(const Resolution& resolution)
 {
     m_Resolution = resolution;
     SetupTiles();
+
+    if (m_Splats != nullptr)
+    {
+        double scale = m_Splats->GetScale();
+        EnableSplats(m_Splats->GetMode());
+        m_Splats->SetScale(scale);
+    }
+}
+
+void Film::EnableStatistics()
+{
+    m_TrackStatistics = true;
+    for (FilmTile& tile : m_Tiles)
+        tile.EnableStatistics();
+}
+
+double Film::GetError() const
+{
+    if (!m_TrackStatistics)
+        return std::numeric_limits<double>::infinity();
+
+    double maxError = 0.0;
+    for (const FilmTile& tile : m_Tiles)
+        maxError = std::max(maxError, tile.GetError());
+
+    return maxError;
+}
+
+void Film::EnableSplats(SplatMode mode)
+{
+    m_Splats = std::make_shared<SplatBuffer>(m_Resolution, mode);
+}
+
+SplatBuffer& Film::GetSplats()
+{
+    if (m_Splats == nullptr)
+        throw std::runtime_error("Film has no splat layer");
+
+    return *m_Splats;
+}
+
+const SplatBuffer& Film::GetSplats() const
+{
+    return const_cast<Film*>(this)->GetSplats();
+}
+
+void Film::FinishSplats()
+{
+    if (m_Splats != nullptr)
+        m_Splats->Reduce();
 }
 
 void Film::SetupTiles()
 {
     m_Tiles.clear();
+    m_NumTilesX = (m_Resolution.GetWidth() + m_TileSize - 1) / m_TileSize;
+    m_NumTilesY = (m_Resolution.GetHeight() + m_TileSize - 1) / m_TileSize;
+    m_Tiles.reserve(static_cast<size_t>(m_NumTilesX) * m_NumTilesY);
 
+    // All tiles share one buffer, each in its own cache line aligned block
+    std::vector<std::pair<Point2i, Vector2i>> tiles;
+    size_t storageSize = 0;
     for (int y = 0; y < m_Resolution.GetHeight(); y += m_TileSize)
     {
         for (int x = 0; x < m_Resolution.GetWidth(); x += m_TileSize)
         {
             int sizeX = std::min(m_TileSize, m_Resolution.GetWidth() - x);
             int sizeY = std::min(m_TileSize, m_Resolution.GetHeight() - y);
-            m_Tiles.push_back(FilmTile({ x, y }, { sizeX, sizeY }));
+            tiles.push_back({ { x, y }, { sizeX, sizeY } });
+            storageSize += GetTileStorageSize({ sizeX, sizeY });
         }
     }
+
+    m_Buffer = std::make_shared<FilmBuffer>(storageSize);
+    m_Buffer->Clear();
+
+    size_t offset = 0;
+    for (const auto& [position, size] : tiles)
+    {
+        m_Tiles.push_back(FilmTile(position, size, m_FilterTable, m_Buffer, offset));
+        offset += GetTileStorageSize(size);
+
+        if (m_TrackStatistics)
+            m_Tiles.back().EnableStatistics();
+    }
+}
+
+void Film::AllocateStorage(bool clear)
+{
+    // Every run of tiles on one NUMA node starts on a fresh page, so that no
+    // page is first touched from two nodes
+    std::vector<size_t> offsets;
+    offsets.reserve(m_Tiles.size());
+    size_t storageSize = 0;
+    for (size_t i = 0; i < m_Tiles.size(); ++i)
+    {
+        if (i > 0 && m_Tiles[i].GetNumaNode() != m_Tiles[i - 1].GetNumaNode())
+            storageSize = FilmBuffer::PadToPage(storageSize);
+
+        offsets.push_back(storageSize);
+        storageSize += GetTileStorageSize(m_Tiles[i].GetSize());
+    }
+
+    m_Buffer = std::make_shared<FilmBuffer>(storageSize);
+    if (clear)
+        m_Buffer->Clear();
+
+    for (size_t i = 0; i < m_Tiles.size(); ++i)
+        m_Tiles[i].BindStorage(m_Buffer, offsets[i]);
+}
+
+size_t Film::GetTileStorageSize(const Vector2i& size) const
+{
+    return FilmBuffer::PadToCacheLine(FilmTile::GetStorageSize(size, m_FilterTable->GetApron()));
 }
 
 int Film::GetTileIndex(const Point2i& position) const
@@ -64,14 +171,48 @@ int Film::GetTileIndex(const Point2i& position) const
 
     int x = position.x / m_TileSize;
     int y = position.y / m_TileSize;
-    int numTilesX = (int)std::ceil(m_Resolution.GetWidth() / (double)m_TileSize);
-    return x + y * numTilesX;
+    return x + y * m_NumTilesX;
 }
 
 int Film::GetNumTiles() const
 {
-    double numTilesX = m_Resolution.GetWidth() / (double)m_TileSize;
-    double numTilesY = m_Resolution.GetHeight() / (double)m_TileSize;
-    return (int)std::ceil(numTilesX) * (int)std::ceil(numTilesY);
+    return m_NumTilesX * m_NumTilesY;
 }
 
+void Film::SetFilter(std::shared_ptr<const Filter> filter)
+{
+    if (filter == nullptr)
+        throw std::invalid_argument("Film needs a reconstruction filter");
+
+    m_Filter = std::move(filter);
+    m_FilterTable = std::make_shared<FilterTable>(*m_Filter);
+    SetupTiles();
+}
+
+void Film::GatherAprons(int index)
+{
+    int apron = m_FilterTable->GetApron();
+    if (apron == 0)
+        return;
+
+    // Tiles are a regular grid, so only tiles within the apron distance in tile units can overlap
+    int reach = (apron + m_TileSize - 1) / m_TileSize;
+    int tileX = index % m_NumTilesX;
+    int tileY = index / m_NumTilesX;
+    FilmTile& tile = m_Tiles[index];
+
+    for (int y = std::max(tileY - reach, 0); y <= std::min(tileY + reach, m_NumTilesY - 1); ++y)
+    {
+        for (int x = std::max(tileX - reach, 0); x <= std::min(tileX + reach, m_NumTilesX - 1); ++x)
+            tile.MergeApron(m_Tiles[x + y * m_NumTilesX]);
+    }
+}
+
+void Film::MergeAprons()
+{
+    for (int i = 0; i < GetNumTiles(); ++i)
+        GatherAprons(i);
+
+    for (FilmTile& tile : m_Tiles)
+        tile.ClearApron();
+}
@@ -22,6 +22,8 @@
 
 #include "resolution.h"
 #include "filmtile.h"
+#include "splatbuffer.h"
+#include "filter/filter.h"
 
 class Film
 {
@@ -33,22 +35,68 @@ public:
     inline const Resolution& GetResolution() const { return m_Resolution; }
     inline int GetNumPixels() const { return m_Resolution.GetArea(); }
     inline int GetTileSize() const { return m_TileSize; }
+    inline const Filter& GetFilter() const { return *m_Filter; }
+
+    // Pixel storage of all tiles, one padded block per tile in tile order
+    inline const FilmBuffer& GetBuffer() const { return *m_Buffer; }
 
 public:
     void SetResolution(const Resolution& resolution);
 
     FilmTile& GetTile(int index);
     FilmTile& GetTile(const Point2i& position);
+    const FilmTile& GetTile(int index) const;
     int GetNumTiles() const;
 
+    // Replaces the reconstruction filter, which recreates and so clears all tiles
+    void SetFilter(std::shared_ptr<const Filter> filter);
+
+    // Adds the aprons of the tiles around the tile at index to it. Every tile
+    // only writes itself, so all tiles can gather concurrently, but the aprons
+    // may only be cleared once every tile has gathered.
+    void GatherAprons(int index);
+
+    // Gathers the aprons into all tiles and clears them, to be called once all tiles are rendered
+    void MergeAprons();
+
+    // Tracks per pixel luminance statistics in every tile, see FilmTile::EnableStatistics
+    void EnableStatistics();
+    inline bool HasStatistics() const { return m_TrackStatistics; }
+
+    // Largest relative pixel error over all tiles, infinite without statistics
+    double GetError() const;
+
+    // Adds a splat layer for samples written from any thread, replacing an existing one
+    void EnableSplats(SplatMode mode);
+    inline bool HasSplats() const { return m_Splats != nullptr; }
+    SplatBuffer& GetSplats();
+    const SplatBuffer& GetSplats() const;
+
+    // Reduces the per thread splat layers, to be called once all splats are
+    // added and before the film is exported. Does nothing without splats.
+    void FinishSplats();
+
+    // Moves all tiles to a freshly allocated buffer. Without clearing, the pixels
+    // are undefined until every tile is reset, which lets each tile's pages be
+    // first touched by the thread that resets it.
+    void AllocateStorage(bool clear = true);
+
 private:
     void SetupTiles();
     int GetTileIndex(const Point2i& position) const;
+    size_t GetTileStorageSize(const Vector2i& size) const;
 
 private:
     Resolution m_Resolution;
     std::vector<FilmTile> m_Tiles;
+    std::shared_ptr<FilmBuffer> m_Buffer;
+    std::shared_ptr<SplatBuffer> m_Splats;
+    std::shared_ptr<const Filter> m_Filter;
+    std::shared_ptr<const FilterTable> m_FilterTable;
+    bool m_TrackStatistics;
 
     const int m_TileSize;
+    int m_NumTilesX;
+    int m_NumTilesY;
 };
 
@@ -0,0 +1,54 @@
+/*
+    This file is part of Spectre, an open-source physically based
+    spectral raytracing library.
+
+    Copyright (c) 2020-2023 Samuel Van Allen - All rights reserved.
+
+    Spectre is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "filmbuffer.h"
+
+FilmBuffer::FilmBuffer(size_t size)
+    : m_Size(size)
+{
+    const size_t slack = PageSize / sizeof(SpectralReal);
+    for (int i = 0; i < NumChannels; ++i)
+    {
+        // Default initialized, so the allocation is not touched here
+        m_Storage[i] = std::unique_ptr<SpectralReal[]>(new SpectralReal[size + slack]);
+
+        uintptr_t address = reinterpret_cast<uintptr_t>(m_Storage[i].get());
+        uintptr_t aligned = (address + PageSize - 1) & ~(uintptr_t)(PageSize - 1);
+        m_Channels[i] = reinterpret_cast<SpectralReal*>(aligned);
+    }
+}
+
+void FilmBuffer::Clear()
+{
+    for (int i = 0; i < NumChannels; ++i)
+        std::fill(m_Channels[i], m_Channels[i] + m_Size, SpectralReal(0));
+}
+
+size_t FilmBuffer::PadToCacheLine(size_t numPixels)
+{
+    const size_t pixelsPerLine = CacheLineSize / sizeof(SpectralReal);
+    return (numPixels + pixelsPerLine - 1) / pixelsPerLine * pixelsPerLine;
+}
+
+size_t FilmBuffer::PadToPage(size_t numPixels)
+{
+    const size_t pixelsPerPage = PageSize / sizeof(SpectralReal);
+    return (numPixels + pixelsPerPage - 1) / pixelsPerPage * pixelsPerPage;
+}
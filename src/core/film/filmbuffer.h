@@ -0,0 +1,68 @@
+/*
+    This file is part of Spectre, an open-source physically based
+    spectral raytracing library.
+
+    Copyright (c) 2020-2023 Samuel Van Allen - All rights reserved.
+
+    Spectre is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+// Pixel storage of a film with one contiguous allocation per channel, each
+// aligned to a cache line. Passes over the whole film stream one channel at a
+// time, which vectorizes and never shares cache lines between channels. The
+// accumulators are SpectralReal, so float spectrum builds halve the film memory.
+class FilmBuffer
+{
+public:
+    enum Channel
+    {
+        X,
+        Y,
+        Z,
+        TotalSplat,
+        NumChannels
+    };
+
+    static constexpr int CacheLineSize = 64;
+    static constexpr int PageSize = 4096;
+
+public:
+    // The buffer is left uninitialized, so that its pages are only placed once
+    // the pixels are first written
+    FilmBuffer(size_t size);
+    ~FilmBuffer() = default;
+
+public:
+    inline size_t GetSize() const { return m_Size; }
+    inline SpectralReal* GetChannel(Channel channel) { return m_Channels[channel]; }
+    inline const SpectralReal* GetChannel(Channel channel) const { return m_Channels[channel]; }
+
+public:
+    void Clear();
+
+    // Rounds a pixel count up to whole cache lines, so that consecutive ranges
+    // of a channel, such as the pixels of one tile, each start on a cache line
+    static size_t PadToCacheLine(size_t numPixels);
+
+    // Same for whole pages, so that ranges placed on different NUMA nodes never
+    // share a page. Channels start on a page.
+    static size_t PadToPage(size_t numPixels);
+
+private:
+    size_t m_Size;
+    std::unique_ptr<SpectralReal[]> m_Storage[NumChannels];
+    SpectralReal* m_Channels[NumChannels];
+};
@@ -18,8 +18,25 @@
 
 #include "filmtile.h"
 
-FilmTile::FilmTile(const Point2i& pos, const Vector2i& size)
+namespace
+{
+    // The accumulated splat area is stored in spectral precision, so a float
+    // build needs a correspondingly wider margin before rejecting a splat
+    const double SplatAreaTolerance = std::is_same_v<SpectralReal, float> ? 1e-5 : Math::Epsilon;
+}
+
+FilmTile::FilmTile(const Point2i& pos, const Vector2i& size, std::shared_ptr<const FilterTable> filterTable)
+    : FilmTile(pos, size, std::move(filterTable), nullptr, 0)
+{
+}
+
+FilmTile::FilmTile(const Point2i& pos, const Vector2i& size, std::shared_ptr<const FilterTable> filterTable, std::shared_ptr<FilmBuffer> buffer, size_t offset)
     : m_Rect(pos.x, pos.y, size.x, size.y)
+    , m_FilterTable(std::move(filterTable))
+    , m_Apron(m_FilterTable ? m_FilterTable->GetApron() : 0)
+    , m_Stride(size.x + 2 * m_Apron)
+    , m_Channels{}
+    , m_NumaNode(0)
 {
     if (size.x <= 0 || size.y <= 0)
         throw std::invalid_argument("Film tile cannot have zero size");
@@ -27,7 +44,40 @@ FilmTile::FilmTile(const Point2i& pos, const Vector2i& size)
     if (pos.x < 0 || pos.y < 0)
         throw std::invalid_argument("Film tile cannot have negative position");
 
-    m_Pixels.resize(size.x * size.y);
+    if (buffer == nullptr)
+    {
+        BindStorage(std::make_shared<FilmBuffer>(GetStorageSize(size, m_Apron)), 0);
+        ResetPixels();
+    }
+    else
+    {
+        BindStorage(std::move(buffer), offset);
+    }
+}
+
+void FilmTile::BindStorage(std::shared_ptr<FilmBuffer> buffer, size_t offset)
+{
+    if (offset + GetStorageSize(GetSize(), m_Apron) > buffer->GetSize())
+        throw std::invalid_argument("Film buffer is too small for this film tile");
+
+    m_Buffer = std::move(buffer);
+    for (int i = 0; i < FilmBuffer::NumChannels; ++i)
+        m_Channels[i] = m_Buffer->GetChannel((FilmBuffer::Channel)i) + offset;
+}
+
+size_t FilmTile::GetStorageSize(const Vector2i& size, int apron)
+{
+    return (size_t)(size.x + 2 * apron) * (size.y + 2 * apron);
+}
+
+void FilmTile::ResetPixels()
+{
+    size_t size = GetStorageSize(GetSize(), m_Apron);
+    for (int i = 0; i < FilmBuffer::NumChannels; ++i)
+        std::fill(m_Channels[i], m_Channels[i] + size, SpectralReal(0));
+
+    if (m_Statistics != nullptr)
+        m_Statistics->Clear();
 }
 
 Point2i FilmTile::TileToFilmSpace(const Point2i& tileSpacePos) const
@@ -47,15 +97,17 @@ int FilmTile::GetIndex(const Point2i& tileSpacePos) const
     if (!m_Rect.IsWithinBounds(filmSpacePos.x, filmSpacePos.y))
         throw std::invalid_argument("Point is outside of this film tile");
 
-    return tileSpacePos.x + tileSpacePos.y * m_Rect.w;
+    return GetPaddedIndex(tileSpacePos.x, tileSpacePos.y);
 }
 
-const Pixel& FilmTile::GetTileSpacePixel(const Point2i& tileSpacePos) const
+Pixel FilmTile::GetTileSpacePixel(const Point2i& tileSpacePos) const
 {
-    return m_Pixels[GetIndex(tileSpacePos)];
+    int index = GetIndex(tileSpacePos);
+    XyzCoefficients xyz(m_Channels[FilmBuffer::X][index], m_Channels[FilmBuffer::Y][index], m_Channels[FilmBuffer::Z][index]);
+    return Pixel(xyz, m_Channels[FilmBuffer::TotalSplat][index]);
 }
 
-const Pixel& FilmTile::GetFilmSpacePixel(const Point2i& filmSpacePos) const
+Pixel FilmTile::GetFilmSpacePixel(const Point2i& filmSpacePos) const
 {
     return GetTileSpacePixel(FilmToTileSpace(filmSpacePos));
 }
@@ -70,10 +122,136 @@ void FilmTile::SplatPixel(const Point2i& tileSpacePoint, const XyzCoefficients&
     if (deltaArea > 1.0 || deltaArea <= 0.0)
         throw std::invalid_argument("A greater than 1 or smaller than 0 deltaArea is invalid");
 
-    if (deltaArea + m_Pixels[GetIndex(tileSpacePoint)].m_TotalSplat > 1.0 + Math::Epsilon)
+    int index = GetIndex(tileSpacePoint);
+    if (deltaArea + m_Channels[FilmBuffer::TotalSplat][index] > 1.0 + SplatAreaTolerance)
         throw std::invalid_argument("Total splat area for this pixel exceeds 1 given the current delta area");
 
-    m_Pixels[GetIndex(tileSpacePoint)].m_Xyz += xyz * deltaArea;
-    m_Pixels[GetIndex(tileSpacePoint)].m_TotalSplat += deltaArea;
+    AddSample(tileSpacePoint, xyz, deltaArea);
+}
+
+void FilmTile::SplatPixel(const Point2i& tileSpacePoint, const SpectralPacket& radiance, const SampledWavelengths& wavelengths, double deltaArea)
+{
+    SplatPixel(tileSpacePoint, radiance.ToXyz(wavelengths), deltaArea);
+}
+
+PixelRow FilmTile::GetRow(int tileSpaceY)
+{
+    if (tileSpaceY < 0 || tileSpaceY >= m_Rect.h)
+        throw std::invalid_argument("Row is outside of this film tile");
+
+    int index = GetPaddedIndex(0, tileSpaceY);
+    return { { m_Channels[FilmBuffer::X] + index, (size_t)m_Rect.w },
+             { m_Channels[FilmBuffer::Y] + index, (size_t)m_Rect.w },
+             { m_Channels[FilmBuffer::Z] + index, (size_t)m_Rect.w },
+             { m_Channels[FilmBuffer::TotalSplat] + index, (size_t)m_Rect.w } };
+}
+
+ConstPixelRow FilmTile::GetRow(int tileSpaceY) const
+{
+    PixelRow row = const_cast<FilmTile*>(this)->GetRow(tileSpaceY);
+    return { row.m_X, row.m_Y, row.m_Z, row.m_TotalSplat };
+}
+
+void FilmTile::AddFilteredSample(const Point2& filmSpacePos, const XyzCoefficients& xyz)
+{
+    if (m_FilterTable == nullptr)
+        throw std::runtime_error("Film tile has no reconstruction filter");
+
+    // Sample position relative to the pixel centers in tile space
+    double px = filmSpacePos.x - m_Rect.x - 0.5;
+    double py = filmSpacePos.y - m_Rect.y - 0.5;
+    assert(px >= -0.5 && px < m_Rect.w - 0.5 && py >= -0.5 && py < m_Rect.h - 0.5);
+
+    if (m_Statistics != nullptr)
+        RecordSample({ std::min((int)(px + 0.5), m_Rect.w - 1), std::min((int)(py + 0.5), m_Rect.h - 1) }, xyz);
+
+    // Pixels whose center lies in (p - radius, p + radius], clamped to the apron. A
+    // sample on a pixel edge thereby only counts for the pixel it lies in.
+    const Vector2& radius = m_FilterTable->GetRadius();
+    int x0 = std::max((int)std::floor(px - radius.x) + 1, -m_Apron);
+    int x1 = std::min((int)std::floor(px + radius.x) + 1, m_Rect.w + m_Apron);
+    int y0 = std::max((int)std::floor(py - radius.y) + 1, -m_Apron);
+    int y1 = std::min((int)std::floor(py + radius.y) + 1, m_Rect.h + m_Apron);
+
+    for (int y = y0; y < y1; ++y)
+    {
+        int row = GetPaddedIndex(0, y);
+        SpectralReal* rowX = m_Channels[FilmBuffer::X] + row;
+        SpectralReal* rowY = m_Channels[FilmBuffer::Y] + row;
+        SpectralReal* rowZ = m_Channels[FilmBuffer::Z] + row;
+        SpectralReal* rowSplat = m_Channels[FilmBuffer::TotalSplat] + row;
+        for (int x = x0; x < x1; ++x)
+        {
+            double weight = m_FilterTable->Evaluate(x - px, y - py);
+            rowX[x] += SpectralReal(xyz[0] * weight);
+            rowY[x] += SpectralReal(xyz[1] * weight);
+            rowZ[x] += SpectralReal(xyz[2] * weight);
+            rowSplat[x] += SpectralReal(weight);
+        }
+    }
 }
 
+void FilmTile::MergeApron(const FilmTile& neighbour)
+{
+    if (&neighbour == this || neighbour.m_Apron == 0)
+        return;
+
+    // Film space overlap of this tile with the padded rectangle of the neighbour
+    const Rect& rect = neighbour.m_Rect;
+    int x0 = std::max(m_Rect.x, rect.x - neighbour.m_Apron);
+    int x1 = std::min(m_Rect.x + m_Rect.w, rect.x + rect.w + neighbour.m_Apron);
+    int y0 = std::max(m_Rect.y, rect.y - neighbour.m_Apron);
+    int y1 = std::min(m_Rect.y + m_Rect.h, rect.y + rect.h + neighbour.m_Apron);
+
+    for (int y = y0; y < y1; ++y)
+    {
+        for (int x = x0; x < x1; ++x)
+        {
+            if (rect.IsWithinBounds(x, y))
+                continue;
+
+            int source = neighbour.GetPaddedIndex(x - rect.x, y - rect.y);
+            int target = GetPaddedIndex(x - m_Rect.x, y - m_Rect.y);
+            for (int i = 0; i < FilmBuffer::NumChannels; ++i)
+                m_Channels[i][target] += neighbour.m_Channels[i][source];
+        }
+    }
+}
+
+void FilmTile::ClearApron()
+{
+    for (int y = -m_Apron; y < m_Rect.h + m_Apron; ++y)
+    {
+        bool isApronRow = y < 0 || y >= m_Rect.h;
+        for (int x = -m_Apron; x < m_Rect.w + m_Apron; ++x)
+        {
+            if (!isApronRow && x >= 0 && x < m_Rect.w)
+                continue;
+
+            for (int i = 0; i < FilmBuffer::NumChannels; ++i)
+                m_Channels[i][GetPaddedIndex(x, y)] = 0;
+        }
+    }
+}
+
+void FilmTile::EnableStatistics()
+{
+    if (m_Statistics == nullptr)
+        m_Statistics = std::make_shared<PixelStatistics>(GetSize());
+}
+
+const PixelStatistics& FilmTile::GetStatistics() const
+{
+    if (m_Statistics == nullptr)
+        throw std::runtime_error("Film tile does not track statistics");
+
+    return *m_Statistics;
+}
+
+double FilmTile::GetError() const
+{
+    if (m_Statistics == nullptr)
+        return std::numeric_limits<double>::infinity();
+
+    return m_Statistics->GetMaxRelativeError();
+}
@@ -19,32 +19,129 @@
 #pragma once
 
 #include "pixel.h"
+#include "filmbuffer.h"
+#include "pixelstatistics.h"
+#include "filter/filtertable.h"
+#include "core/spectrum/spectralpacket.h"
 
+// Views of one row of tile pixels, one per channel
+template <typename T>
+struct BasicPixelRow
+{
+    std::span<T> m_X;
+    std::span<T> m_Y;
+    std::span<T> m_Z;
+    std::span<T> m_TotalSplat;
+};
+
+typedef BasicPixelRow<SpectralReal> PixelRow;
+typedef BasicPixelRow<const SpectralReal> ConstPixelRow;
+
+// Rectangle of film pixels rendered as one unit of work. With a reconstruction
+// filter wider than a pixel, the tile stores an apron of pixels around its
+// rectangle that receives the contributions of its samples to neighbouring
+// tiles, so that a tile never writes to another tile while rendering. The
+// aprons are merged into the neighbours once all tiles are done.
+//
+// The pixels are a view into a FilmBuffer, usually shared by all tiles of a
+// film. A tile created on its own allocates a buffer for just its pixels.
 class FilmTile
 {
 public:
-    FilmTile(const Point2i& pos, const Vector2i& size);
+    FilmTile(const Point2i& pos, const Vector2i& size, std::shared_ptr<const FilterTable> filterTable = nullptr);
+    FilmTile(const Point2i& pos, const Vector2i& size, std::shared_ptr<const FilterTable> filterTable, std::shared_ptr<FilmBuffer> buffer, size_t offset);
     ~FilmTile() = default;
 
 public:
     inline Point2i GetPosition() const { return { m_Rect.x, m_Rect.y }; }
     inline Vector2i GetSize() const { return { m_Rect.w, m_Rect.h }; }
+    inline int GetNumaNode() const { return m_NumaNode; }
+    inline void SetNumaNode(int numaNode) { m_NumaNode = numaNode; }
+    inline int GetApron() const { return m_Apron; }
+    inline const FilterTable* GetFilterTable() const { return m_FilterTable.get(); }
 
 public:
     Point2i TileToFilmSpace(const Point2i& tileSpacePos) const;
     Point2i FilmToTileSpace(const Point2i& filmSpacePos) const;
 
-    const Pixel& GetTileSpacePixel(const Point2i& tileSpacePos) const;
-    const Pixel& GetFilmSpacePixel(const Point2i& filmSpacePos) const;
+    Pixel GetTileSpacePixel(const Point2i& tileSpacePos) const;
+    Pixel GetFilmSpacePixel(const Point2i& filmSpacePos) const;
 
     void SetPixel(const Point2i& tileSpacePoint, const XyzCoefficients& xyz);
     void SplatPixel(const Point2i& tileSpacePoint, const XyzCoefficients& xyz, double deltaArea);
+    void SplatPixel(const Point2i& tileSpacePoint, const SpectralPacket& radiance, const SampledWavelengths& wavelengths, double deltaArea);
+
+    // Unchecked accumulation for the render loop. The position must lie within the
+    // tile and the caller is responsible for the splat area, only asserted in debug.
+    inline void AddSample(const Point2i& tileSpacePoint, const XyzCoefficients& xyz, double weight)
+    {
+        assert(tileSpacePoint.x >= 0 && tileSpacePoint.x < m_Rect.w && tileSpacePoint.y >= 0 && tileSpacePoint.y < m_Rect.h);
+        int index = GetPaddedIndex(tileSpacePoint.x, tileSpacePoint.y);
+        m_Channels[FilmBuffer::X][index] += SpectralReal(xyz[0] * weight);
+        m_Channels[FilmBuffer::Y][index] += SpectralReal(xyz[1] * weight);
+        m_Channels[FilmBuffer::Z][index] += SpectralReal(xyz[2] * weight);
+        m_Channels[FilmBuffer::TotalSplat][index] += SpectralReal(weight);
+    }
+
+    // Raw view of one row of pixels, the row is validated once so the pixels can be accessed without further checks
+    PixelRow GetRow(int tileSpaceY);
+    ConstPixelRow GetRow(int tileSpaceY) const;
+
+    // Accumulates a sample at a continuous film space position into every pixel
+    // within the filter radius, weighted by the filter table. The position must
+    // lie within the tile. Contributions beyond the tile end up in its apron.
+    void AddFilteredSample(const Point2& filmSpacePos, const XyzCoefficients& xyz);
+
+    // Adds the apron pixels of neighbour that overlap this tile to this tile.
+    // Only reads the neighbour, so all tiles can gather concurrently.
+    void MergeApron(const FilmTile& neighbour);
+    void ClearApron();
+
+    // Tracks the running luminance moments of every pixel, for convergence estimates
+    void EnableStatistics();
+    inline bool HasStatistics() const { return m_Statistics != nullptr; }
+    const PixelStatistics& GetStatistics() const;
+
+    // Records the estimate of one pixel sample, independent of any filter
+    // weights. Filtered samples are recorded automatically.
+    inline void RecordSample(const Point2i& tileSpacePos, const XyzCoefficients& xyz)
+    {
+        if (m_Statistics != nullptr)
+            m_Statistics->AddSample(tileSpacePos, xyz[1]);
+    }
+
+    // Largest relative error of the pixels of the tile, infinite without statistics
+    double GetError() const;
+
+    // Clears all pixels of the tile, including its apron. The OS places pages on
+    // the node of the thread that first writes them, so calling this from a
+    // worker on the tile's NUMA node right after the film storage is allocated
+    // places its pixels in that node's memory. The placement is best effort: it
+    // only holds for pages no tile of another node shares, and only if no worker
+    // of another node ran the reset.
+    void ResetPixels();
+
+    // Number of buffer entries a tile of size needs with the given apron
+    static size_t GetStorageSize(const Vector2i& size, int apron);
+
+private:
+    friend class Film;
+    void BindStorage(std::shared_ptr<FilmBuffer> buffer, size_t offset);
 
 private:
     friend class FilmTileTest_CanGetIndex_Test;
     int GetIndex(const Point2i& tileSpacePos) const;
 
+    // Index into the padded pixel storage, tile space positions in the apron are negative or beyond the size
+    inline int GetPaddedIndex(int tileSpaceX, int tileSpaceY) const { return (tileSpaceX + m_Apron) + (tileSpaceY + m_Apron) * m_Stride; }
+
 private:
     const Rect m_Rect;
-    std::vector<Pixel> m_Pixels;
+    std::shared_ptr<const FilterTable> m_FilterTable;
+    int m_Apron;
+    int m_Stride;
+    std::shared_ptr<FilmBuffer> m_Buffer;
+    SpectralReal* m_Channels[FilmBuffer::NumChannels];
+    std::shared_ptr<PixelStatistics> m_Statistics;
+    int m_NumaNode;
 };
\ No newline at end of file
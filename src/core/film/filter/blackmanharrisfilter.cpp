@@ -0,0 +1,41 @@
+/*
+    This file is part of Spectre, an open-source physically based
+    spectral raytracing library.
+
+    Copyright (c) 2020-2023 Samuel Van Allen - All rights reserved.
+
+    Spectre is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "blackmanharrisfilter.h"
+
+BlackmanHarrisFilter::BlackmanHarrisFilter(const Vector2& radius)
+    : Filter(radius)
+{
+}
+
+double BlackmanHarrisFilter::Evaluate(const Vector2& offset) const
+{
+    return BlackmanHarris(offset.x, m_Radius.x) * BlackmanHarris(offset.y, m_Radius.y);
+}
+
+double BlackmanHarrisFilter::BlackmanHarris(double x, double radius)
+{
+    if (std::abs(x) >= radius)
+        return 0.0;
+
+    // Window position in [0, 1], peaking at the filter center
+    double t = (std::abs(x) + radius) / (2.0 * radius);
+    return 0.35875 - 0.48829 * std::cos(2.0 * Math::Pi * t) + 0.14128 * std::cos(4.0 * Math::Pi * t) - 0.01168 * std::cos(6.0 * Math::Pi * t);
+}
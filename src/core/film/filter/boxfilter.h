@@ -0,0 +1,34 @@
+/*
+    This file is part of Spectre, an open-source physically based
+    spectral raytracing library.
+
+    Copyright (c) 2020-2023 Samuel Van Allen - All rights reserved.
+
+    Spectre is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "filter.h"
+
+// Weighs every sample within the radius equally. With the default radius of
+// half a pixel, every sample only contributes to the pixel it lies in.
+class BoxFilter : public Filter
+{
+public:
+    BoxFilter(const Vector2& radius = { 0.5, 0.5 });
+
+public:
+    double Evaluate(const Vector2& offset) const override;
+};
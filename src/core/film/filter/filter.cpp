@@ -0,0 +1,70 @@
+/*
+    This file is part of Spectre, an open-source physically based
+    spectral raytracing library.
+
+    Copyright (c) 2020-2023 Samuel Van Allen - All rights reserved.
+
+    Spectre is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "filter.h"
+#include "boxfilter.h"
+#include "gaussianfilter.h"
+#include "mitchellfilter.h"
+#include "blackmanharrisfilter.h"
+#include "lanczosfilter.h"
+
+Filter::Filter(const Vector2& radius)
+    : m_Radius(radius)
+{
+    if (radius.x <= 0.0 || radius.y <= 0.0)
+        throw std::invalid_argument("Filter radius must be positive");
+}
+
+std::unique_ptr<Filter> CreateFilter(FilterType type)
+{
+    switch (type)
+    {
+    case FilterType::Box:
+        return CreateFilter(type, { 0.5, 0.5 });
+    case FilterType::Gaussian:
+        return CreateFilter(type, { 1.5, 1.5 });
+    case FilterType::Mitchell:
+    case FilterType::BlackmanHarris:
+        return CreateFilter(type, { 2.0, 2.0 });
+    case FilterType::Lanczos:
+        return CreateFilter(type, { 3.0, 3.0 });
+    default:
+        throw std::invalid_argument("Unknown filter type");
+    }
+}
+
+std::unique_ptr<Filter> CreateFilter(FilterType type, const Vector2& radius)
+{
+    switch (type)
+    {
+    case FilterType::Box:
+        return std::make_unique<BoxFilter>(radius);
+    case FilterType::Gaussian:
+        return std::make_unique<GaussianFilter>(radius);
+    case FilterType::Mitchell:
+        return std::make_unique<MitchellFilter>(radius);
+    case FilterType::BlackmanHarris:
+        return std::make_unique<BlackmanHarrisFilter>(radius);
+    case FilterType::Lanczos:
+        return std::make_unique<LanczosFilter>(radius);
+    default:
+        throw std::invalid_argument("Unknown filter type");
+    }
+}
@@ -0,0 +1,51 @@
+/*
+    This file is part of Spectre, an open-source physically based
+    spectral raytracing library.
+
+    Copyright (c) 2020-2023 Samuel Van Allen - All rights reserved.
+
+    Spectre is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+enum class FilterType
+{
+    Box,
+    Gaussian,
+    Mitchell,
+    BlackmanHarris,
+    Lanczos
+};
+
+// Pixel reconstruction filter, weighting a sample by its offset from a pixel
+// center. Every filter is symmetric and zero beyond its radius on either axis.
+class Filter
+{
+public:
+    Filter(const Vector2& radius);
+    virtual ~Filter() = default;
+
+public:
+    inline const Vector2& GetRadius() const { return m_Radius; }
+
+public:
+    virtual double Evaluate(const Vector2& offset) const = 0;
+
+protected:
+    Vector2 m_Radius;
+};
+
+std::unique_ptr<Filter> CreateFilter(FilterType type);
+std::unique_ptr<Filter> CreateFilter(FilterType type, const Vector2& radius);
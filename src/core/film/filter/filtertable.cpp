@@ -0,0 +1,41 @@
+/*
+    This file is part of Spectre, an open-source physically based
+    spectral raytracing library.
+
+    Copyright (c) 2020-2023 Samuel Van Allen - All rights reserved.
+
+    Spectre is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "filtertable.h"
+
+FilterTable::FilterTable(const Filter& filter, int size)
+    : m_Radius(filter.GetRadius())
+    , m_InvCellSize(size / m_Radius.x, size / m_Radius.y)
+    , m_Size(size)
+{
+    if (size <= 0)
+        throw std::invalid_argument("Filter table needs at least one entry");
+
+    // Every entry holds the filter value at the center of its cell
+    m_Values.resize(size * size);
+    for (int y = 0; y < size; ++y)
+    {
+        for (int x = 0; x < size; ++x)
+        {
+            Vector2 offset((x + 0.5) / m_InvCellSize.x, (y + 0.5) / m_InvCellSize.y);
+            m_Values[y * size + x] = filter.Evaluate(offset);
+        }
+    }
+}
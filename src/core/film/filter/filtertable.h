@@ -0,0 +1,58 @@
+/*
+    This file is part of Spectre, an open-source physically based
+    spectral raytracing library.
+
+    Copyright (c) 2020-2023 Samuel Van Allen - All rights reserved.
+
+    Spectre is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "filter.h"
+
+// Filter values precomputed over one quadrant of the filter extent, so that
+// weighting a sample costs a table lookup regardless of the filter. Filters
+// are symmetric, the lookup folds every offset into the stored quadrant.
+class FilterTable
+{
+public:
+    static constexpr int DefaultSize = 16;
+
+public:
+    FilterTable(const Filter& filter, int size = DefaultSize);
+
+public:
+    inline const Vector2& GetRadius() const { return m_Radius; }
+    inline int GetSize() const { return m_Size; }
+
+    // Smallest apron in pixels around a tile such that every pixel a sample
+    // inside the tile contributes to is stored
+    inline int GetApron() const { return (int)std::ceil(std::max(m_Radius.x, m_Radius.y) - 0.5); }
+
+public:
+    // The offset is expected to be within the radius, larger offsets are clamped to the edge
+    inline double Evaluate(double offsetX, double offsetY) const
+    {
+        int x = std::min((int)(std::abs(offsetX) * m_InvCellSize.x), m_Size - 1);
+        int y = std::min((int)(std::abs(offsetY) * m_InvCellSize.y), m_Size - 1);
+        return m_Values[y * m_Size + x];
+    }
+
+private:
+    Vector2 m_Radius;
+    Vector2 m_InvCellSize;
+    int m_Size;
+    std::vector<double> m_Values;
+};
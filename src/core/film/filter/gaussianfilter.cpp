@@ -0,0 +1,42 @@
+/*
+    This file is part of Spectre, an open-source physically based
+    spectral raytracing library.
+
+    Copyright (c) 2020-2023 Samuel Van Allen - All rights reserved.
+
+    Spectre is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "gaussianfilter.h"
+
+GaussianFilter::GaussianFilter(const Vector2& radius, double sigma)
+    : Filter(radius)
+    , m_Sigma(sigma)
+{
+    if (sigma <= 0.0)
+        throw std::invalid_argument("Gaussian filter sigma must be positive");
+
+    m_EdgeX = Gaussian(radius.x, 0.0);
+    m_EdgeY = Gaussian(radius.y, 0.0);
+}
+
+double GaussianFilter::Evaluate(const Vector2& offset) const
+{
+    return Gaussian(offset.x, m_EdgeX) * Gaussian(offset.y, m_EdgeY);
+}
+
+double GaussianFilter::Gaussian(double x, double edge) const
+{
+    return std::max(0.0, std::exp(-x * x / (2.0 * m_Sigma * m_Sigma)) - edge);
+}
@@ -0,0 +1,45 @@
+/*
+    This file is part of Spectre, an open-source physically based
+    spectral raytracing library.
+
+    Copyright (c) 2020-2023 Samuel Van Allen - All rights reserved.
+
+    Spectre is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "filter.h"
+
+// Gaussian shifted down by its value at the radius, so it falls off to zero
+// at the edge instead of being cut off
+class GaussianFilter : public Filter
+{
+public:
+    GaussianFilter(const Vector2& radius = { 1.5, 1.5 }, double sigma = 0.5);
+
+public:
+    inline double GetSigma() const { return m_Sigma; }
+
+public:
+    double Evaluate(const Vector2& offset) const override;
+
+private:
+    double Gaussian(double x, double edge) const;
+
+private:
+    double m_Sigma;
+    double m_EdgeX;
+    double m_EdgeY;
+};
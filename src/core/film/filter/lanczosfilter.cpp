@@ -0,0 +1,53 @@
+/*
+    This file is part of Spectre, an open-source physically based
+    spectral raytracing library.
+
+    Copyright (c) 2020-2023 Samuel Van Allen - All rights reserved.
+
+    Spectre is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "lanczosfilter.h"
+
+namespace
+{
+    double Sinc(double x)
+    {
+        if (std::abs(x) < 1e-5)
+            return 1.0;
+
+        return std::sin(Math::Pi * x) / (Math::Pi * x);
+    }
+}
+
+LanczosFilter::LanczosFilter(const Vector2& radius, double tau)
+    : Filter(radius)
+    , m_Tau(tau)
+{
+    if (tau <= 0.0)
+        throw std::invalid_argument("Lanczos filter tau must be positive");
+}
+
+double LanczosFilter::Evaluate(const Vector2& offset) const
+{
+    return WindowedSinc(offset.x, m_Radius.x) * WindowedSinc(offset.y, m_Radius.y);
+}
+
+double LanczosFilter::WindowedSinc(double x, double radius) const
+{
+    if (std::abs(x) >= radius)
+        return 0.0;
+
+    return Sinc(x) * Sinc(x / m_Tau);
+}
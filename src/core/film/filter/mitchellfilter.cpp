@@ -0,0 +1,45 @@
+/*
+    This file is part of Spectre, an open-source physically based
+    spectral raytracing library.
+
+    Copyright (c) 2020-2023 Samuel Van Allen - All rights reserved.
+
+    Spectre is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "mitchellfilter.h"
+
+MitchellFilter::MitchellFilter(const Vector2& radius, double b, double c)
+    : Filter(radius)
+    , m_B(b)
+    , m_C(c)
+{
+}
+
+double MitchellFilter::Evaluate(const Vector2& offset) const
+{
+    return Mitchell(2.0 * offset.x / m_Radius.x) * Mitchell(2.0 * offset.y / m_Radius.y);
+}
+
+double MitchellFilter::Mitchell(double x) const
+{
+    x = std::abs(x);
+    if (x >= 2.0)
+        return 0.0;
+
+    if (x > 1.0)
+        return ((-m_B - 6.0 * m_C) * x * x * x + (6.0 * m_B + 30.0 * m_C) * x * x + (-12.0 * m_B - 48.0 * m_C) * x + (8.0 * m_B + 24.0 * m_C)) / 6.0;
+
+    return ((12.0 - 9.0 * m_B - 6.0 * m_C) * x * x * x + (-18.0 + 12.0 * m_B + 6.0 * m_C) * x * x + (6.0 - 2.0 * m_B)) / 6.0;
+}
@@ -0,0 +1,42 @@
+/*
+    This file is part of Spectre, an open-source physically based
+    spectral raytracing library.
+
+    Copyright (c) 2020-2023 Samuel Van Allen - All rights reserved.
+
+    Spectre is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "filter.h"
+
+// Mitchell-Netravali cubic, trading blurring (B) against ringing (C). The
+// default B = C = 1/3 is the compromise recommended by the authors.
+class MitchellFilter : public Filter
+{
+public:
+    MitchellFilter(const Vector2& radius = { 2.0, 2.0 }, double b = 1.0 / 3.0, double c = 1.0 / 3.0);
+
+public:
+    double Evaluate(const Vector2& offset) const override;
+
+private:
+    // Evaluates the cubic at x in [-2, 2]
+    double Mitchell(double x) const;
+
+private:
+    double m_B;
+    double m_C;
+};
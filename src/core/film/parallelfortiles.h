@@ -0,0 +1,85 @@
+/*
+    This file is part of Spectre, an open-source physically based
+    spectral raytracing library.
+
+    Copyright (c) 2020-2023 Samuel Van Allen - All rights reserved.
+
+    Spectre is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "film.h"
+#include "adaptivetilescheduler.h"
+#include "system/threading/parallelfor.h"
+
+// Runs body(tile) for every tile of film on pool and the calling thread, and
+// blocks until the whole frame is done. Tiles are handed out one at a time, as
+// each is a large and uneven unit of work. On pools spanning several NUMA nodes,
+// every tile preferably runs on the node set on it.
+template <typename Body>
+void ParallelForTiles(ThreadPool& pool, Film& film, Body&& body)
+{
+    auto tileBody = [&film, &body](int64_t index)
+    {
+        body(film.GetTile((int)index));
+    };
+
+    if (pool.GetNumNumaNodes() > 1)
+        ParallelForNuma(pool, 0, film.GetNumTiles(), [&film](int64_t index) { return film.GetTile((int)index).GetNumaNode(); }, tileBody);
+    else
+        ParallelForChunks(pool, 0, film.GetNumTiles(), 1, tileBody);
+}
+
+// Splits the tiles of film into one contiguous block per NUMA node of pool, and
+// moves the film to fresh storage in which every node's block starts on its own
+// page. The tiles are then reset by the workers of their node, so that their
+// pages are first touched and allocated there. This is best effort, a node
+// whose workers fall behind may have some of its tiles stolen and reset by
+// another node. Clears the film.
+inline void DistributeTilesOverNumaNodes(ThreadPool& pool, Film& film)
+{
+    int numTiles = film.GetNumTiles();
+    int numNodes = pool.GetNumNumaNodes();
+    for (int i = 0; i < numTiles; ++i)
+        film.GetTile(i).SetNumaNode((int)((int64_t)i * numNodes / numTiles));
+
+    film.AllocateStorage(false);
+    ParallelForTiles(pool, film, [](FilmTile& tile) { tile.ResetPixels(); });
+}
+
+// Merges the aprons of all tiles of film into their neighbours on pool, to be
+// called once every tile is rendered. All tiles gather before any apron is cleared.
+inline void MergeTileAprons(ThreadPool& pool, Film& film)
+{
+    if (film.GetTile(0).GetApron() == 0)
+        return;
+
+    ParallelForChunks(pool, 0, film.GetNumTiles(), 1, [&film](int64_t index) { film.GatherAprons((int)index); });
+    ParallelForTiles(pool, film, [](FilmTile& tile) { tile.ClearApron(); });
+}
+
+// Renders film adaptively, running body(tile, firstSample, numSamples) for the
+// work of every pass of scheduler until all tiles are converged or exhausted
+template <typename Body>
+void ParallelForAdaptiveTiles(ThreadPool& pool, Film& film, AdaptiveTileScheduler& scheduler, Body&& body)
+{
+    for (std::vector<TileWork> pass = scheduler.NextPass(); !pass.empty(); pass = scheduler.NextPass())
+    {
+        ParallelForChunks(pool, 0, (int64_t)pass.size(), 1, [&film, &pass, &body](int64_t i)
+        {
+            body(film.GetTile(pass[i].m_TileIndex), pass[i].m_FirstSample, pass[i].m_NumSamples);
+        });
+    }
+}
@@ -29,8 +29,13 @@ public:
         m_Xyz = xyz;
         m_TotalSplat = 0.0;
     }
+    Pixel(const XyzCoefficients& xyz, SpectralReal totalSplat)
+    {
+        m_Xyz = xyz;
+        m_TotalSplat = totalSplat;
+    }
 
     XyzCoefficients m_Xyz;
-    double m_TotalSplat;
+    SpectralReal m_TotalSplat;
 };
 
@@ -0,0 +1,86 @@
+/*
+    This file is part of Spectre, an open-source physically based
+    spectral raytracing library.
+
+    Copyright (c) 2020-2023 Samuel Van Allen - All rights reserved.
+
+    Spectre is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "pixelstatistics.h"
+
+PixelStatistics::PixelStatistics(const Vector2i& size)
+    : m_Size(size)
+{
+    if (size.x <= 0 || size.y <= 0)
+        throw std::invalid_argument("Pixel statistics cannot have zero size");
+
+    m_Count.resize(size.x * size.y);
+    m_Mean.resize(size.x * size.y);
+    m_M2.resize(size.x * size.y);
+}
+
+int PixelStatistics::GetIndex(const Point2i& tileSpacePos) const
+{
+    if (tileSpacePos.x < 0 || tileSpacePos.x >= m_Size.x || tileSpacePos.y < 0 || tileSpacePos.y >= m_Size.y)
+        throw std::invalid_argument("Point is outside of the pixel statistics");
+
+    return tileSpacePos.x + tileSpacePos.y * m_Size.x;
+}
+
+uint32_t PixelStatistics::GetNumSamples(const Point2i& tileSpacePos) const
+{
+    return m_Count[GetIndex(tileSpacePos)];
+}
+
+double PixelStatistics::GetMean(const Point2i& tileSpacePos) const
+{
+    return m_Mean[GetIndex(tileSpacePos)];
+}
+
+double PixelStatistics::GetVariance(const Point2i& tileSpacePos) const
+{
+    int index = GetIndex(tileSpacePos);
+    return m_Count[index] < 2 ? 0.0 : m_M2[index] / (m_Count[index] - 1);
+}
+
+double PixelStatistics::GetRelativeError(const Point2i& tileSpacePos) const
+{
+    int index = GetIndex(tileSpacePos);
+    uint32_t count = m_Count[index];
+    if (count < 2)
+        return std::numeric_limits<double>::infinity();
+
+    double standardError = std::sqrt(m_M2[index] / (count - 1) / count);
+    return standardError / std::max(std::abs(m_Mean[index]), MinLuminance);
+}
+
+double PixelStatistics::GetMaxRelativeError() const
+{
+    double maxError = 0.0;
+    for (int y = 0; y < m_Size.y; ++y)
+    {
+        for (int x = 0; x < m_Size.x; ++x)
+            maxError = std::max(maxError, GetRelativeError({ x, y }));
+    }
+
+    return maxError;
+}
+
+void PixelStatistics::Clear()
+{
+    std::fill(m_Count.begin(), m_Count.end(), 0);
+    std::fill(m_Mean.begin(), m_Mean.end(), 0.0);
+    std::fill(m_M2.begin(), m_M2.end(), 0.0);
+}
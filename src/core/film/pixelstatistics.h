@@ -0,0 +1,74 @@
+/*
+    This file is part of Spectre, an open-source physically based
+    spectral raytracing library.
+
+    Copyright (c) 2020-2023 Samuel Van Allen - All rights reserved.
+
+    Spectre is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+// Running mean and variance of the sample luminance of every pixel of a tile,
+// updated with Welford's algorithm so a single pass stays numerically stable.
+// Used to estimate how converged a pixel is and where more samples pay off.
+class PixelStatistics
+{
+public:
+    // Floor on the mean when relating the error to it, so that black and very
+    // dark pixels do not count as endlessly unconverged
+    static constexpr double MinLuminance = 1e-3;
+
+public:
+    PixelStatistics(const Vector2i& size);
+    ~PixelStatistics() = default;
+
+public:
+    inline const Vector2i& GetSize() const { return m_Size; }
+
+    // Unchecked, the position must lie within the tile
+    inline void AddSample(const Point2i& tileSpacePos, double value)
+    {
+        assert(tileSpacePos.x >= 0 && tileSpacePos.x < m_Size.x && tileSpacePos.y >= 0 && tileSpacePos.y < m_Size.y);
+        int index = tileSpacePos.x + tileSpacePos.y * m_Size.x;
+        uint32_t count = ++m_Count[index];
+        double delta = value - m_Mean[index];
+        m_Mean[index] += delta / count;
+        m_M2[index] += delta * (value - m_Mean[index]);
+    }
+
+public:
+    uint32_t GetNumSamples(const Point2i& tileSpacePos) const;
+    double GetMean(const Point2i& tileSpacePos) const;
+
+    // Unbiased sample variance, zero below two samples
+    double GetVariance(const Point2i& tileSpacePos) const;
+
+    // Standard error of the mean relative to the mean, infinite below two samples
+    double GetRelativeError(const Point2i& tileSpacePos) const;
+
+    // Largest relative error of all pixels
+    double GetMaxRelativeError() const;
+
+    void Clear();
+
+private:
+    int GetIndex(const Point2i& tileSpacePos) const;
+
+private:
+    Vector2i m_Size;
+    std::vector<uint32_t> m_Count;
+    std::vector<double> m_Mean;
+    std::vector<double> m_M2;
+};
@@ -0,0 +1,132 @@
+/*
+    This file is part of Spectre, an open-source physically based
+    spectral raytracing library.
+
+    Copyright (c) 2020-2023 Samuel Van Allen - All rights reserved.
+
+    Spectre is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "splatbuffer.h"
+
+namespace
+{
+    std::atomic_uint64_t nextBufferId = 0;
+
+    // Per thread cache of the last layer used, so that only the first splat of
+    // a thread into a buffer takes the lock. Buffers are told apart by a unique
+    // id rather than their address, which a later buffer could reuse.
+    struct ThreadLayerCache
+    {
+        uint64_t m_BufferId = UINT64_MAX;
+        void* m_Layer = nullptr;
+    };
+
+    thread_local ThreadLayerCache threadLayerCache;
+}
+
+SplatBuffer::SplatBuffer(const Resolution& resolution, SplatMode mode)
+    : m_Resolution(resolution)
+    , m_Mode(mode)
+    , m_Id(nextBufferId.fetch_add(1, std::memory_order_relaxed))
+    , m_Scale(1.0)
+    , m_Shared(resolution.GetArea())
+{
+}
+
+void SplatBuffer::AddSplat(const Point2& filmSpacePos, const XyzCoefficients& xyz)
+{
+    Point2i pixel((int)std::floor(filmSpacePos.x), (int)std::floor(filmSpacePos.y));
+    if (!m_Resolution.IsWithinBounds(pixel))
+        return;
+
+    size_t index = pixel.x + (size_t)pixel.y * m_Resolution.GetWidth();
+    if (m_Mode == SplatMode::Atomic)
+    {
+        std::atomic_ref<SpectralReal>(m_Shared.m_X[index]).fetch_add(xyz[0], std::memory_order_relaxed);
+        std::atomic_ref<SpectralReal>(m_Shared.m_Y[index]).fetch_add(xyz[1], std::memory_order_relaxed);
+        std::atomic_ref<SpectralReal>(m_Shared.m_Z[index]).fetch_add(xyz[2], std::memory_order_relaxed);
+    }
+    else
+    {
+        // Only the first splat writes the flag, later ones just read the cache line
+        if (!m_HasUnreducedSplats.load(std::memory_order_relaxed))
+            m_HasUnreducedSplats.store(true, std::memory_order_relaxed);
+
+        Layer& layer = GetThreadLayer();
+        layer.m_X[index] += xyz[0];
+        layer.m_Y[index] += xyz[1];
+        layer.m_Z[index] += xyz[2];
+    }
+}
+
+SplatBuffer::Layer& SplatBuffer::GetThreadLayer()
+{
+    if (threadLayerCache.m_BufferId == m_Id)
+        return *static_cast<Layer*>(threadLayerCache.m_Layer);
+
+    std::lock_guard<std::mutex> lock(m_LayersMutex);
+    std::unique_ptr<Layer>& layer = m_ThreadLayers[std::this_thread::get_id()];
+    if (layer == nullptr)
+        layer = std::make_unique<Layer>(m_Resolution.GetArea());
+
+    threadLayerCache = { m_Id, layer.get() };
+    return *layer;
+}
+
+void SplatBuffer::Reduce()
+{
+    std::lock_guard<std::mutex> lock(m_LayersMutex);
+    for (auto& [id, layer] : m_ThreadLayers)
+    {
+        for (size_t i = 0; i < m_Shared.m_X.size(); ++i)
+        {
+            m_Shared.m_X[i] += layer->m_X[i];
+            m_Shared.m_Y[i] += layer->m_Y[i];
+            m_Shared.m_Z[i] += layer->m_Z[i];
+        }
+
+        layer->Clear();
+    }
+
+    m_HasUnreducedSplats = false;
+}
+
+void SplatBuffer::Clear()
+{
+    std::lock_guard<std::mutex> lock(m_LayersMutex);
+    m_Shared.Clear();
+    for (auto& [id, layer] : m_ThreadLayers)
+        layer->Clear();
+
+    m_HasUnreducedSplats = false;
+}
+
+XyzCoefficients SplatBuffer::GetPixel(const Point2i& filmSpacePos) const
+{
+    if (!m_Resolution.IsWithinBounds(filmSpacePos))
+        throw std::invalid_argument("Position is outside film bounds");
+
+    if (HasUnreducedSplats())
+        throw std::runtime_error("Splat buffer has to be reduced before its pixels are read");
+
+    size_t index = filmSpacePos.x + (size_t)filmSpacePos.y * m_Resolution.GetWidth();
+    return { m_Shared.m_X[index], m_Shared.m_Y[index], m_Shared.m_Z[index] };
+}
+
+int SplatBuffer::GetNumThreadLayers() const
+{
+    std::lock_guard<std::mutex> lock(m_LayersMutex);
+    return (int)m_ThreadLayers.size();
+}
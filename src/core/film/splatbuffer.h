@@ -0,0 +1,102 @@
+/*
+    This file is part of Spectre, an open-source physically based
+    spectral raytracing library.
+
+    Copyright (c) 2020-2023 Samuel Van Allen - All rights reserved.
+
+    Spectre is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <thread>
+#include <unordered_map>
+
+#include "resolution.h"
+
+enum class SplatMode
+{
+    Atomic,
+    PerThread
+};
+
+// Film layer for samples that land at arbitrary pixels from any thread, such
+// as light tracing and bidirectional splats, which cannot go through the tile
+// that owns the pixel. In atomic mode all threads add into one shared layer,
+// which costs no extra memory but contends when splats cluster. In per thread
+// mode every splatting thread gets a private full resolution layer, which are
+// summed by Reduce once splatting is done.
+class SplatBuffer
+{
+public:
+    SplatBuffer(const Resolution& resolution, SplatMode mode);
+    ~SplatBuffer() = default;
+
+public:
+    inline SplatMode GetMode() const { return m_Mode; }
+    inline const Resolution& GetResolution() const { return m_Resolution; }
+
+    // Factor applied to the splats when they are combined with the film, usually one over the sample count
+    inline double GetScale() const { return m_Scale; }
+    inline void SetScale(double scale) { m_Scale = scale; }
+
+public:
+    // Safe to call from any thread. Splats outside of the film are dropped, as
+    // light paths routinely connect to points outside of the frame.
+    void AddSplat(const Point2& filmSpacePos, const XyzCoefficients& xyz);
+
+    // Sums the per thread layers into the shared layer and clears them. Must
+    // not run concurrently with AddSplat. Does nothing in atomic mode.
+    void Reduce();
+    void Clear();
+
+    // Unscaled sum of the splats of a pixel. Throws while per thread layers
+    // hold splats that have not been reduced yet, which would otherwise be lost.
+    XyzCoefficients GetPixel(const Point2i& filmSpacePos) const;
+    inline bool HasUnreducedSplats() const { return m_HasUnreducedSplats.load(std::memory_order_relaxed); }
+    int GetNumThreadLayers() const;
+
+private:
+    struct Layer
+    {
+        Layer(size_t size) : m_X(size), m_Y(size), m_Z(size) {}
+
+        void Clear()
+        {
+            std::fill(m_X.begin(), m_X.end(), SpectralReal(0));
+            std::fill(m_Y.begin(), m_Y.end(), SpectralReal(0));
+            std::fill(m_Z.begin(), m_Z.end(), SpectralReal(0));
+        }
+
+        std::vector<SpectralReal> m_X;
+        std::vector<SpectralReal> m_Y;
+        std::vector<SpectralReal> m_Z;
+    };
+
+    // Layer of the calling thread, created on its first splat
+    Layer& GetThreadLayer();
+
+private:
+    const Resolution m_Resolution;
+    const SplatMode m_Mode;
+    const uint64_t m_Id;
+    double m_Scale;
+
+    Layer m_Shared;
+    std::atomic_bool m_HasUnreducedSplats = false;
+
+    mutable std::mutex m_LayersMutex;
+    std::unordered_map<std::thread::id, std::unique_ptr<Layer>> m_ThreadLayers;
+};
@@ -0,0 +1,185 @@
+/*
+    This file is part of Spectre, an open-source physically based
+    spectral raytracing library.
+
+    Copyright (c) 2020-2023 Samuel Van Allen - All rights reserved.
+
+    Spectre is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "batchsampling.h"
+
+namespace
+{
+    using Pack = Simd::Pack<double>;
+    using Scalar = Simd::Scalar<double>;
+
+    void CheckSizes(std::span<const double> u0, std::span<const double> u1, std::initializer_list<size_t> outputSizes)
+    {
+        bool matches = u0.size() == u1.size();
+        for (size_t size : outputSizes)
+            matches = matches && size == u0.size();
+
+        if (!matches)
+            throw std::invalid_argument("Batch sampling inputs and outputs must have the same size");
+    }
+
+    // Runs kernel over full packs, then lane by lane over the remainder. The
+    // spans come from callers, so loads and stores do not assume alignment.
+    template <typename Kernel>
+    void ApplyWarp2(std::span<const double> u0, std::span<const double> u1, std::span<double> a, std::span<double> b, Kernel kernel)
+    {
+        CheckSizes(u0, u1, { a.size(), b.size() });
+
+        size_t i = 0;
+        for (; i + Pack::Width <= u0.size(); i += Pack::Width)
+        {
+            Pack outA, outB;
+            kernel(Pack::LoadUnaligned(&u0[i]), Pack::LoadUnaligned(&u1[i]), outA, outB);
+            outA.StoreUnaligned(&a[i]);
+            outB.StoreUnaligned(&b[i]);
+        }
+
+        for (; i < u0.size(); ++i)
+        {
+            Scalar outA, outB;
+            kernel(Scalar::Load(&u0[i]), Scalar::Load(&u1[i]), outA, outB);
+            outA.Store(&a[i]);
+            outB.Store(&b[i]);
+        }
+    }
+
+    template <typename Kernel>
+    void ApplyWarp3(std::span<const double> u0, std::span<const double> u1, std::span<double> x, std::span<double> y, std::span<double> z, Kernel kernel)
+    {
+        CheckSizes(u0, u1, { x.size(), y.size(), z.size() });
+
+        size_t i = 0;
+        for (; i + Pack::Width <= u0.size(); i += Pack::Width)
+        {
+            Pack outX, outY, outZ;
+            kernel(Pack::LoadUnaligned(&u0[i]), Pack::LoadUnaligned(&u1[i]), outX, outY, outZ);
+            outX.StoreUnaligned(&x[i]);
+            outY.StoreUnaligned(&y[i]);
+            outZ.StoreUnaligned(&z[i]);
+        }
+
+        for (; i < u0.size(); ++i)
+        {
+            Scalar outX, outY, outZ;
+            kernel(Scalar::Load(&u0[i]), Scalar::Load(&u1[i]), outX, outY, outZ);
+            outX.Store(&x[i]);
+            outY.Store(&y[i]);
+            outZ.Store(&z[i]);
+        }
+    }
+
+    template <typename P>
+    inline void ConcentricDisk(const P& u0, const P& u1, P& x, P& y)
+    {
+        P offsetX = u0 * P(2.0) - P(1.0);
+        P offsetY = u1 * P(2.0) - P(1.0);
+        P absX = Simd::Max(offsetX, P(0.0) - offsetX);
+        P absY = Simd::Max(offsetY, P(0.0) - offsetY);
+
+        // Both branches of the scalar warp are computed and blended. Only the
+        // disk center divides by zero, so its denominator is replaced there.
+        P r = Simd::SelectLess(absY, absX, offsetX, offsetY);
+        P numerator = Simd::SelectLess(absY, absX, offsetY, offsetX);
+        P denominator = Simd::SelectLess(Simd::Max(absX, absY), P(std::numeric_limits<double>::min()), P(1.0), r);
+        P ratio = numerator / denominator;
+        P theta = Simd::SelectLess(absY, absX, P(Math::PiOver4) * ratio, P(Math::PiOver2) - P(Math::PiOver4) * ratio);
+
+        P sinTheta, cosTheta;
+        Simd::SinCos(theta, sinTheta, cosTheta);
+        x = r * cosTheta;
+        y = r * sinTheta;
+    }
+}
+
+void Sampling::UniformSampleHemisphere(std::span<const double> u0, std::span<const double> u1, std::span<double> x, std::span<double> y, std::span<double> z)
+{
+    ApplyWarp3(u0, u1, x, y, z, [](auto u0, auto u1, auto& x, auto& y, auto& z)
+    {
+        using P = decltype(u0);
+        P r = Simd::Sqrt(Simd::Max(P(0.0), P(1.0) - u0 * u0));
+
+        P sinPhi, cosPhi;
+        Simd::SinCos(P(2 * Math::Pi) * u1, sinPhi, cosPhi);
+        x = r * cosPhi;
+        y = u0;
+        z = r * sinPhi;
+    });
+}
+
+void Sampling::UniformSampleSphere(std::span<const double> u0, std::span<const double> u1, std::span<double> x, std::span<double> y, std::span<double> z)
+{
+    ApplyWarp3(u0, u1, x, y, z, [](auto u0, auto u1, auto& x, auto& y, auto& z)
+    {
+        using P = decltype(u0);
+        P cosTheta = P(1.0) - P(2.0) * u0;
+        P r = Simd::Sqrt(Simd::Max(P(0.0), P(1.0) - cosTheta * cosTheta));
+
+        P sinPhi, cosPhi;
+        Simd::SinCos(P(2 * Math::Pi) * u1, sinPhi, cosPhi);
+        x = r * cosPhi;
+        y = r * sinPhi;
+        z = cosTheta;
+    });
+}
+
+void Sampling::ConcentricSampleDisk(std::span<const double> u0, std::span<const double> u1, std::span<double> x, std::span<double> y)
+{
+    ApplyWarp2(u0, u1, x, y, [](auto u0, auto u1, auto& x, auto& y)
+    {
+        ConcentricDisk(u0, u1, x, y);
+    });
+}
+
+void Sampling::CosineSampleHemisphere(std::span<const double> u0, std::span<const double> u1, std::span<double> x, std::span<double> y, std::span<double> z)
+{
+    ApplyWarp3(u0, u1, x, y, z, [](auto u0, auto u1, auto& x, auto& y, auto& z)
+    {
+        using P = decltype(u0);
+        ConcentricDisk(u0, u1, x, y);
+        z = Simd::Sqrt(Simd::Max(P(0.0), P(1.0) - x * x - y * y));
+    });
+}
+
+void Sampling::UniformSampleCone(std::span<const double> u0, std::span<const double> u1, double cosThetaMax, std::span<double> x, std::span<double> y, std::span<double> z)
+{
+    ApplyWarp3(u0, u1, x, y, z, [cosThetaMax](auto u0, auto u1, auto& x, auto& y, auto& z)
+    {
+        using P = decltype(u0);
+        P cosTheta = (P(1.0) - u0) + u0 * P(cosThetaMax);
+        P sinTheta = Simd::Sqrt(Simd::Max(P(0.0), P(1.0) - cosTheta * cosTheta));
+
+        P sinPhi, cosPhi;
+        Simd::SinCos(P(2 * Math::Pi) * u1, sinPhi, cosPhi);
+        x = cosPhi * sinTheta;
+        y = sinPhi * sinTheta;
+        z = cosTheta;
+    });
+}
+
+void Sampling::UniformSampleTriangle(std::span<const double> u0, std::span<const double> u1, std::span<double> b0, std::span<double> b1)
+{
+    ApplyWarp2(u0, u1, b0, b1, [](auto u0, auto u1, auto& b0, auto& b1)
+    {
+        using P = decltype(u0);
+        P su0 = Simd::Sqrt(u0);
+        b0 = P(1.0) - su0;
+        b1 = u1 * su0;
+    });
+}
@@ -0,0 +1,35 @@
+/*
+    This file is part of Spectre, an open-source physically based
+    spectral raytracing library.
+
+    Copyright (c) 2020-2023 Samuel Van Allen - All rights reserved.
+
+    Spectre is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+// Structure of arrays versions of the warps in sampling.h. Each call maps the
+// uniform samples (u0[i], u1[i]) to the i-th output in every output span, at
+// the full SIMD width. Results match the scalar warps to within rounding.
+// All spans of a call must have the same size.
+namespace Sampling
+{
+    void UniformSampleHemisphere(std::span<const double> u0, std::span<const double> u1, std::span<double> x, std::span<double> y, std::span<double> z);
+    void UniformSampleSphere(std::span<const double> u0, std::span<const double> u1, std::span<double> x, std::span<double> y, std::span<double> z);
+    void ConcentricSampleDisk(std::span<const double> u0, std::span<const double> u1, std::span<double> x, std::span<double> y);
+    void CosineSampleHemisphere(std::span<const double> u0, std::span<const double> u1, std::span<double> x, std::span<double> y, std::span<double> z);
+    void UniformSampleCone(std::span<const double> u0, std::span<const double> u1, double cosThetaMax, std::span<double> x, std::span<double> y, std::span<double> z);
+    void UniformSampleTriangle(std::span<const double> u0, std::span<const double> u1, std::span<double> b0, std::span<double> b1);
+}
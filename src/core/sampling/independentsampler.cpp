@@ -0,0 +1,51 @@
+/*
+    This file is part of Spectre, an open-source physically based
+    spectral raytracing library.
+
+    Copyright (c) 2020-2023 Samuel Van Allen - All rights reserved.
+
+    Spectre is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "independentsampler.h"
+
+IndependentSampler::IndependentSampler(int samplesPerPixel, uint64_t seed)
+    : Sampler(samplesPerPixel, seed)
+{
+    StartPixelSample({ 0, 0 }, 0);
+}
+
+void IndependentSampler::StartPixelSample(const Point2i& pixel, int sampleIndex, int dimension)
+{
+    Sampler::StartPixelSample(pixel, sampleIndex, dimension);
+    m_Rng = Pcg32::ForSample(pixel, sampleIndex, dimension, m_Seed);
+}
+
+double IndependentSampler::Get1D()
+{
+    ++m_Dimension;
+    return m_Rng.NextDouble();
+}
+
+Point2 IndependentSampler::Get2D()
+{
+    m_Dimension += 2;
+    double u0 = m_Rng.NextDouble();
+    return { u0, m_Rng.NextDouble() };
+}
+
+std::unique_ptr<Sampler> IndependentSampler::Clone() const
+{
+    return std::make_unique<IndependentSampler>(*this);
+}
@@ -0,0 +1,41 @@
+/*
+    This file is part of Spectre, an open-source physically based
+    spectral raytracing library.
+
+    Copyright (c) 2020-2023 Samuel Van Allen - All rights reserved.
+
+    Spectre is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "sampler.h"
+
+// Uncorrelated random values, the baseline every other sampler is compared to
+class IndependentSampler : public Sampler
+{
+public:
+    IndependentSampler(int samplesPerPixel, uint64_t seed = 0);
+
+public:
+    void StartPixelSample(const Point2i& pixel, int sampleIndex, int dimension = 0) override;
+
+    double Get1D() override;
+    Point2 Get2D() override;
+
+    std::unique_ptr<Sampler> Clone() const override;
+
+private:
+    Pcg32 m_Rng;
+};
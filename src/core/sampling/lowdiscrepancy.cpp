@@ -0,0 +1,170 @@
+/*
+    This file is part of Spectre, an open-source physically based
+    spectral raytracing library.
+
+    Copyright (c) 2020-2023 Samuel Van Allen - All rights reserved.
+
+    Spectre is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "lowdiscrepancy.h"
+
+#include <array>
+#include <bit>
+
+namespace
+{
+    const double OneMinusEpsilon = 0x1.fffffffffffffp-1;
+
+    // Degree, polynomial coefficients and initial direction numbers of Sobol
+    // dimensions 1 and up, from the new-joe-kuo-6.21201 table
+    struct SobolPolynomial
+    {
+        int m_Degree;
+        uint32_t m_Coefficients;
+        uint32_t m_Initial[6];
+    };
+
+    constexpr SobolPolynomial SobolPolynomials[LowDiscrepancy::NumSobolDimensions - 1] = {
+        { 1, 0, { 1 } },
+        { 2, 1, { 1, 3 } },
+        { 3, 1, { 1, 3, 1 } },
+        { 3, 2, { 1, 1, 1 } },
+        { 4, 1, { 1, 1, 3, 3 } },
+        { 4, 4, { 1, 3, 5, 13 } },
+        { 5, 2, { 1, 1, 5, 5, 17 } },
+        { 5, 4, { 1, 1, 5, 5, 5 } },
+        { 5, 7, { 1, 1, 7, 11, 19 } },
+        { 5, 11, { 1, 1, 5, 1, 1 } },
+        { 5, 13, { 1, 1, 1, 3, 11 } },
+        { 5, 14, { 1, 3, 5, 5, 31 } },
+        { 6, 1, { 1, 3, 3, 9, 7, 49 } },
+        { 6, 13, { 1, 1, 1, 15, 21, 21 } },
+        { 6, 16, { 1, 3, 1, 13, 27, 49 } }
+    };
+
+    typedef std::array<std::array<uint32_t, 32>, LowDiscrepancy::NumSobolDimensions> SobolMatrices;
+
+    // Column i of a generator matrix is XORed in for bit i of the index
+    constexpr SobolMatrices ComputeSobolMatrices()
+    {
+        SobolMatrices matrices = {};
+        for (int i = 0; i < 32; ++i)
+            matrices[0][i] = 1u << (31 - i);
+
+        for (int d = 1; d < LowDiscrepancy::NumSobolDimensions; ++d)
+        {
+            const SobolPolynomial& polynomial = SobolPolynomials[d - 1];
+            int s = polynomial.m_Degree;
+            std::array<uint32_t, 32>& v = matrices[d];
+
+            for (int i = 0; i < s; ++i)
+                v[i] = polynomial.m_Initial[i] << (31 - i);
+
+            for (int i = s; i < 32; ++i)
+            {
+                v[i] = v[i - s] ^ (v[i - s] >> s);
+                for (int k = 1; k < s; ++k)
+                    v[i] ^= ((polynomial.m_Coefficients >> (s - 1 - k)) & 1) * v[i - k];
+            }
+        }
+
+        return matrices;
+    }
+
+    constexpr SobolMatrices SobolGenerators = ComputeSobolMatrices();
+
+    constexpr std::array<int, LowDiscrepancy::NumHaltonDimensions> ComputePrimes()
+    {
+        std::array<int, LowDiscrepancy::NumHaltonDimensions> primes = {};
+        int count = 0;
+        for (int candidate = 2; count < LowDiscrepancy::NumHaltonDimensions; ++candidate)
+        {
+            bool isPrime = true;
+            for (int i = 0; i < count && primes[i] * primes[i] <= candidate; ++i)
+                isPrime = isPrime && candidate % primes[i] != 0;
+
+            if (isPrime)
+                primes[count++] = candidate;
+        }
+
+        return primes;
+    }
+
+    constexpr std::array<int, LowDiscrepancy::NumHaltonDimensions> Primes = ComputePrimes();
+}
+
+double LowDiscrepancy::SobolSample(uint32_t index, int dimension, uint32_t seed)
+{
+    uint32_t v = 0;
+    const std::array<uint32_t, 32>& matrix = SobolGenerators[dimension];
+    for (int i = 0; index != 0; index >>= 1, ++i)
+    {
+        if (index & 1)
+            v ^= matrix[i];
+    }
+
+    return std::min(OwenScramble(v, seed) * 0x1p-32, OneMinusEpsilon);
+}
+
+uint32_t LowDiscrepancy::PermuteIndex(uint32_t index, uint32_t count, uint32_t seed)
+{
+    if (count <= 1)
+        return 0;
+
+    // Low bits of the reversed, scrambled value only depend on the low bits of
+    // index, so masking them permutes [0, 2^n)
+    uint32_t mask = ~0u >> std::countl_zero(count - 1);
+    do
+    {
+        index = ReverseBits32(OwenScramble(ReverseBits32(index), seed)) & mask;
+    } while (index >= count);
+
+    return index;
+}
+
+int LowDiscrepancy::GetHaltonBase(int dimension)
+{
+    return Primes[dimension];
+}
+
+double LowDiscrepancy::ScrambledRadicalInverse(uint64_t index, int dimension, uint64_t seed)
+{
+    const uint64_t base = (uint64_t)Primes[dimension];
+    const double invBase = 1.0 / base;
+
+    uint64_t reversedDigits = 0;
+    uint64_t digitIndex = 0;
+    double invBaseM = 1;
+
+    // Digits are generated until they no longer change the result, so that
+    // trailing zero digits get scrambled as well
+    while (1 - invBaseM < 1)
+    {
+        uint64_t next = index / base;
+        uint64_t digit = index - next * base;
+
+        // The shift depends on the digits before this one, which makes it a
+        // nested scramble rather than a plain digit shift
+        uint64_t shift = Pcg32::MixBits(seed ^ Pcg32::MixBits(reversedDigits ^ (digitIndex << 56)));
+        digit = (digit + shift) % base;
+
+        reversedDigits = reversedDigits * base + digit;
+        invBaseM *= invBase;
+        index = next;
+        ++digitIndex;
+    }
+
+    return std::min(invBaseM * reversedDigits, OneMinusEpsilon);
+}
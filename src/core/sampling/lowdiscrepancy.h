@@ -0,0 +1,69 @@
+/*
+    This file is part of Spectre, an open-source physically based
+    spectral raytracing library.
+
+    Copyright (c) 2020-2023 Samuel Van Allen - All rights reserved.
+
+    Spectre is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+// Building blocks of the quasi-random samplers. Every sequence is randomized
+// with nested (Owen) scrambling keyed by a seed, which keeps its stratification
+// while decorrelating pixels and dimensions.
+namespace LowDiscrepancy
+{
+    // Dimensions with their own Sobol generator matrix, and with their own
+    // Halton base. Samplers reuse them with fresh seeds beyond that.
+    const int NumSobolDimensions = 16;
+    const int NumHaltonDimensions = 64;
+
+    inline uint32_t ReverseBits32(uint32_t v)
+    {
+        v = (v << 16) | (v >> 16);
+        v = ((v & 0x00ff00ff) << 8) | ((v & 0xff00ff00) >> 8);
+        v = ((v & 0x0f0f0f0f) << 4) | ((v & 0xf0f0f0f0) >> 4);
+        v = ((v & 0x33333333) << 2) | ((v & 0xcccccccc) >> 2);
+        v = ((v & 0x55555555) << 1) | ((v & 0xaaaaaaaa) >> 1);
+        return v;
+    }
+
+    // Hash based approximation of Owen scrambling (Laine and Karras 2011,
+    // improved constants by Burley 2020). Every output bit only depends on
+    // the input bits above it, so intervals of [0, 1) are permuted as a whole.
+    inline uint32_t OwenScramble(uint32_t v, uint32_t seed)
+    {
+        v = ReverseBits32(v);
+        v ^= v * 0x3d20adea;
+        v += seed;
+        v *= (seed >> 16) | 1;
+        v ^= v * 0x05526c56;
+        v ^= v * 0x53a22864;
+        return ReverseBits32(v);
+    }
+
+    // Owen scrambled Sobol point, dimension must be below NumSobolDimensions
+    double SobolSample(uint32_t index, int dimension, uint32_t seed);
+
+    // Randomly permutes [0, count) through an Owen scrambled bit reversal,
+    // cycle walking for counts that are not a power of two
+    uint32_t PermuteIndex(uint32_t index, uint32_t count, uint32_t seed);
+
+    int GetHaltonBase(int dimension);
+
+    // Radical inverse of index in the dimension's prime base, with every digit
+    // shifted by a value hashed from seed and the digits before it
+    double ScrambledRadicalInverse(uint64_t index, int dimension, uint64_t seed);
+}
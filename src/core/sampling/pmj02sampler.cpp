@@ -0,0 +1,63 @@
+/*
+    This file is part of Spectre, an open-source physically based
+    spectral raytracing library.
+
+    Copyright (c) 2020-2023 Samuel Van Allen - All rights reserved.
+
+    Spectre is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "pmj02sampler.h"
+#include "lowdiscrepancy.h"
+
+#include <bit>
+
+Pmj02Sampler::Pmj02Sampler(int samplesPerPixel, uint64_t seed)
+    : Sampler(samplesPerPixel, seed)
+{
+}
+
+double Pmj02Sampler::Get1D()
+{
+    uint64_t hash = HashDimension(m_Dimension++);
+    return LowDiscrepancy::SobolSample(GetShuffledIndex(hash), 0, (uint32_t)(hash >> 32));
+}
+
+Point2 Pmj02Sampler::Get2D()
+{
+    uint64_t hash = HashDimension(m_Dimension);
+    m_Dimension += 2;
+
+    uint32_t index = GetShuffledIndex(hash);
+    uint64_t scramble = Pcg32::MixBits(hash);
+    return {
+        LowDiscrepancy::SobolSample(index, 0, (uint32_t)scramble),
+        LowDiscrepancy::SobolSample(index, 1, (uint32_t)(scramble >> 32))
+    };
+}
+
+std::unique_ptr<Sampler> Pmj02Sampler::Clone() const
+{
+    return std::make_unique<Pmj02Sampler>(*this);
+}
+
+uint32_t Pmj02Sampler::GetShuffledIndex(uint64_t hash) const
+{
+    // Every aligned block of a power of two Sobol points is a (0,2) net, so the
+    // samples are shuffled within blocks that cover the pixel's sample count
+    uint32_t blockSize = std::bit_ceil((uint32_t)m_SamplesPerPixel);
+    uint32_t index = (uint32_t)m_SampleIndex;
+    uint32_t blockStart = index & ~(blockSize - 1);
+    return blockStart + LowDiscrepancy::PermuteIndex(index - blockStart, blockSize, (uint32_t)hash);
+}
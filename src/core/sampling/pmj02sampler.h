@@ -0,0 +1,43 @@
+/*
+    This file is part of Spectre, an open-source physically based
+    spectral raytracing library.
+
+    Copyright (c) 2020-2023 Samuel Van Allen - All rights reserved.
+
+    Spectre is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "sampler.h"
+
+// Progressive (0,2) sequence samples. Every 2D request takes the first two
+// Sobol dimensions, which form a (0,2) sequence just like PMJ02 points, Owen
+// scrambled and with the sample order shuffled per dimension so that separate
+// dimensions do not correlate. With a power of two samples per pixel, the
+// samples of a pixel cover every elementary interval of every 2D dimension.
+class Pmj02Sampler : public Sampler
+{
+public:
+    Pmj02Sampler(int samplesPerPixel, uint64_t seed = 0);
+
+public:
+    double Get1D() override;
+    Point2 Get2D() override;
+
+    std::unique_ptr<Sampler> Clone() const override;
+
+private:
+    uint32_t GetShuffledIndex(uint64_t hash) const;
+};
@@ -0,0 +1,72 @@
+/*
+    This file is part of Spectre, an open-source physically based
+    spectral raytracing library.
+
+    Copyright (c) 2020-2023 Samuel Van Allen - All rights reserved.
+
+    Spectre is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "sampler.h"
+#include "independentsampler.h"
+#include "haltonsampler.h"
+#include "sobolsampler.h"
+#include "pmj02sampler.h"
+
+Sampler::Sampler(int samplesPerPixel, uint64_t seed)
+    : m_SamplesPerPixel(samplesPerPixel)
+    , m_Seed(seed)
+    , m_Pixel(0, 0)
+    , m_PixelHash(0)
+    , m_SampleIndex(0)
+    , m_Dimension(0)
+{
+    if (samplesPerPixel <= 0)
+        throw std::invalid_argument("Sampler needs at least one sample per pixel");
+
+    StartPixelSample({ 0, 0 }, 0);
+}
+
+void Sampler::StartPixelSample(const Point2i& pixel, int sampleIndex, int dimension)
+{
+    if (sampleIndex < 0 || dimension < 0)
+        throw std::invalid_argument("Sample index and dimension cannot be negative");
+
+    m_Pixel = pixel;
+    m_PixelHash = Pcg32::MixBits((((uint64_t)(uint32_t)pixel.x << 32) | (uint32_t)pixel.y) ^ Pcg32::MixBits(m_Seed + 1));
+    m_SampleIndex = sampleIndex;
+    m_Dimension = dimension;
+}
+
+uint64_t Sampler::HashDimension(int dimension) const
+{
+    return Pcg32::MixBits(m_PixelHash ^ (((uint64_t)dimension + 1) * 0x9e3779b97f4a7c15ULL));
+}
+
+std::unique_ptr<Sampler> CreateSampler(SamplerType type, int samplesPerPixel, uint64_t seed)
+{
+    switch (type)
+    {
+    case SamplerType::Independent:
+        return std::make_unique<IndependentSampler>(samplesPerPixel, seed);
+    case SamplerType::Halton:
+        return std::make_unique<HaltonSampler>(samplesPerPixel, seed);
+    case SamplerType::Sobol:
+        return std::make_unique<SobolSampler>(samplesPerPixel, seed);
+    case SamplerType::Pmj02:
+        return std::make_unique<Pmj02Sampler>(samplesPerPixel, seed);
+    }
+
+    throw std::invalid_argument("Unknown sampler type");
+}
@@ -0,0 +1,73 @@
+/*
+    This file is part of Spectre, an open-source physically based
+    spectral raytracing library.
+
+    Copyright (c) 2020-2023 Samuel Van Allen - All rights reserved.
+
+    Spectre is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+enum class SamplerType
+{
+    Independent,
+    Halton,
+    Sobol,
+    Pmj02
+};
+
+// Source of the sample values of one pixel sample at a time. Every Get1D or
+// Get2D call consumes the next dimension(s) of the current sample, so callers
+// that ask in a fixed order see the same dimension used for the same purpose
+// in every sample. The values of a (pixel, sample, dimension) never depend on
+// the thread or the order in which samples are taken.
+//
+// Samplers carry per sample state, every thread must work on its own Clone.
+class Sampler
+{
+public:
+    Sampler(int samplesPerPixel, uint64_t seed);
+    virtual ~Sampler() = default;
+
+public:
+    inline int GetSamplesPerPixel() const { return m_SamplesPerPixel; }
+    inline uint64_t GetSeed() const { return m_Seed; }
+    inline const Point2i& GetPixel() const { return m_Pixel; }
+    inline int GetSampleIndex() const { return m_SampleIndex; }
+    inline int GetDimension() const { return m_Dimension; }
+
+public:
+    virtual void StartPixelSample(const Point2i& pixel, int sampleIndex, int dimension = 0);
+
+    virtual double Get1D() = 0;
+    virtual Point2 Get2D() = 0;
+
+    virtual std::unique_ptr<Sampler> Clone() const = 0;
+
+protected:
+    // Keys the scrambling of one dimension of the current pixel
+    uint64_t HashDimension(int dimension) const;
+
+protected:
+    int m_SamplesPerPixel;
+    uint64_t m_Seed;
+
+    Point2i m_Pixel;
+    uint64_t m_PixelHash;
+    int m_SampleIndex;
+    int m_Dimension;
+};
+
+std::unique_ptr<Sampler> CreateSampler(SamplerType type, int samplesPerPixel, uint64_t seed = 0);
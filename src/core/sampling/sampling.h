@@ -19,47 +19,63 @@
 */
 
 #pragma once
-
+// Warping functions map uniform samples u in [0, 1)^2 onto a domain. Feeding
+// them stratified or low-discrepancy u from a Sampler carries that structure
+// over to the warped points. The overloads without u draw from rng, which
+// defaults to the calling thread's generator.
 namespace Sampling
 {
-    inline Point3 UniformSampleHemisphere()
+    inline Point3 UniformSampleHemisphere(const Point2& u)
     {
-        double y = Random::UniformFloat();
+        double y = u.x;
         double r = std::sqrt(std::max(0.0, 1.0 - y * y));
-        double phi = 2 * Math::Pi * Random::UniformFloat();
+        double phi = 2 * Math::Pi * u.y;
         return Point3(r * cos(phi), y, r * sin(phi));
     }
 
+    inline Point3 UniformSampleHemisphere(Pcg32& rng = Random::GetThreadGenerator())
+    {
+        double u0 = rng.NextDouble();
+        return UniformSampleHemisphere(Point2(u0, rng.NextDouble()));
+    }
+
     inline double UniformHemispherePdf() {
         return Math::Inv2Pi;
     }
 
-    inline Point3 UniformSampleSphere()
+    inline Point3 UniformSampleSphere(const Point2& u)
     {
-        double z = 1 - 2 * Random::UniformFloat();
+        double z = 1 - 2 * u.x;
         double r = std::sqrt(std::max(0.0, 1.0 - z * z));
-        double phi = 2 * Math::Pi * Random::UniformFloat();
+        double phi = 2 * Math::Pi * u.y;
         return Point3(r * cos(phi), r * sin(phi), z);
     }
 
+    inline Point3 UniformSampleSphere(Pcg32& rng = Random::GetThreadGenerator())
+    {
+        double u0 = rng.NextDouble();
+        return UniformSampleSphere(Point2(u0, rng.NextDouble()));
+    }
+
     inline double UniformSpherePdf()
     {
         return Math::Inv4Pi;
     }
 
-    inline Point2 RejectionSampleDisk()
+    // Needs an unbounded number of random values, so it has no u overload
+    inline Point2 RejectionSampleDisk(Pcg32& rng = Random::GetThreadGenerator())
     {
         Point2 p;
         do {
-            p.x = 1 - 2 * Random::UniformFloat();
-            p.y = 1 - 2 * Random::UniformFloat();
+            p.x = 1 - 2 * rng.NextDouble();
+            p.y = 1 - 2 * rng.NextDouble();
         } while (p.x * p.x + p.y * p.y > 1);
         return p;
     }
 
-    inline Point2 ConcentricSampleDisk()
+    inline Point2 ConcentricSampleDisk(const Point2& u)
     {
-        Point2 uOffset = Point2(Random::UniformFloat() * 2.0 - 1.0, Random::UniformFloat() * 2.0 - 1.0);
+        Point2 uOffset = Point2(u.x * 2.0 - 1.0, u.y * 2.0 - 1.0);
 
         if (uOffset.x == 0 && uOffset.y == 0)
             return {};
@@ -80,16 +96,49 @@ namespace Sampling
         return Point2(cos(theta) * r, sin(theta) * r);
     }
 
-    inline Point3 CosineSampleHemisphere()
+    inline Point2 ConcentricSampleDisk(Pcg32& rng = Random::GetThreadGenerator())
+    {
+        double u0 = rng.NextDouble();
+        return ConcentricSampleDisk(Point2(u0, rng.NextDouble()));
+    }
+
+    inline Point3 CosineSampleHemisphere(const Point2& u)
     {
-        Point2 d = ConcentricSampleDisk();
+        Point2 d = ConcentricSampleDisk(u);
         double z = std::sqrt(std::max(0.0, 1.0 - d.x * d.x - d.y * d.y));
         return Point3(d.x, d.y, z);
     }
 
+    inline Point3 CosineSampleHemisphere(Pcg32& rng = Random::GetThreadGenerator())
+    {
+        double u0 = rng.NextDouble();
+        return CosineSampleHemisphere(Point2(u0, rng.NextDouble()));
+    }
+
     inline double CosineHemispherePdf(double cosTheta)
     {
         return cosTheta * Math::InvPi;
     }
-}
 
+    // Direction within cosThetaMax of the z axis
+    inline Point3 UniformSampleCone(const Point2& u, double cosThetaMax)
+    {
+        double cosTheta = (1 - u.x) + u.x * cosThetaMax;
+        double sinTheta = std::sqrt(std::max(0.0, 1.0 - cosTheta * cosTheta));
+        double phi = 2 * Math::Pi * u.y;
+        return Point3(cos(phi) * sinTheta, sin(phi) * sinTheta, cosTheta);
+    }
+
+    inline double UniformConePdf(double cosThetaMax)
+    {
+        return 1 / (2 * Math::Pi * (1 - cosThetaMax));
+    }
+
+    // Barycentric coordinates (b0, b1) of a point uniformly distributed over a
+    // triangle, the third one is 1 - b0 - b1
+    inline Point2 UniformSampleTriangle(const Point2& u)
+    {
+        double su0 = std::sqrt(u.x);
+        return Point2(1 - su0, u.y * su0);
+    }
+}
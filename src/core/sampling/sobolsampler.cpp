@@ -0,0 +1,51 @@
+/*
+    This file is part of Spectre, an open-source physically based
+    spectral raytracing library.
+
+    Copyright (c) 2020-2023 Samuel Van Allen - All rights reserved.
+
+    Spectre is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "sobolsampler.h"
+#include "lowdiscrepancy.h"
+
+SobolSampler::SobolSampler(int samplesPerPixel, uint64_t seed)
+    : Sampler(samplesPerPixel, seed)
+{
+}
+
+double SobolSampler::Get1D()
+{
+    return SampleDimension(m_Dimension++);
+}
+
+Point2 SobolSampler::Get2D()
+{
+    double u0 = SampleDimension(m_Dimension++);
+    return { u0, SampleDimension(m_Dimension++) };
+}
+
+std::unique_ptr<Sampler> SobolSampler::Clone() const
+{
+    return std::make_unique<SobolSampler>(*this);
+}
+
+double SobolSampler::SampleDimension(int dimension) const
+{
+    // Dimensions past the last generator matrix start over with scrambles of
+    // their own
+    int matrix = dimension % LowDiscrepancy::NumSobolDimensions;
+    return LowDiscrepancy::SobolSample(m_SampleIndex, matrix, (uint32_t)HashDimension(dimension));
+}
@@ -20,8 +20,9 @@
 
 #include "illuminantspectrum.h"
 
-IlluminantSpectrum::IlluminantSpectrum(const RgbCoefficients& rgb)
-    : SampledSpectrum()
+template <typename T, int N>
+BasicIlluminantSpectrum<T, N>::BasicIlluminantSpectrum(const RgbCoefficients& rgb)
+    : BasicSampledSpectrum<T, N>()
 {
     // An Rgb to Spectrum Conversion for Reflectances, Smits(2000)
     // http://citeseerx.ist.psu.edu/viewdoc/download?doi=10.1.1.40.9608&rep=rep1&type=pdf
@@ -51,48 +52,62 @@ IlluminantSpectrum::IlluminantSpectrum(const RgbCoefficients& rgb)
             InitAscendingBgr(rgb);
     }
 
-    ClampZero();
+    this->ClampZero();
 }
 
-void IlluminantSpectrum::InitAscendingRgb(const RgbCoefficients& rgb)
+template <typename T, int N>
+void BasicIlluminantSpectrum<T, N>::InitAscendingRgb(const RgbCoefficients& rgb)
 {
-    *this += stdIllumW * rgb[0];
-    *this += stdIllumC * (rgb[1] - rgb[0]);
-    *this += stdIllumB * (rgb[2] - rgb[1]);
+    *this += stdIllumW * rgb[0] +
+             stdIllumC * (rgb[1] - rgb[0]) +
+             stdIllumB * (rgb[2] - rgb[1]);
 }
 
-void IlluminantSpectrum::InitAscendingRbg(const RgbCoefficients& rgb)
+template <typename T, int N>
+void BasicIlluminantSpectrum<T, N>::InitAscendingRbg(const RgbCoefficients& rgb)
 {
-    *this += stdIllumW * rgb[0];
-    *this += stdIllumC * (rgb[2] - rgb[0]);
-    *this += stdIllumG * (rgb[1] - rgb[2]);
+    *this += stdIllumW * rgb[0] +
+             stdIllumC * (rgb[2] - rgb[0]) +
+             stdIllumG * (rgb[1] - rgb[2]);
 }
 
-void IlluminantSpectrum::InitAscendingGrb(const RgbCoefficients& rgb)
+template <typename T, int N>
+void BasicIlluminantSpectrum<T, N>::InitAscendingGrb(const RgbCoefficients& rgb)
 {
-    *this += stdIllumW * rgb[1];
-    *this += stdIllumM * (rgb[0] - rgb[1]);
-    *this += stdIllumB * (rgb[2] - rgb[0]);
+    *this += stdIllumW * rgb[1] +
+             stdIllumM * (rgb[0] - rgb[1]) +
+             stdIllumB * (rgb[2] - rgb[0]);
 }
 
-void IlluminantSpectrum::InitAscendingGbr(const RgbCoefficients& rgb)
+template <typename T, int N>
+void BasicIlluminantSpectrum<T, N>::InitAscendingGbr(const RgbCoefficients& rgb)
 {
-    *this += stdIllumW * rgb[1];
-    *this += stdIllumM * (rgb[2] - rgb[1]);
-    *this += stdIllumR * (rgb[0] - rgb[2]);
+    *this += stdIllumW * rgb[1] +
+             stdIllumM * (rgb[2] - rgb[1]) +
+             stdIllumR * (rgb[0] - rgb[2]);
 }
 
-void IlluminantSpectrum::InitAscendingBrg(const RgbCoefficients& rgb)
+template <typename T, int N>
+void BasicIlluminantSpectrum<T, N>::InitAscendingBrg(const RgbCoefficients& rgb)
 {
-    *this += stdIllumW * rgb[2];
-    *this += stdIllumY * (rgb[0] - rgb[2]);
-    *this += stdIllumG * (rgb[1] - rgb[0]);
+    *this += stdIllumW * rgb[2] +
+             stdIllumY * (rgb[0] - rgb[2]) +
+             stdIllumG * (rgb[1] - rgb[0]);
 }
 
-void IlluminantSpectrum::InitAscendingBgr(const RgbCoefficients& rgb)
+template <typename T, int N>
+void BasicIlluminantSpectrum<T, N>::InitAscendingBgr(const RgbCoefficients& rgb)
 {
-    *this += stdIllumW * rgb[2];
-    *this += stdIllumY * (rgb[1] - rgb[2]);
-    *this += stdIllumR * (rgb[0] - rgb[1]);
+    *this += stdIllumW * rgb[2] +
+             stdIllumY * (rgb[1] - rgb[2]) +
+             stdIllumR * (rgb[0] - rgb[1]);
 }
 
+template class BasicIlluminantSpectrum<float, 16>;
+template class BasicIlluminantSpectrum<float, 32>;
+template class BasicIlluminantSpectrum<float, 60>;
+template class BasicIlluminantSpectrum<float, 128>;
+template class BasicIlluminantSpectrum<double, 16>;
+template class BasicIlluminantSpectrum<double, 32>;
+template class BasicIlluminantSpectrum<double, 60>;
+template class BasicIlluminantSpectrum<double, 128>;
@@ -22,19 +22,43 @@
 
 #include "sampledspectrum.h"
 
-class IlluminantSpectrum : public SampledSpectrum
+template <typename T, int N>
+class BasicIlluminantSpectrum : public BasicSampledSpectrum<T, N>
 {
 public:
-    IlluminantSpectrum(const RgbCoefficients& rgb);
+    using typename BasicSampledSpectrum<T, N>::RgbCoefficients;
+
+public:
+    BasicIlluminantSpectrum(const RgbCoefficients& rgb);
 
     // TODO: Might have to override the normalization constant to 
     // 683lm/W: https://light-measurement.com/colorimetry/
 
 private:
+    using BasicSampledSpectrum<T, N>::stdIllumW;
+    using BasicSampledSpectrum<T, N>::stdIllumC;
+    using BasicSampledSpectrum<T, N>::stdIllumM;
+    using BasicSampledSpectrum<T, N>::stdIllumY;
+    using BasicSampledSpectrum<T, N>::stdIllumR;
+    using BasicSampledSpectrum<T, N>::stdIllumG;
+    using BasicSampledSpectrum<T, N>::stdIllumB;
+
     void InitAscendingRgb(const RgbCoefficients& rgb);
     void InitAscendingRbg(const RgbCoefficients& rgb);
     void InitAscendingGrb(const RgbCoefficients& rgb);
     void InitAscendingGbr(const RgbCoefficients& rgb);
     void InitAscendingBrg(const RgbCoefficients& rgb);
     void InitAscendingBgr(const RgbCoefficients& rgb);
-};
\ No newline at end of file
+};
+
+// Defined and explicitly instantiated in illuminantspectrum.cpp
+extern template class BasicIlluminantSpectrum<float, 16>;
+extern template class BasicIlluminantSpectrum<float, 32>;
+extern template class BasicIlluminantSpectrum<float, 60>;
+extern template class BasicIlluminantSpectrum<float, 128>;
+extern template class BasicIlluminantSpectrum<double, 16>;
+extern template class BasicIlluminantSpectrum<double, 32>;
+extern template class BasicIlluminantSpectrum<double, 60>;
+extern template class BasicIlluminantSpectrum<double, 128>;
+
+typedef BasicIlluminantSpectrum<SpectralReal, NumSpectralSamples> IlluminantSpectrum;
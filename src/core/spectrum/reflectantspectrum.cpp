@@ -20,8 +20,9 @@
 
 #include "reflectantspectrum.h"
 
-ReflectantSpectrum::ReflectantSpectrum(const RgbCoefficients& rgb)
-    : SampledSpectrum()
+template <typename T, int N>
+BasicReflectantSpectrum<T, N>::BasicReflectantSpectrum(const RgbCoefficients& rgb)
+    : BasicSampledSpectrum<T, N>()
 {
     // An Rgb to Spectrum Conversion for Reflectances, Smits(2000)
     // http://citeseerx.ist.psu.edu/viewdoc/download?doi=10.1.1.40.9608&rep=rep1&type=pdf
@@ -51,48 +52,77 @@ ReflectantSpectrum::ReflectantSpectrum(const RgbCoefficients& rgb)
             InitAscendingBgr(rgb);
     }
 
-    ClampZero();
+    this->ClampZero();
 }
 
-void ReflectantSpectrum::InitAscendingRgb(const RgbCoefficients& rgb)
+template <typename T, int N>
+BasicReflectantSpectrum<T, N>::BasicReflectantSpectrum(const RgbCoefficients& rgb, const RgbToSpectrumTable& table)
+    : BasicSampledSpectrum<T, N>()
 {
-    *this += stdReflW * rgb[0];
-    *this += stdReflC * (rgb[1] - rgb[0]);
-    *this += stdReflB * (rgb[2] - rgb[1]);
+    // Sample the fitted sigmoid at the center of every bin. Already bounded to
+    // [0, 1], so no clamping is needed.
+    SigmoidPolynomial polynomial = table.Lookup(rgb);
+    for (int i = 0; i < N; ++i)
+    {
+        double start, end;
+        this->ComputeRangeAtIndex(i, start, end);
+        this->m_Coefficients[i] = T(polynomial.Evaluate((start + end) / 2.0));
+    }
+}
+
+template <typename T, int N>
+void BasicReflectantSpectrum<T, N>::InitAscendingRgb(const RgbCoefficients& rgb)
+{
+    *this += stdReflW * rgb[0] +
+             stdReflC * (rgb[1] - rgb[0]) +
+             stdReflB * (rgb[2] - rgb[1]);
 }
 
-void ReflectantSpectrum::InitAscendingRbg(const RgbCoefficients& rgb)
+template <typename T, int N>
+void BasicReflectantSpectrum<T, N>::InitAscendingRbg(const RgbCoefficients& rgb)
 {
-    *this += stdReflW * rgb[0];
-    *this += stdReflC * (rgb[2] - rgb[0]);
-    *this += stdReflG * (rgb[1] - rgb[2]);
+    *this += stdReflW * rgb[0] +
+             stdReflC * (rgb[2] - rgb[0]) +
+             stdReflG * (rgb[1] - rgb[2]);
 }
 
-void ReflectantSpectrum::InitAscendingGrb(const RgbCoefficients& rgb)
+template <typename T, int N>
+void BasicReflectantSpectrum<T, N>::InitAscendingGrb(const RgbCoefficients& rgb)
 {
-    *this += stdReflW * rgb[1];
-    *this += stdReflM * (rgb[0] - rgb[1]);
-    *this += stdReflB * (rgb[2] - rgb[0]);
+    *this += stdReflW * rgb[1] +
+             stdReflM * (rgb[0] - rgb[1]) +
+             stdReflB * (rgb[2] - rgb[0]);
 }
 
-void ReflectantSpectrum::InitAscendingGbr(const RgbCoefficients& rgb)
+template <typename T, int N>
+void BasicReflectantSpectrum<T, N>::InitAscendingGbr(const RgbCoefficients& rgb)
 {
-    *this += stdReflW * rgb[1];
-    *this += stdReflM * (rgb[2] - rgb[1]);
-    *this += stdReflR * (rgb[0] - rgb[2]);
+    *this += stdReflW * rgb[1] +
+             stdReflM * (rgb[2] - rgb[1]) +
+             stdReflR * (rgb[0] - rgb[2]);
 }
 
-void ReflectantSpectrum::InitAscendingBrg(const RgbCoefficients& rgb)
+template <typename T, int N>
+void BasicReflectantSpectrum<T, N>::InitAscendingBrg(const RgbCoefficients& rgb)
 {
-    *this += stdReflW * rgb[2];
-    *this += stdReflY * (rgb[0] - rgb[2]);
-    *this += stdReflG * (rgb[1] - rgb[0]);
+    *this += stdReflW * rgb[2] +
+             stdReflY * (rgb[0] - rgb[2]) +
+             stdReflG * (rgb[1] - rgb[0]);
 }
 
-void ReflectantSpectrum::InitAscendingBgr(const RgbCoefficients& rgb)
+template <typename T, int N>
+void BasicReflectantSpectrum<T, N>::InitAscendingBgr(const RgbCoefficients& rgb)
 {
-    *this += stdReflW * rgb[2];
-    *this += stdReflY * (rgb[1] - rgb[2]);
-    *this += stdReflR * (rgb[0] - rgb[1]);
+    *this += stdReflW * rgb[2] +
+             stdReflY * (rgb[1] - rgb[2]) +
+             stdReflR * (rgb[0] - rgb[1]);
 }
 
+template class BasicReflectantSpectrum<float, 16>;
+template class BasicReflectantSpectrum<float, 32>;
+template class BasicReflectantSpectrum<float, 60>;
+template class BasicReflectantSpectrum<float, 128>;
+template class BasicReflectantSpectrum<double, 16>;
+template class BasicReflectantSpectrum<double, 32>;
+template class BasicReflectantSpectrum<double, 60>;
+template class BasicReflectantSpectrum<double, 128>;
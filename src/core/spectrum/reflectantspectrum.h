@@ -21,17 +21,43 @@
 #pragma once
 
 #include "sampledspectrum.h"
+#include "rgbtospectrumtable.h"
 
-class ReflectantSpectrum : public SampledSpectrum
+template <typename T, int N>
+class BasicReflectantSpectrum : public BasicSampledSpectrum<T, N>
 {
 public:
-    ReflectantSpectrum(const RgbCoefficients& rgb);
+    using typename BasicSampledSpectrum<T, N>::RgbCoefficients;
+
+public:
+    BasicReflectantSpectrum(const RgbCoefficients& rgb);
+    BasicReflectantSpectrum(const RgbCoefficients& rgb, const RgbToSpectrumTable& table);
 
 private:
+    using BasicSampledSpectrum<T, N>::stdReflW;
+    using BasicSampledSpectrum<T, N>::stdReflC;
+    using BasicSampledSpectrum<T, N>::stdReflM;
+    using BasicSampledSpectrum<T, N>::stdReflY;
+    using BasicSampledSpectrum<T, N>::stdReflR;
+    using BasicSampledSpectrum<T, N>::stdReflG;
+    using BasicSampledSpectrum<T, N>::stdReflB;
+
     void InitAscendingRgb(const RgbCoefficients& rgb);
     void InitAscendingRbg(const RgbCoefficients& rgb);
     void InitAscendingGrb(const RgbCoefficients& rgb);
     void InitAscendingGbr(const RgbCoefficients& rgb);
     void InitAscendingBrg(const RgbCoefficients& rgb);
     void InitAscendingBgr(const RgbCoefficients& rgb);
-};
\ No newline at end of file
+};
+
+// Defined and explicitly instantiated in reflectantspectrum.cpp
+extern template class BasicReflectantSpectrum<float, 16>;
+extern template class BasicReflectantSpectrum<float, 32>;
+extern template class BasicReflectantSpectrum<float, 60>;
+extern template class BasicReflectantSpectrum<float, 128>;
+extern template class BasicReflectantSpectrum<double, 16>;
+extern template class BasicReflectantSpectrum<double, 32>;
+extern template class BasicReflectantSpectrum<double, 60>;
+extern template class BasicReflectantSpectrum<double, 128>;
+
+typedef BasicReflectantSpectrum<SpectralReal, NumSpectralSamples> ReflectantSpectrum;
@@ -0,0 +1,103 @@
+/*
+    This file is part of Spectre, an open-source physically based
+    spectral raytracing library.
+
+    Copyright (c) 2020-2023 Samuel Van Allen - All rights reserved.
+
+    Spectre is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "rgbtospectrumtable.h"
+#include <cstdlib>
+#include <cstring>
+#include "system/platform/executablepath.h"
+
+const std::string TableFileName = "srgb_to_spectrum.spec";
+
+RgbToSpectrumTable::RgbToSpectrumTable(const std::string& path)
+    : m_File(path)
+{
+    const char* data = static_cast<const char*>(m_File.GetData());
+    const size_t headerSize = 4 + sizeof(uint32_t);
+
+    if (m_File.GetSize() < headerSize || std::memcmp(data, "SPEC", 4) != 0)
+        throw std::runtime_error(path + " is not an RGB to spectrum table");
+
+    uint32_t resolution;
+    std::memcpy(&resolution, data + 4, sizeof(resolution));
+
+    size_t numCoefficients = size_t(3) * resolution * resolution * resolution * 3;
+    if (resolution < 2 || m_File.GetSize() != headerSize + (resolution + numCoefficients) * sizeof(float))
+        throw std::runtime_error(path + " is not an RGB to spectrum table");
+
+    m_Resolution = int(resolution);
+    m_ZNodes = reinterpret_cast<const float*>(data + headerSize);
+    m_Coefficients = m_ZNodes + m_Resolution;
+}
+
+std::string RgbToSpectrumTable::GetDefaultPath()
+{
+    std::filesystem::path directory;
+    if (const char* dataDirectory = std::getenv("SPC_DATA_DIR"))
+        directory = dataDirectory;
+    else
+        directory = GetExecutableDirectory() / "data";
+
+    return (directory / TableFileName).string();
+}
+
+SigmoidPolynomial RgbToSpectrumTable::Lookup(double r, double g, double b) const
+{
+    r = std::clamp(r, 0.0, 1.0);
+    g = std::clamp(g, 0.0, 1.0);
+    b = std::clamp(b, 0.0, 1.0);
+
+    // Greys have an exact solution with a constant polynomial
+    if (r == g && g == b)
+        return SigmoidPolynomial(0.0, 0.0, (r - 0.5) / std::sqrt(r * (1.0 - r)));
+
+    // The table is indexed by the largest component z, and the two others
+    // relative to it
+    double c[3] = { r, g, b };
+    int maxc = (r > g) ? (r > b ? 0 : 2) : (g > b ? 1 : 2);
+    double z = c[maxc];
+    double x = c[(maxc + 1) % 3] * (m_Resolution - 1) / z;
+    double y = c[(maxc + 2) % 3] * (m_Resolution - 1) / z;
+
+    int xi = std::min(int(x), m_Resolution - 2);
+    int yi = std::min(int(y), m_Resolution - 2);
+    int zi = int(std::upper_bound(m_ZNodes, m_ZNodes + m_Resolution, float(z)) - m_ZNodes) - 1;
+    zi = std::clamp(zi, 0, m_Resolution - 2);
+
+    double dx = x - xi;
+    double dy = y - yi;
+    double dz = (z - m_ZNodes[zi]) / (m_ZNodes[zi + 1] - m_ZNodes[zi]);
+
+    auto coefficient = [&](int dxi, int dyi, int dzi, int i) {
+        size_t index = ((size_t(maxc) * m_Resolution + zi + dzi) * m_Resolution + yi + dyi) * m_Resolution + xi + dxi;
+        return double(m_Coefficients[index * 3 + i]);
+    };
+
+    double result[3];
+    for (int i = 0; i < 3; ++i)
+    {
+        double c00 = std::lerp(coefficient(0, 0, 0, i), coefficient(1, 0, 0, i), dx);
+        double c10 = std::lerp(coefficient(0, 1, 0, i), coefficient(1, 1, 0, i), dx);
+        double c01 = std::lerp(coefficient(0, 0, 1, i), coefficient(1, 0, 1, i), dx);
+        double c11 = std::lerp(coefficient(0, 1, 1, i), coefficient(1, 1, 1, i), dx);
+        result[i] = std::lerp(std::lerp(c00, c10, dy), std::lerp(c01, c11, dy), dz);
+    }
+
+    return SigmoidPolynomial(result[0], result[1], result[2]);
+}
@@ -0,0 +1,57 @@
+/*
+    This file is part of Spectre, an open-source physically based
+    spectral raytracing library.
+
+    Copyright (c) 2020-2023 Samuel Van Allen - All rights reserved.
+
+    Spectre is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "sigmoidpolynomial.h"
+#include "system/platform/mappedfile.h"
+
+// Precomputed RGB to spectrum coefficients (Jakob & Hanika 2019), generated at
+// build time by tools/rgb2spec and memory mapped on load. Turning an RGB
+// reflectance into a spectrum is then a trilinear lookup of three sigmoid
+// polynomial coefficients.
+class RgbToSpectrumTable
+{
+public:
+    RgbToSpectrumTable(const std::string& path = GetDefaultPath());
+    ~RgbToSpectrumTable() = default;
+
+public:
+    // The table deployed in the data directory next to the executable, or in
+    // the directory named by the SPC_DATA_DIR environment variable if it is set
+    static std::string GetDefaultPath();
+
+
+    // Components are clamped to [0, 1]
+    SigmoidPolynomial Lookup(double r, double g, double b) const;
+
+    inline SigmoidPolynomial Lookup(const RgbCoefficients& rgb) const { return Lookup(rgb[0], rgb[1], rgb[2]); }
+
+    template <typename T>
+    inline SigmoidPolynomial Lookup(const BasicSpectralCoefficients<T>& rgb) const { return Lookup(rgb[0], rgb[1], rgb[2]); }
+
+    inline int GetResolution() const { return m_Resolution; }
+
+private:
+    MappedFile m_File;
+    int m_Resolution;
+    const float* m_ZNodes;
+    const float* m_Coefficients;
+};
@@ -19,187 +19,243 @@
 */
 
 #include "sampledspectrum.h"
-#include "spectralconstants.h"
-
-const SampledSpectrum SampledSpectrum::cieX = SampledSpectrum::FromSortedRawSamples(cieLambda, cieSamplesX, numCieSamples);
-const SampledSpectrum SampledSpectrum::cieY = SampledSpectrum::FromSortedRawSamples(cieLambda, cieSamplesY, numCieSamples);
-const SampledSpectrum SampledSpectrum::cieZ = SampledSpectrum::FromSortedRawSamples(cieLambda, cieSamplesZ, numCieSamples);
-
-const SampledSpectrum SampledSpectrum::stdReflW = SampledSpectrum::FromSortedRawSamples(stdLambda, stdReflSamplesW, numStdSamples);
-const SampledSpectrum SampledSpectrum::stdReflC = SampledSpectrum::FromSortedRawSamples(stdLambda, stdReflSamplesC, numStdSamples);
-const SampledSpectrum SampledSpectrum::stdReflM = SampledSpectrum::FromSortedRawSamples(stdLambda, stdReflSamplesM, numStdSamples);
-const SampledSpectrum SampledSpectrum::stdReflY = SampledSpectrum::FromSortedRawSamples(stdLambda, stdReflSamplesY, numStdSamples);
-const SampledSpectrum SampledSpectrum::stdReflR = SampledSpectrum::FromSortedRawSamples(stdLambda, stdReflSamplesR, numStdSamples);
-const SampledSpectrum SampledSpectrum::stdReflG = SampledSpectrum::FromSortedRawSamples(stdLambda, stdReflSamplesG, numStdSamples);
-const SampledSpectrum SampledSpectrum::stdReflB = SampledSpectrum::FromSortedRawSamples(stdLambda, stdReflSamplesB, numStdSamples);
-
-const SampledSpectrum SampledSpectrum::stdIllumW = SampledSpectrum::FromSortedRawSamples(stdLambda, stdIllumSamplesW, numStdSamples);
-const SampledSpectrum SampledSpectrum::stdIllumC = SampledSpectrum::FromSortedRawSamples(stdLambda, stdIllumSamplesC, numStdSamples);
-const SampledSpectrum SampledSpectrum::stdIllumM = SampledSpectrum::FromSortedRawSamples(stdLambda, stdIllumSamplesM, numStdSamples);
-const SampledSpectrum SampledSpectrum::stdIllumY = SampledSpectrum::FromSortedRawSamples(stdLambda, stdIllumSamplesY, numStdSamples);
-const SampledSpectrum SampledSpectrum::stdIllumR = SampledSpectrum::FromSortedRawSamples(stdLambda, stdIllumSamplesR, numStdSamples);
-const SampledSpectrum SampledSpectrum::stdIllumG = SampledSpectrum::FromSortedRawSamples(stdLambda, stdIllumSamplesG, numStdSamples);
-const SampledSpectrum SampledSpectrum::stdIllumB = SampledSpectrum::FromSortedRawSamples(stdLambda, stdIllumSamplesB, numStdSamples);
-
-SampledSpectrum::SampledSpectrum(const std::vector<SpectralSample>& samples)
+
+namespace
 {
-    if (IsSamplesSorted(samples))
+    template <typename T, int N>
+    struct XyzKernels
     {
-        for (int i = 0; i < NumSpectralSamples; ++i)
+        using Pack = Simd::Pack<T>;
+
+        static const int NumPackedSamples = N - (N % Pack::Width);
+
+        // Converts Count spectra at once so that each block of the CIE table is
+        // loaded once and reused across the whole batch
+        template <int Count>
+        static inline void ConvertToXyz(const BasicSampledSpectrum<T, N>* spectra, const T* table, BasicSpectralCoefficients<T>* xyz)
         {
-            double startLambda, endLambda;
-            ComputeRangeAtIndex(i, startLambda, endLambda);
-            m_Coefficients[i] = ComputeAverageInRange(samples, startLambda, endLambda);
+            Pack sums[Count][3];
+            for (int s = 0; s < Count; ++s)
+                sums[s][0] = sums[s][1] = sums[s][2] = Pack(T(0));
+
+            int i = 0;
+            for (; i < NumPackedSamples; i += Pack::Width)
+            {
+                const T* block = table + 3 * i;
+                Pack x = Pack::Load(block);
+                Pack y = Pack::Load(block + Pack::Width);
+                Pack z = Pack::Load(block + 2 * Pack::Width);
+
+                for (int s = 0; s < Count; ++s)
+                {
+                    Pack v = Pack::Load(spectra[s].m_Coefficients + i);
+                    sums[s][0] = sums[s][0] + v * x;
+                    sums[s][1] = sums[s][1] + v * y;
+                    sums[s][2] = sums[s][2] + v * z;
+                }
+            }
+
+            for (int s = 0; s < Count; ++s)
+                xyz[s] = { sums[s][0].ReduceAdd(), sums[s][1].ReduceAdd(), sums[s][2].ReduceAdd() };
+
+            for (; i < N; ++i)
+            {
+                const T* entry = table + 3 * i;
+                for (int s = 0; s < Count; ++s)
+                {
+                    T v = spectra[s].m_Coefficients[i];
+                    xyz[s][0] += v * entry[0];
+                    xyz[s][1] += v * entry[1];
+                    xyz[s][2] += v * entry[2];
+                }
+            }
         }
-    }
+    };
+
+    const int XyzBatchSize = 4;
 }
 
-SampledSpectrum SampledSpectrum::FromSortedRawSamples(const double* lambda, const double* power, int numSamples)
+template <typename T, int N>
+constexpr BasicSampledSpectrum<T, N>::CieXyzTable::CieXyzTable(const BasicSampledSpectrum& x, const BasicSampledSpectrum& y, const BasicSampledSpectrum& z, double scale)
 {
-    SampleArray sampleArray(numSamples);
+    const BasicSampledSpectrum* curves[3] = { &x, &y, &z };
+    const int numPackedSamples = XyzKernels<T, N>::NumPackedSamples;
 
-    for (int i = 0; i < numSamples; ++i)
-        sampleArray[i] = { lambda[i], power[i] };
+    for (int i = 0; i < N; ++i)
+    {
+        // Coefficients past the last full pack are stored as plain xyz triplets
+        int width = i < numPackedSamples ? XyzKernels<T, N>::Pack::Width : 1;
+        int blockStart = i - i % width;
 
-    return sampleArray;
+        for (int c = 0; c < 3; ++c)
+            m_Data[3 * blockStart + c * width + (i - blockStart)] = T(curves[c]->m_Coefficients[i] * scale);
+    }
 }
 
-RgbCoefficients SampledSpectrum::XyzToRgb(const XyzCoefficients& xyz)
+namespace
 {
-    RgbCoefficients rgb;
-    rgb[0] = 3.240479 * xyz[0] - 1.537150 * xyz[1] - 0.498535 * xyz[2];
-    rgb[1] =-0.969256 * xyz[0] + 1.875991 * xyz[1] + 0.041556 * xyz[2];
-    rgb[2] = 0.055648 * xyz[0] - 0.204043 * xyz[1] + 1.057311 * xyz[2];
-    return rgb;
+    // The matching functions are also needed to build cieXyz, and only constexpr
+    // variables can be read while constant-initializing another one
+    template <typename T, int N>
+    constexpr BasicSampledSpectrum<T, N> cieCurveX = BasicSampledSpectrum<T, N>::FromSortedRawSamples(cieLambda, cieSamplesX, numCieSamples);
+    template <typename T, int N>
+    constexpr BasicSampledSpectrum<T, N> cieCurveY = BasicSampledSpectrum<T, N>::FromSortedRawSamples(cieLambda, cieSamplesY, numCieSamples);
+    template <typename T, int N>
+    constexpr BasicSampledSpectrum<T, N> cieCurveZ = BasicSampledSpectrum<T, N>::FromSortedRawSamples(cieLambda, cieSamplesZ, numCieSamples);
 }
 
-XyzCoefficients SampledSpectrum::RgbToXyz(const RgbCoefficients& rgb)
+// All basis tables are resampled at compile time and placed in read-only data,
+// so there is no work (or initialization order to worry about) at startup
+template <typename T, int N>
+constinit const BasicSampledSpectrum<T, N> BasicSampledSpectrum<T, N>::cieX = cieCurveX<T, N>;
+template <typename T, int N>
+constinit const BasicSampledSpectrum<T, N> BasicSampledSpectrum<T, N>::cieY = cieCurveY<T, N>;
+template <typename T, int N>
+constinit const BasicSampledSpectrum<T, N> BasicSampledSpectrum<T, N>::cieZ = cieCurveZ<T, N>;
+template <typename T, int N>
+constinit const typename BasicSampledSpectrum<T, N>::CieXyzTable BasicSampledSpectrum<T, N>::cieXyz(cieCurveX<T, N>, cieCurveY<T, N>, cieCurveZ<T, N>, GetXyzNormalizationConstant());
+
+template <typename T, int N>
+constinit const BasicSampledSpectrum<T, N> BasicSampledSpectrum<T, N>::stdReflW = FromSortedRawSamples(stdLambda, stdReflSamplesW, numStdSamples);
+template <typename T, int N>
+constinit const BasicSampledSpectrum<T, N> BasicSampledSpectrum<T, N>::stdReflC = FromSortedRawSamples(stdLambda, stdReflSamplesC, numStdSamples);
+template <typename T, int N>
+constinit const BasicSampledSpectrum<T, N> BasicSampledSpectrum<T, N>::stdReflM = FromSortedRawSamples(stdLambda, stdReflSamplesM, numStdSamples);
+template <typename T, int N>
+constinit const BasicSampledSpectrum<T, N> BasicSampledSpectrum<T, N>::stdReflY = FromSortedRawSamples(stdLambda, stdReflSamplesY, numStdSamples);
+template <typename T, int N>
+constinit const BasicSampledSpectrum<T, N> BasicSampledSpectrum<T, N>::stdReflR = FromSortedRawSamples(stdLambda, stdReflSamplesR, numStdSamples);
+template <typename T, int N>
+constinit const BasicSampledSpectrum<T, N> BasicSampledSpectrum<T, N>::stdReflG = FromSortedRawSamples(stdLambda, stdReflSamplesG, numStdSamples);
+template <typename T, int N>
+constinit const BasicSampledSpectrum<T, N> BasicSampledSpectrum<T, N>::stdReflB = FromSortedRawSamples(stdLambda, stdReflSamplesB, numStdSamples);
+
+template <typename T, int N>
+constinit const BasicSampledSpectrum<T, N> BasicSampledSpectrum<T, N>::stdIllumW = FromSortedRawSamples(stdLambda, stdIllumSamplesW, numStdSamples);
+template <typename T, int N>
+constinit const BasicSampledSpectrum<T, N> BasicSampledSpectrum<T, N>::stdIllumC = FromSortedRawSamples(stdLambda, stdIllumSamplesC, numStdSamples);
+template <typename T, int N>
+constinit const BasicSampledSpectrum<T, N> BasicSampledSpectrum<T, N>::stdIllumM = FromSortedRawSamples(stdLambda, stdIllumSamplesM, numStdSamples);
+template <typename T, int N>
+constinit const BasicSampledSpectrum<T, N> BasicSampledSpectrum<T, N>::stdIllumY = FromSortedRawSamples(stdLambda, stdIllumSamplesY, numStdSamples);
+template <typename T, int N>
+constinit const BasicSampledSpectrum<T, N> BasicSampledSpectrum<T, N>::stdIllumR = FromSortedRawSamples(stdLambda, stdIllumSamplesR, numStdSamples);
+template <typename T, int N>
+constinit const BasicSampledSpectrum<T, N> BasicSampledSpectrum<T, N>::stdIllumG = FromSortedRawSamples(stdLambda, stdIllumSamplesG, numStdSamples);
+template <typename T, int N>
+constinit const BasicSampledSpectrum<T, N> BasicSampledSpectrum<T, N>::stdIllumB = FromSortedRawSamples(stdLambda, stdIllumSamplesB, numStdSamples);
+
+template <typename T, int N>
+BasicSampledSpectrum<T, N>::BasicSampledSpectrum(const std::vector<SpectralSample>& samples)
 {
-    XyzCoefficients xyz;
-    xyz[0] = 0.412453 * rgb[0] + 0.357580 * rgb[1] + 0.180423 * rgb[2];
-    xyz[1] = 0.212671 * rgb[0] + 0.715160 * rgb[1] + 0.072169 * rgb[2];
-    xyz[2] = 0.019334 * rgb[0] + 0.119193 * rgb[1] + 0.950227 * rgb[2];
-    return xyz;
+    if (IsSamplesSorted(samples))
+        *this = FromSortedSamples(samples.data(), (int)samples.size());
 }
 
-XyzCoefficients SampledSpectrum::ToXyz() const
+template <typename T, int N>
+BasicSpectralCoefficients<T> BasicSampledSpectrum<T, N>::XyzToRgb(const XyzCoefficients& xyz)
 {
-    XyzCoefficients result;
-    for (int i = 0; i < NumSpectralSamples; ++i)
-    {
-        result[0] += cieX.m_Coefficients[i] * m_Coefficients[i];
-        result[1] += cieY.m_Coefficients[i] * m_Coefficients[i];
-        result[2] += cieZ.m_Coefficients[i] * m_Coefficients[i];
-    }
-
-    return result * GetXyzNormalizationConstant();
+    RgbCoefficients rgb;
+    rgb[0] = T(3.240479 * xyz[0] - 1.537150 * xyz[1] - 0.498535 * xyz[2]);
+    rgb[1] = T(-0.969256 * xyz[0] + 1.875991 * xyz[1] + 0.041556 * xyz[2]);
+    rgb[2] = T(0.055648 * xyz[0] - 0.204043 * xyz[1] + 1.057311 * xyz[2]);
+    return rgb;
 }
 
-RgbCoefficients SampledSpectrum::ToRgb() const
+template <typename T, int N>
+BasicSpectralCoefficients<T> BasicSampledSpectrum<T, N>::RgbToXyz(const RgbCoefficients& rgb)
 {
-    XyzCoefficients xyz = ToXyz();
-    return XyzToRgb(xyz);
+    XyzCoefficients xyz;
+    xyz[0] = T(0.412453 * rgb[0] + 0.357580 * rgb[1] + 0.180423 * rgb[2]);
+    xyz[1] = T(0.212671 * rgb[0] + 0.715160 * rgb[1] + 0.072169 * rgb[2]);
+    xyz[2] = T(0.019334 * rgb[0] + 0.119193 * rgb[1] + 0.950227 * rgb[2]);
+    return xyz;
 }
 
-bool SampledSpectrum::IsSamplesSorted(const SampleArray& samples) const
+template <typename T, int N>
+void BasicSampledSpectrum<T, N>::ToXyz(std::span<const BasicSampledSpectrum> spectra, std::span<XyzCoefficients> xyz)
 {
-    if (samples.size() <= 1)
-        return true;
-
-    for (int i = 0; i + 1 < samples.size(); ++i)
-        if (samples[i].m_Wavelength > samples[i + 1].m_Wavelength)
-            return false;
-            
-    return true;
-}
+    if (spectra.size() != xyz.size())
+        throw std::invalid_argument("Number of spectra and xyz outputs must match");
 
-bool SampledSpectrum::IsInputOutsideLeftBoundary(const SampleArray& samples, double leftBound) const
-{
-    return samples.back().m_Wavelength <= leftBound;
-}
+    size_t i = 0;
+    for (; i + XyzBatchSize <= spectra.size(); i += XyzBatchSize)
+        XyzKernels<T, N>::template ConvertToXyz<XyzBatchSize>(&spectra[i], cieXyz.m_Data, &xyz[i]);
 
-bool SampledSpectrum::IsInputOutsideRightBoundary(const SampleArray& samples, double rightBound) const
-{
-    return samples.front().m_Wavelength >= rightBound;
+    for (; i < spectra.size(); ++i)
+        XyzKernels<T, N>::template ConvertToXyz<1>(&spectra[i], cieXyz.m_Data, &xyz[i]);
 }
 
-void SampledSpectrum::ComputeRangeAtIndex(int index, double& start, double& end) const
+template <typename T, int N>
+BasicSpectralCoefficients<T> BasicSampledSpectrum<T, N>::ToXyz() const
 {
-    double binWidth = (MaxWavelength - MinWavelength) / double(NumSpectralSamples - 1);
-    double halfBinWidth = binWidth / 2.0;
-    start = MinWavelength + (index * binWidth) - halfBinWidth;
-    end = MinWavelength + (index * binWidth) + halfBinWidth;
+    XyzCoefficients result;
+    XyzKernels<T, N>::template ConvertToXyz<1>(this, cieXyz.m_Data, &result);
+    return result;
 }
 
-double SampledSpectrum::ComputeBoundaryArea(const SampleArray& samples, double leftBound, double rightBound) const
+template <typename T, int N>
+BasicSpectralCoefficients<T> BasicSampledSpectrum<T, N>::ToRgb() const
 {
-    double leftBoundaryRange = std::max<double>(0.0, samples.front().m_Wavelength - leftBound);
-    double rightBoundRange = std::max<double>(0.0, rightBound - samples.back().m_Wavelength);
-    double leftBoundArea = samples.front().m_Power * leftBoundaryRange;
-    double rightBoundArea = samples.back().m_Power * rightBoundRange;
-
-    return leftBoundArea + rightBoundArea;
+    XyzCoefficients xyz = ToXyz();
+    return XyzToRgb(xyz);
 }
 
-double SampledSpectrum::ComputeSegmentArea(const SpectralSample& s1, const SpectralSample& s2, double leftBound, double rightBound) const
+template <typename T, int N>
+double BasicSampledSpectrum<T, N>::Evaluate(double lambda) const
 {
-    double sampleRangeL = s1.m_Wavelength;
-    double sampleRangeR = s2.m_Wavelength;
+    // Coefficients are the averages of bins centered on evenly spaced
+    // wavelengths, so interpolate linearly between neighbouring bin centers
+    double binWidth = WavelengthRange / double(N - 1);
+    double offset = (lambda - MinWavelength) / binWidth;
 
-    if (sampleRangeL < leftBound)
-        sampleRangeL = leftBound;
+    if (offset <= 0)
+        return m_Coefficients[0];
 
-    if (sampleRangeR > rightBound)
-        sampleRangeR = rightBound;
+    if (offset >= N - 1)
+        return m_Coefficients[N - 1];
 
-    double unclampedRange = s2.m_Wavelength - s1.m_Wavelength;
-    double clampedRange = sampleRangeR - sampleRangeL;
-
-    double lerpFactorL = (sampleRangeL - s1.m_Wavelength) / unclampedRange;
-    double lerpFactorR = (sampleRangeR - s1.m_Wavelength) / unclampedRange;
-
-    double powerL = std::lerp(s1.m_Power, s2.m_Power, lerpFactorL);
-    double powerR = std::lerp(s1.m_Power, s2.m_Power, lerpFactorR);
-    return ((powerL + powerR) / 2) * clampedRange;
+    int index = (int)offset;
+    return std::lerp(double(m_Coefficients[index]), double(m_Coefficients[index + 1]), offset - index);
 }
 
-double SampledSpectrum::ComputeAreaSum(const SampleArray& samples, double leftBound, double rightBound) const
+template <typename T, int N>
+SpectralPacket BasicSampledSpectrum<T, N>::Evaluate(const SampledWavelengths& wavelengths) const
 {
-    double sum = 0;
-    int i = 0;
-    while (samples[i + 1].m_Wavelength < leftBound) ++i;
-
-    for (; i + 1 < samples.size(); ++i)
-    {
-        if (samples[i].m_Wavelength > rightBound)
-            break;
-
-        sum += ComputeSegmentArea(samples[i], samples[i + 1], leftBound, rightBound);
-    }
+    SpectralPacket result;
+    for (int i = 0; i < NumHeroWavelengths; ++i)
+        result[i] = Evaluate(wavelengths[i]);
 
-    sum += ComputeBoundaryArea(samples, leftBound, rightBound);
-    return sum;
+    return result;
 }
 
-double SampledSpectrum::ComputeAverageInRange(const SampleArray& samples, double leftBound, double rightBound) const
+template <typename T, int N>
+bool BasicSampledSpectrum<T, N>::IsSamplesSorted(const SampleArray& samples) const
 {
-    if (samples.size() == 1)
-        return samples.front().m_Power;
-
-    if (IsInputOutsideRightBoundary(samples, rightBound))
-        return samples.front().m_Power;
-
-    if (IsInputOutsideLeftBoundary(samples, leftBound))
-        return samples.back().m_Power;
+    if (samples.size() <= 1)
+        return true;
 
-    double sum = ComputeAreaSum(samples, leftBound, rightBound);
-    double range = rightBound - leftBound;
-    return sum / range;
+    for (int i = 0; i + 1 < samples.size(); ++i)
+        if (samples[i].m_Wavelength > samples[i + 1].m_Wavelength)
+            return false;
+            
+    return true;
 }
 
-double SampledSpectrum::GetXyzNormalizationConstant() const
+template <typename T, int N>
+void BasicSampledSpectrum<T, N>::ComputeRangeAtIndex(int index, double& start, double& end) const
 {
-    double scale = (MaxWavelength - MinWavelength + 1) / double(NumSpectralSamples);
-    return scale / cieIntegralY;
+    double binWidth = (MaxWavelength - MinWavelength) / double(N - 1);
+    double halfBinWidth = binWidth / 2.0;
+    start = MinWavelength + (index * binWidth) - halfBinWidth;
+    end = MinWavelength + (index * binWidth) + halfBinWidth;
 }
 
+template class BasicSampledSpectrum<float, 16>;
+template class BasicSampledSpectrum<float, 32>;
+template class BasicSampledSpectrum<float, 60>;
+template class BasicSampledSpectrum<float, 128>;
+template class BasicSampledSpectrum<double, 16>;
+template class BasicSampledSpectrum<double, 32>;
+template class BasicSampledSpectrum<double, 60>;
+template class BasicSampledSpectrum<double, 128>;
@@ -22,56 +22,172 @@
 
 #include "spectrum.h"
 #include "spectralsample.h"
+#include "spectralconstants.h"
+#include "spectralpacket.h"
 
 const int MinWavelength = 360;
 const int MaxWavelength = 830;
 const int WavelengthRange = MaxWavelength - MinWavelength;
 
-class SampledSpectrum : public Spectrum
+template <typename T, int N>
+class BasicSampledSpectrum : public BasicSpectrum<T, N>
 {
 public:
-    SampledSpectrum(double v = 0.0) : Spectrum(v) {}
-    SampledSpectrum(const SampleArray& samples);
-    SampledSpectrum(Spectrum& v) : Spectrum(v) {}
-    ~SampledSpectrum() = default;
+    using RgbCoefficients = BasicSpectralCoefficients<T>;
+    using XyzCoefficients = BasicSpectralCoefficients<T>;
+    using BasicSpectrum<T, N>::m_Coefficients;
 
 public:
-    static SampledSpectrum FromSortedRawSamples(const double* lambda, const double* power, int numSamples);
+    constexpr BasicSampledSpectrum(T v = 0.0) : BasicSpectrum<T, N>(v) {}
+    BasicSampledSpectrum(const SampleArray& samples);
+    template <typename E>
+    BasicSampledSpectrum(const SpectrumExpression<E>& e) : BasicSpectrum<T, N>(e) {}
+    ~BasicSampledSpectrum() = default;
+
+public:
+    static constexpr BasicSampledSpectrum FromSortedRawSamples(const double* lambda, const double* power, int numSamples);
+    static constexpr BasicSampledSpectrum FromSortedSamples(const SpectralSample* samples, int numSamples);
     static RgbCoefficients XyzToRgb(const XyzCoefficients& xyz);
     static XyzCoefficients RgbToXyz(const RgbCoefficients& rgb);
+    static void ToXyz(std::span<const BasicSampledSpectrum> spectra, std::span<XyzCoefficients> xyz);
 
 public:
     XyzCoefficients ToXyz() const;
     RgbCoefficients ToRgb() const;
 
+    double Evaluate(double lambda) const;
+    SpectralPacket Evaluate(const SampledWavelengths& wavelengths) const;
+
 protected:
     bool IsSamplesSorted(const SampleArray& samples) const;
-    bool IsInputOutsideLeftBoundary(const SampleArray& samples, double leftBound) const;
-    bool IsInputOutsideRightBoundary(const SampleArray& samples, double rightBound) const;
-
     void ComputeRangeAtIndex(int index, double& start, double& end) const;
-    double ComputeBoundaryArea(const SampleArray& samples, double leftBound, double rightBound) const;
-    double ComputeSegmentArea(const SpectralSample& s1, const SpectralSample& s2, double leftBound, double rightBound) const;
-    double ComputeAreaSum(const SampleArray& samples, double leftBound, double rightBound) const;
-    double ComputeAverageInRange(const SampleArray& samples, double leftBound, double rightBound) const;
 
-    virtual double GetXyzNormalizationConstant() const;
+    static constexpr double GetXyzNormalizationConstant();
+    static constexpr double ComputeRawSegmentArea(double lambda1, double power1, double lambda2, double power2, double leftBound, double rightBound);
+
+    template <typename LambdaAt, typename PowerAt>
+    static constexpr BasicSampledSpectrum ResampleSorted(int numSamples, LambdaAt lambda, PowerAt power);
+
+protected:
+    // CIE matching functions premultiplied by the XYZ normalization constant and
+    // interleaved per SIMD block as [X0..Xw, Y0..Yw, Z0..Zw], so that ToXyz reads
+    // one contiguous stream
+    struct CieXyzTable
+    {
+        constexpr CieXyzTable(const BasicSampledSpectrum& x, const BasicSampledSpectrum& y, const BasicSampledSpectrum& z, double scale);
+        alignas(Simd::Alignment) T m_Data[3 * N];
+    };
 
 protected:
     friend class SampledSpectrumTest_CanComputeWavelengthRange_Test;
-    friend class SampledSpectrumTest_CanComputeAreaSum_Test;
-    friend class SampledSpectrumTest_CanComputeAverageSamples_Test;
     friend class SampledSpectrumTest_CanPopulateStandardCurves_Test;
+    friend class SampledSpectrumTest_FusedXyzMatchesReferenceIntegration_Test;
+    friend class SampledSpectrumTest_CompileTimeCurvesMatchRuntimeResampling_Test;
+    friend class SampledSpectrumTest_SinglePassResamplingMatchesPerBinAverage_Test;
+    friend class SampledSpectrumTest_FloatTablesMatchDouble_Test;
+
+    static const BasicSampledSpectrum cieX;
+    static const BasicSampledSpectrum cieY;
+    static const BasicSampledSpectrum cieZ;
+    static const CieXyzTable cieXyz;
+
+    static const BasicSampledSpectrum stdReflW, stdIllumW;
+    static const BasicSampledSpectrum stdReflC, stdIllumC;
+    static const BasicSampledSpectrum stdReflM, stdIllumM;
+    static const BasicSampledSpectrum stdReflY, stdIllumY;
+    static const BasicSampledSpectrum stdReflR, stdIllumR;
+    static const BasicSampledSpectrum stdReflG, stdIllumG;
+    static const BasicSampledSpectrum stdReflB, stdIllumB;
+};
+
+template <typename T, int N>
+constexpr double BasicSampledSpectrum<T, N>::ComputeRawSegmentArea(double lambda1, double power1, double lambda2, double power2, double leftBound, double rightBound)
+{
+    double rangeL = std::max(lambda1, leftBound);
+    double rangeR = std::min(lambda2, rightBound);
+    double unclampedRange = lambda2 - lambda1;
+
+    double powerL = std::lerp(power1, power2, (rangeL - lambda1) / unclampedRange);
+    double powerR = std::lerp(power1, power2, (rangeR - lambda1) / unclampedRange);
+    return ((powerL + powerR) / 2) * (rangeR - rangeL);
+}
+
+template <typename T, int N>
+template <typename LambdaAt, typename PowerAt>
+constexpr BasicSampledSpectrum<T, N> BasicSampledSpectrum<T, N>::ResampleSorted(int numSamples, LambdaAt lambda, PowerAt power)
+{
+    BasicSampledSpectrum result;
+    if (numSamples <= 0)
+        return result;
+
+    double binWidth = (MaxWavelength - MinWavelength) / double(N - 1);
+    double halfBinWidth = binWidth / 2.0;
+    double firstLambda = lambda(0);
+    double lastLambda = lambda(numSamples - 1);
+
+    // Both the input and the bins are sorted, so the first segment overlapping a
+    // bin never moves backwards and every sample is visited a bounded number of
+    // times instead of once per bin
+    int first = 0;
+    for (int bin = 0; bin < N; ++bin)
+    {
+        double leftBound = MinWavelength + (bin * binWidth) - halfBinWidth;
+        double rightBound = MinWavelength + (bin * binWidth) + halfBinWidth;
+
+        if (numSamples == 1 || firstLambda >= rightBound)
+        {
+            result.m_Coefficients[bin] = T(power(0));
+            continue;
+        }
+
+        if (lastLambda <= leftBound)
+        {
+            result.m_Coefficients[bin] = T(power(numSamples - 1));
+            continue;
+        }
+
+        while (lambda(first + 1) < leftBound) ++first;
+
+        double sum = 0;
+        for (int i = first; i + 1 < numSamples && lambda(i) <= rightBound; ++i)
+            sum += ComputeRawSegmentArea(lambda(i), power(i), lambda(i + 1), power(i + 1), leftBound, rightBound);
+
+        sum += power(0) * std::max(0.0, firstLambda - leftBound);
+        sum += power(numSamples - 1) * std::max(0.0, rightBound - lastLambda);
+        result.m_Coefficients[bin] = T(sum / (rightBound - leftBound));
+    }
+
+    return result;
+}
+
+template <typename T, int N>
+constexpr BasicSampledSpectrum<T, N> BasicSampledSpectrum<T, N>::FromSortedRawSamples(const double* lambda, const double* power, int numSamples)
+{
+    return ResampleSorted(numSamples, [lambda](int i) { return lambda[i]; }, [power](int i) { return power[i]; });
+}
 
-    static const SampledSpectrum cieX;
-    static const SampledSpectrum cieY;
-    static const SampledSpectrum cieZ;
-
-    static const SampledSpectrum stdReflW, stdIllumW;
-    static const SampledSpectrum stdReflC, stdIllumC;
-    static const SampledSpectrum stdReflM, stdIllumM;
-    static const SampledSpectrum stdReflY, stdIllumY;
-    static const SampledSpectrum stdReflR, stdIllumR;
-    static const SampledSpectrum stdReflG, stdIllumG;
-    static const SampledSpectrum stdReflB, stdIllumB;
-};
\ No newline at end of file
+template <typename T, int N>
+constexpr BasicSampledSpectrum<T, N> BasicSampledSpectrum<T, N>::FromSortedSamples(const SpectralSample* samples, int numSamples)
+{
+    return ResampleSorted(numSamples, [samples](int i) { return samples[i].m_Wavelength; }, [samples](int i) { return samples[i].m_Power; });
+}
+
+template <typename T, int N>
+constexpr double BasicSampledSpectrum<T, N>::GetXyzNormalizationConstant()
+{
+    double scale = (MaxWavelength - MinWavelength + 1) / double(N);
+    return scale / cieIntegralY;
+}
+
+// Defined and explicitly instantiated in sampledspectrum.cpp, which keeps the
+// basis tables out of every other translation unit
+extern template class BasicSampledSpectrum<float, 16>;
+extern template class BasicSampledSpectrum<float, 32>;
+extern template class BasicSampledSpectrum<float, 60>;
+extern template class BasicSampledSpectrum<float, 128>;
+extern template class BasicSampledSpectrum<double, 16>;
+extern template class BasicSampledSpectrum<double, 32>;
+extern template class BasicSampledSpectrum<double, 60>;
+extern template class BasicSampledSpectrum<double, 128>;
+
+typedef BasicSampledSpectrum<SpectralReal, NumSpectralSamples> SampledSpectrum;
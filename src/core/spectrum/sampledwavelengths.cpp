@@ -0,0 +1,61 @@
+/*
+    This file is part of Spectre, an open-source physically based
+    spectral raytracing library.
+
+    Copyright (c) 2020-2023 Samuel Van Allen - All rights reserved.
+
+    Spectre is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "sampledwavelengths.h"
+#include "sampledspectrum.h"
+
+SampledWavelengths SampledWavelengths::SampleUniform(double u)
+{
+    SampledWavelengths wavelengths;
+    wavelengths.m_Lambda[0] = std::lerp(double(MinWavelength), double(MaxWavelength), u);
+
+    double delta = WavelengthRange / double(NumHeroWavelengths);
+    for (int i = 1; i < NumHeroWavelengths; ++i)
+    {
+        wavelengths.m_Lambda[i] = wavelengths.m_Lambda[i - 1] + delta;
+        if (wavelengths.m_Lambda[i] > MaxWavelength)
+            wavelengths.m_Lambda[i] = MinWavelength + (wavelengths.m_Lambda[i] - MaxWavelength);
+    }
+
+    std::fill(std::begin(wavelengths.m_Pdf), std::end(wavelengths.m_Pdf), 1.0 / WavelengthRange);
+    return wavelengths;
+}
+
+bool SampledWavelengths::IsSecondaryTerminated() const
+{
+    for (int i = 1; i < NumHeroWavelengths; ++i)
+        if (m_Pdf[i] != 0)
+            return false;
+
+    return true;
+}
+
+void SampledWavelengths::TerminateSecondary()
+{
+    if (IsSecondaryTerminated())
+        return;
+
+    // Wavelength-dependent events (e.g. dispersion) collapse the path to the
+    // hero wavelength, which then carries the whole estimate
+    for (int i = 1; i < NumHeroWavelengths; ++i)
+        m_Pdf[i] = 0;
+
+    m_Pdf[0] /= NumHeroWavelengths;
+}
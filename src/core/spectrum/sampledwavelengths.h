@@ -0,0 +1,48 @@
+/*
+    This file is part of Spectre, an open-source physically based
+    spectral raytracing library.
+
+    Copyright (c) 2020-2023 Samuel Van Allen - All rights reserved.
+
+    Spectre is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+const int NumHeroWavelengths = 4;
+
+// A stratified set of wavelengths carried along a single light path. The first
+// (hero) wavelength is sampled uniformly and the rest are spaced evenly across
+// the visible range, wrapping around at MaxWavelength.
+class SampledWavelengths
+{
+public:
+    SampledWavelengths() = default;
+    ~SampledWavelengths() = default;
+
+public:
+    inline double operator[](int i) const { return m_Lambda[i]; }
+    inline double GetPdf(int i) const { return m_Pdf[i]; }
+
+public:
+    static SampledWavelengths SampleUniform(double u);
+
+public:
+    bool IsSecondaryTerminated() const;
+    void TerminateSecondary();
+
+private:
+    alignas(Simd::Alignment) double m_Lambda[NumHeroWavelengths];
+    alignas(Simd::Alignment) double m_Pdf[NumHeroWavelengths];
+};
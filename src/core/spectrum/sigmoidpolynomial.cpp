@@ -0,0 +1,48 @@
+/*
+    This file is part of Spectre, an open-source physically based
+    spectral raytracing library.
+
+    Copyright (c) 2020-2023 Samuel Van Allen - All rights reserved.
+
+    Spectre is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "sigmoidpolynomial.h"
+
+SigmoidPolynomial::SigmoidPolynomial(double c0, double c1, double c2)
+{
+    m_Coefficients[0] = c0;
+    m_Coefficients[1] = c1;
+    m_Coefficients[2] = c2;
+}
+
+double SigmoidPolynomial::Evaluate(double lambda) const
+{
+    double x = (m_Coefficients[0] * lambda + m_Coefficients[1]) * lambda + m_Coefficients[2];
+
+    // Pure black and white greys are stored as infinite offsets
+    if (std::isinf(x))
+        return x > 0 ? 1.0 : 0.0;
+
+    return 0.5 + x / (2.0 * std::sqrt(1.0 + x * x));
+}
+
+SpectralPacket SigmoidPolynomial::Evaluate(const SampledWavelengths& wavelengths) const
+{
+    SpectralPacket result;
+    for (int i = 0; i < NumHeroWavelengths; ++i)
+        result[i] = Evaluate(wavelengths[i]);
+
+    return result;
+}
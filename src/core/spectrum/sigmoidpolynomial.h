@@ -0,0 +1,40 @@
+/*
+    This file is part of Spectre, an open-source physically based
+    spectral raytracing library.
+
+    Copyright (c) 2020-2023 Samuel Van Allen - All rights reserved.
+
+    Spectre is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "spectralpacket.h"
+
+// Smooth, bounded spectrum of the form sigmoid(c0 * lambda^2 + c1 * lambda + c2)
+// as used by the Jakob & Hanika RGB uplift. Always in [0, 1], so it is a
+// valid reflectance at every wavelength.
+class SigmoidPolynomial
+{
+public:
+    SigmoidPolynomial(double c0 = 0.0, double c1 = 0.0, double c2 = 0.0);
+    ~SigmoidPolynomial() = default;
+
+public:
+    double Evaluate(double lambda) const;
+    SpectralPacket Evaluate(const SampledWavelengths& wavelengths) const;
+
+public:
+    double m_Coefficients[3];
+};
@@ -20,39 +20,51 @@
 
 #pragma once
 
-struct SpectralCoefficients
+// Scalar type used for stored spectral data. Single precision halves the
+// memory footprint of spectra and film pixels and doubles the SIMD lane count,
+// double precision is kept for reference renders.
+#ifdef SPC_USE_FLOAT_SPECTRUM
+typedef float SpectralReal;
+#else
+typedef double SpectralReal;
+#endif
+
+template <typename T>
+struct BasicSpectralCoefficients
 {
-    SpectralCoefficients(double v = 0)
+    static_assert(std::is_floating_point_v<T>, "Spectral coefficients must be floating point");
+
+    BasicSpectralCoefficients(T v = 0)
     {
         m_Data[0] = v;
         m_Data[1] = v;
         m_Data[2] = v;
     }
 
-    SpectralCoefficients(double r, double g, double b) {
+    BasicSpectralCoefficients(T r, T g, T b) {
         m_Data[0] = r;
         m_Data[1] = g;
         m_Data[2] = b;
     }
 
-    inline double operator[](int i) const { return m_Data[i]; }
-    inline double& operator[](int i) { return m_Data[i]; }
+    inline T operator[](int i) const { return m_Data[i]; }
+    inline T& operator[](int i) { return m_Data[i]; }
 
-    inline SpectralCoefficients operator+(const SpectralCoefficients& v) const { return { m_Data[0] + v[0], m_Data[1] + v[1], m_Data[2] + v[2] }; }
-    inline SpectralCoefficients operator-(const SpectralCoefficients& v) const { return { m_Data[0] - v[0], m_Data[1] - v[1], m_Data[2] - v[2] }; }
-    inline SpectralCoefficients operator*(const SpectralCoefficients& v) const { return { m_Data[0] * v[0], m_Data[1] * v[1], m_Data[2] * v[2] }; }
-    inline SpectralCoefficients operator/(const SpectralCoefficients& v) const { return { m_Data[0] / v[0], m_Data[1] / v[1], m_Data[2] / v[2] }; }
-    inline SpectralCoefficients operator^(const SpectralCoefficients& p) const { return { std::pow(m_Data[0], p[0]), std::pow(m_Data[1], p[1]), std::pow(m_Data[2], p[2]) }; }
+    inline BasicSpectralCoefficients operator+(const BasicSpectralCoefficients& v) const { return { m_Data[0] + v[0], m_Data[1] + v[1], m_Data[2] + v[2] }; }
+    inline BasicSpectralCoefficients operator-(const BasicSpectralCoefficients& v) const { return { m_Data[0] - v[0], m_Data[1] - v[1], m_Data[2] - v[2] }; }
+    inline BasicSpectralCoefficients operator*(const BasicSpectralCoefficients& v) const { return { m_Data[0] * v[0], m_Data[1] * v[1], m_Data[2] * v[2] }; }
+    inline BasicSpectralCoefficients operator/(const BasicSpectralCoefficients& v) const { return { m_Data[0] / v[0], m_Data[1] / v[1], m_Data[2] / v[2] }; }
+    inline BasicSpectralCoefficients operator^(const BasicSpectralCoefficients& p) const { return { std::pow(m_Data[0], p[0]), std::pow(m_Data[1], p[1]), std::pow(m_Data[2], p[2]) }; }
 
-    inline void operator+=(const SpectralCoefficients& v) { m_Data[0] += v.m_Data[0]; m_Data[1] += v.m_Data[1]; m_Data[2] += v.m_Data[2]; }
-    inline void operator-=(const SpectralCoefficients& v) { m_Data[0] -= v.m_Data[0]; m_Data[1] -= v.m_Data[1]; m_Data[2] -= v.m_Data[2]; }
-    inline void operator*=(const SpectralCoefficients& v) { m_Data[0] *= v.m_Data[0]; m_Data[1] *= v.m_Data[1]; m_Data[2] *= v.m_Data[2]; }
-    inline void operator/=(const SpectralCoefficients& v) { m_Data[0] /= v.m_Data[0]; m_Data[1] /= v.m_Data[1]; m_Data[2] /= v.m_Data[2]; }
-    inline void operator^=(const SpectralCoefficients& p) { m_Data[0] = std::pow(m_Data[0], p[0]); m_Data[1] = std::pow(m_Data[1], p[1]); m_Data[2] = std::pow(m_Data[2], p[2]); }
+    inline void operator+=(const BasicSpectralCoefficients& v) { m_Data[0] += v.m_Data[0]; m_Data[1] += v.m_Data[1]; m_Data[2] += v.m_Data[2]; }
+    inline void operator-=(const BasicSpectralCoefficients& v) { m_Data[0] -= v.m_Data[0]; m_Data[1] -= v.m_Data[1]; m_Data[2] -= v.m_Data[2]; }
+    inline void operator*=(const BasicSpectralCoefficients& v) { m_Data[0] *= v.m_Data[0]; m_Data[1] *= v.m_Data[1]; m_Data[2] *= v.m_Data[2]; }
+    inline void operator/=(const BasicSpectralCoefficients& v) { m_Data[0] /= v.m_Data[0]; m_Data[1] /= v.m_Data[1]; m_Data[2] /= v.m_Data[2]; }
+    inline void operator^=(const BasicSpectralCoefficients& p) { m_Data[0] = std::pow(m_Data[0], p[0]); m_Data[1] = std::pow(m_Data[1], p[1]); m_Data[2] = std::pow(m_Data[2], p[2]); }
 
-    double m_Data[3];
+    T m_Data[3];
 };
 
+typedef BasicSpectralCoefficients<SpectralReal> SpectralCoefficients;
 typedef SpectralCoefficients RgbCoefficients;
 typedef SpectralCoefficients XyzCoefficients;
-
@@ -0,0 +1,164 @@
+/*
+    This file is part of Spectre, an open-source physically based
+    spectral raytracing library.
+
+    Copyright (c) 2020-2023 Samuel Van Allen - All rights reserved.
+
+    Spectre is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "spectralpacket.h"
+#include "sampledspectrum.h"
+#include "spectralconstants.h"
+
+namespace
+{
+    using Pack = Simd::Pack<double>;
+    using Scalar = Simd::Scalar<double>;
+
+    template <typename Kernel>
+    inline void ApplyBinary(const double* a, const double* b, double* out, Kernel kernel)
+    {
+        int i = 0;
+        for (; i + Pack::Width <= NumHeroWavelengths; i += Pack::Width)
+            kernel(Pack::Load(a + i), Pack::Load(b + i)).Store(out + i);
+
+        for (; i < NumHeroWavelengths; ++i)
+            kernel(Scalar::Load(a + i), Scalar::Load(b + i)).Store(out + i);
+    }
+
+    // The raw CIE tables are tabulated at 1nm increments starting at cieLambda[0]
+    double EvaluateCie(const double* samples, double lambda)
+    {
+        double offset = lambda - cieLambda[0];
+        if (offset <= 0)
+            return samples[0];
+
+        if (offset >= numCieSamples - 1)
+            return samples[numCieSamples - 1];
+
+        int index = (int)offset;
+        return std::lerp(samples[index], samples[index + 1], offset - index);
+    }
+}
+
+SpectralPacket::SpectralPacket(double v)
+{
+    std::fill(std::begin(m_Values), std::end(m_Values), v);
+}
+
+SpectralPacket SpectralPacket::operator+(const SpectralPacket& p) const
+{
+    SpectralPacket result;
+    ApplyBinary(m_Values, p.m_Values, result.m_Values, [](auto a, auto b) { return a + b; });
+    return result;
+}
+
+SpectralPacket SpectralPacket::operator-(const SpectralPacket& p) const
+{
+    SpectralPacket result;
+    ApplyBinary(m_Values, p.m_Values, result.m_Values, [](auto a, auto b) { return a - b; });
+    return result;
+}
+
+SpectralPacket SpectralPacket::operator*(const SpectralPacket& p) const
+{
+    SpectralPacket result;
+    ApplyBinary(m_Values, p.m_Values, result.m_Values, [](auto a, auto b) { return a * b; });
+    return result;
+}
+
+SpectralPacket SpectralPacket::operator/(const SpectralPacket& p) const
+{
+    SpectralPacket result;
+    ApplyBinary(m_Values, p.m_Values, result.m_Values, [](auto a, auto b) { return a / b; });
+    return result;
+}
+
+SpectralPacket& SpectralPacket::operator+=(const SpectralPacket& p)
+{
+    ApplyBinary(m_Values, p.m_Values, m_Values, [](auto a, auto b) { return a + b; });
+    return *this;
+}
+
+SpectralPacket& SpectralPacket::operator-=(const SpectralPacket& p)
+{
+    ApplyBinary(m_Values, p.m_Values, m_Values, [](auto a, auto b) { return a - b; });
+    return *this;
+}
+
+SpectralPacket& SpectralPacket::operator*=(const SpectralPacket& p)
+{
+    ApplyBinary(m_Values, p.m_Values, m_Values, [](auto a, auto b) { return a * b; });
+    return *this;
+}
+
+SpectralPacket& SpectralPacket::operator/=(const SpectralPacket& p)
+{
+    ApplyBinary(m_Values, p.m_Values, m_Values, [](auto a, auto b) { return a / b; });
+    return *this;
+}
+
+bool SpectralPacket::operator==(const SpectralPacket& p) const
+{
+    for (int i = 0; i < NumHeroWavelengths; ++i)
+        if (m_Values[i] != p.m_Values[i])
+            return false;
+
+    return true;
+}
+
+bool SpectralPacket::operator!=(const SpectralPacket& p) const
+{
+    return !(*this == p);
+}
+
+bool SpectralPacket::IsBlack() const
+{
+    for (int i = 0; i < NumHeroWavelengths; ++i)
+        if (m_Values[i] != 0.0)
+            return false;
+
+    return true;
+}
+
+double SpectralPacket::Average() const
+{
+    double sum = 0;
+    for (int i = 0; i < NumHeroWavelengths; ++i)
+        sum += m_Values[i];
+
+    return sum / NumHeroWavelengths;
+}
+
+XyzCoefficients SpectralPacket::ToXyz(const SampledWavelengths& wavelengths) const
+{
+    // Monte Carlo estimate of the CIE integrals, normalized the same way as
+    // SampledSpectrum::ToXyz so that both paths agree in expectation
+    double xyz[3] = { 0, 0, 0 };
+    for (int i = 0; i < NumHeroWavelengths; ++i)
+    {
+        double pdf = wavelengths.GetPdf(i);
+        if (pdf == 0)
+            continue;
+
+        double weight = m_Values[i] / pdf;
+        xyz[0] += EvaluateCie(cieSamplesX, wavelengths[i]) * weight;
+        xyz[1] += EvaluateCie(cieSamplesY, wavelengths[i]) * weight;
+        xyz[2] += EvaluateCie(cieSamplesZ, wavelengths[i]) * weight;
+    }
+
+    double normalization = NumHeroWavelengths * cieIntegralY;
+    return { SpectralReal(xyz[0] / normalization), SpectralReal(xyz[1] / normalization), SpectralReal(xyz[2] / normalization) };
+}
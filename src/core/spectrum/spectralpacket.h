@@ -0,0 +1,57 @@
+/*
+    This file is part of Spectre, an open-source physically based
+    spectral raytracing library.
+
+    Copyright (c) 2020-2023 Samuel Van Allen - All rights reserved.
+
+    Spectre is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "sampledwavelengths.h"
+
+// Spectral values at the wavelengths of a SampledWavelengths. This is what a
+// light path carries around instead of a full 60 bin Spectrum.
+class SpectralPacket
+{
+public:
+    SpectralPacket(double v = 0.0);
+    ~SpectralPacket() = default;
+
+public:
+    inline double operator[](int i) const { return m_Values[i]; }
+    inline double& operator[](int i) { return m_Values[i]; }
+
+    SpectralPacket operator+(const SpectralPacket& p) const;
+    SpectralPacket operator-(const SpectralPacket& p) const;
+    SpectralPacket operator*(const SpectralPacket& p) const;
+    SpectralPacket operator/(const SpectralPacket& p) const;
+
+    SpectralPacket& operator+=(const SpectralPacket& p);
+    SpectralPacket& operator-=(const SpectralPacket& p);
+    SpectralPacket& operator*=(const SpectralPacket& p);
+    SpectralPacket& operator/=(const SpectralPacket& p);
+
+    bool operator==(const SpectralPacket& p) const;
+    bool operator!=(const SpectralPacket& p) const;
+
+public:
+    bool IsBlack() const;
+    double Average() const;
+    XyzCoefficients ToXyz(const SampledWavelengths& wavelengths) const;
+
+public:
+    alignas(Simd::Alignment) double m_Values[NumHeroWavelengths];
+};
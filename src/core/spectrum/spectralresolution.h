@@ -0,0 +1,67 @@
+/*
+    This file is part of Spectre, an open-source physically based
+    spectral raytracing library.
+
+    Copyright (c) 2020-2023 Samuel Van Allen - All rights reserved.
+
+    Spectre is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "spectrum.h"
+
+// Spectral bin counts that spectra are instantiated for. Fewer bins trade
+// spectral fidelity for proportionally cheaper spectral math and memory, which
+// suits look-dev previews.
+enum class SpectralResolution
+{
+    Preview = 16,
+    Draft = 32,
+    Standard = 60,
+    Reference = 128
+};
+
+static_assert(int(SpectralResolution::Standard) == NumSpectralSamples, "The default bin count should be a supported resolution");
+
+inline int GetNumSpectralSamples(SpectralResolution resolution)
+{
+    return int(resolution);
+}
+
+// Invokes function with a std::integral_constant holding the bin count, so that
+// a render job can select its instantiation at runtime:
+//
+//   DispatchSpectralResolution(resolution, [&](auto bins)
+//   {
+//       using Spectrum = BasicSampledSpectrum<SpectralReal, decltype(bins)::value>;
+//       ...
+//   });
+template <typename Function>
+inline decltype(auto) DispatchSpectralResolution(SpectralResolution resolution, Function&& function)
+{
+    switch (resolution)
+    {
+    case SpectralResolution::Preview:
+        return function(std::integral_constant<int, 16>());
+    case SpectralResolution::Draft:
+        return function(std::integral_constant<int, 32>());
+    case SpectralResolution::Standard:
+        return function(std::integral_constant<int, 60>());
+    case SpectralResolution::Reference:
+        return function(std::integral_constant<int, 128>());
+    }
+
+    throw std::invalid_argument("Unsupported spectral resolution");
+}
@@ -20,176 +20,155 @@
 
 #include "spectrum.h"
 
-Spectrum::Spectrum(double v)
+namespace
 {
-    std::fill(std::begin(m_Coefficients), std::end(m_Coefficients), v);
-}
-
-Spectrum Spectrum::operator+(const Spectrum& c) const
-{
-    Spectrum result;
-
-    for (int i = 0; i < NumSpectralSamples; ++i)
-        result.m_Coefficients[i] = m_Coefficients[i] + c.m_Coefficients[i];
-
-    return result;
-}
-
-Spectrum& Spectrum::operator+=(const Spectrum& c)
-{
-    for (int i = 0; i < NumSpectralSamples; ++i)
-        m_Coefficients[i] += c.m_Coefficients[i];
-
-    return *this;
-}
-
-Spectrum Spectrum::operator-(const Spectrum& c) const
-{
-    Spectrum result;
-
-    for (int i = 0; i < NumSpectralSamples; ++i)
-        result.m_Coefficients[i] = m_Coefficients[i] - c.m_Coefficients[i];
-
-    return result;
-}
-
-Spectrum& Spectrum::operator-=(const Spectrum& c)
-{
-    for (int i = 0; i < NumSpectralSamples; ++i)
-        m_Coefficients[i] -= c.m_Coefficients[i];
-
-    return *this;
-}
-
-Spectrum Spectrum::operator*(const Spectrum& c) const
-{
-    Spectrum result;
-
-    for (int i = 0; i < NumSpectralSamples; ++i)
-        result.m_Coefficients[i] = m_Coefficients[i] * c.m_Coefficients[i];
-
-    return result;
-}
-
-Spectrum& Spectrum::operator*=(const Spectrum& c)
-{
-    for (int i = 0; i < NumSpectralSamples; ++i)
-        m_Coefficients[i] *= c.m_Coefficients[i];
-
-    return *this;
-}
-
-Spectrum Spectrum::operator/(const Spectrum& c) const
-{
-    Spectrum result;
-
-    for (int i = 0; i < NumSpectralSamples; ++i)
-        result.m_Coefficients[i] = m_Coefficients[i] / c.m_Coefficients[i];
-
-    return result;
-}
-
-Spectrum& Spectrum::operator/=(const Spectrum& c)
-{
-    for (int i = 0; i < NumSpectralSamples; ++i)
-        m_Coefficients[i] /= c.m_Coefficients[i];
+    template <typename T, int N>
+    struct Kernels
+    {
+        using Pack = Simd::Pack<T>;
+        using Scalar = Simd::Scalar<T>;
+
+        // Number of coefficients covered by full-width packs. The remainder (if any)
+        // is handled one lane at a time with the same kernel.
+        static const int NumPackedSamples = N - (N % Pack::Width);
+
+        template <typename Kernel>
+        static inline void ApplyUnary(const T* a, T* out, Kernel kernel)
+        {
+            int i = 0;
+            for (; i < NumPackedSamples; i += Pack::Width)
+                kernel(Pack::Load(a + i)).Store(out + i);
+
+            for (; i < N; ++i)
+                kernel(Scalar::Load(a + i)).Store(out + i);
+        }
+
+        template <typename Kernel>
+        static inline void ApplyBinary(const T* a, const T* b, T* out, Kernel kernel)
+        {
+            int i = 0;
+            for (; i < NumPackedSamples; i += Pack::Width)
+                kernel(Pack::Load(a + i), Pack::Load(b + i)).Store(out + i);
+
+            for (; i < N; ++i)
+                kernel(Scalar::Load(a + i), Scalar::Load(b + i)).Store(out + i);
+        }
+
+        template <typename Kernel>
+        static inline void ApplyTernary(const T* a, const T* b, const T* c, T* out, Kernel kernel)
+        {
+            int i = 0;
+            for (; i < NumPackedSamples; i += Pack::Width)
+                kernel(Pack::Load(a + i), Pack::Load(b + i), Pack::Load(c + i)).Store(out + i);
+
+            for (; i < N; ++i)
+                kernel(Scalar::Load(a + i), Scalar::Load(b + i), Scalar::Load(c + i)).Store(out + i);
+        }
+
+        template <typename Predicate>
+        static inline bool AnyOf(const T* a, Predicate predicate)
+        {
+            int i = 0;
+            for (; i < NumPackedSamples; i += Pack::Width)
+                if (predicate(Pack::Load(a + i)))
+                    return true;
+
+            for (; i < N; ++i)
+                if (predicate(Scalar::Load(a + i)))
+                    return true;
 
-    return *this;
+            return false;
+        }
+    };
 }
 
-bool Spectrum::IsBlack() const
+template <typename T, int N>
+bool BasicSpectrum<T, N>::IsBlack() const
 {
-    for (int i = 0; i < NumSpectralSamples; ++i)
-        if (m_Coefficients[i] != 0.0)
-            return false;
-
-    return true;
+    return !Kernels<T, N>::AnyOf(m_Coefficients, [](auto a) { return a.AnyNonZero(); });
 }
 
-bool Spectrum::HasNans() const
+template <typename T, int N>
+bool BasicSpectrum<T, N>::HasNans() const
 {
-    for (int i = 0; i < NumSpectralSamples; ++i)
-        if (std::isnan(m_Coefficients[i]))
-            return true;
-
-    return false;
+    return Kernels<T, N>::AnyOf(m_Coefficients, [](auto a) { return a.AnyNan(); });
 }
 
-bool Spectrum::IsEqual(const Spectrum& other) const
+template <typename T, int N>
+bool BasicSpectrum<T, N>::IsEqual(const BasicSpectrum& other) const
 {
-    for (int i = 0; i < NumSpectralSamples; ++i)
+    for (int i = 0; i < N; ++i)
         if (m_Coefficients[i] != other.m_Coefficients[i])
             return false;
 
     return true;
 }
 
-void Spectrum::ClampZero()
+template <typename T, int N>
+void BasicSpectrum<T, N>::ClampZero()
 {
-    for (int i = 0; i < NumSpectralSamples; ++i)
-        m_Coefficients[i] = m_Coefficients[i] < 0 ? 0 : m_Coefficients[i];
+    Kernels<T, N>::ApplyUnary(m_Coefficients, m_Coefficients, [](auto a) { return Simd::Max(decltype(a)(0.0), a); });
 }
 
-Spectrum Spectrum::Sqrt(const Spectrum& s)
+template <typename T, int N>
+BasicSpectrum<T, N> BasicSpectrum<T, N>::Sqrt(const BasicSpectrum& s)
 {
-    Spectrum result;
-    for (int i = 0; i < NumSpectralSamples; ++i)
-        result.m_Coefficients[i] = sqrt(s.m_Coefficients[i]);
-
+    BasicSpectrum result;
+    Kernels<T, N>::ApplyUnary(s.m_Coefficients, result.m_Coefficients, [](auto a) { return Simd::Sqrt(a); });
     return result;
 }
 
-Spectrum Spectrum::Pow(const Spectrum& s, double p)
+template <typename T, int N>
+BasicSpectrum<T, N> BasicSpectrum<T, N>::Pow(const BasicSpectrum& s, double p)
 {
-    Spectrum result;
-    for (int i = 0; i < NumSpectralSamples; ++i)
-        result.m_Coefficients[i] = pow(s.m_Coefficients[i], p);
+    // There is no vector pow instruction, and a polynomial exp/log approximation
+    // would not reproduce std::pow bit-for-bit, so this stays lane-by-lane.
+    BasicSpectrum result;
+    for (int i = 0; i < N; ++i)
+        result.m_Coefficients[i] = T(pow(s.m_Coefficients[i], p));
 
     return result;
 }
 
-Spectrum Spectrum::Lerp(const Spectrum& s1, const Spectrum& s2, double t)
+template <typename T, int N>
+BasicSpectrum<T, N> BasicSpectrum<T, N>::Lerp(const BasicSpectrum& s1, const BasicSpectrum& s2, double t)
 {
     return s1 * (1 - t) + s2 * t;
 }
 
-Spectrum Spectrum::Clamp(const Spectrum& s1, const Spectrum& l, const Spectrum& h)
+template <typename T, int N>
+BasicSpectrum<T, N> BasicSpectrum<T, N>::Clamp(const BasicSpectrum& s1, const BasicSpectrum& l, const BasicSpectrum& h)
 {
-    Spectrum result;
-    for (int i = 0; i < NumSpectralSamples; ++i)
+    BasicSpectrum result;
+    Kernels<T, N>::ApplyTernary(s1.m_Coefficients, l.m_Coefficients, h.m_Coefficients, result.m_Coefficients, [](auto v, auto lv, auto hv)
     {
-        double val = s1.m_Coefficients[i];
-        double lv = l.m_Coefficients[i];
-        double hv = h.m_Coefficients[i];
-        result.m_Coefficients[i] = val < lv ? lv : (val > hv ? hv : val);
-    }
+        return Simd::Min(hv, Simd::Max(lv, v));
+    });
 
     return result;
 }
 
-Spectrum Spectrum::Min(const Spectrum& s1, const Spectrum& s2)
+template <typename T, int N>
+BasicSpectrum<T, N> BasicSpectrum<T, N>::Min(const BasicSpectrum& s1, const BasicSpectrum& s2)
 {
-    Spectrum result;
-    for (int i = 0; i < NumSpectralSamples; ++i)
-    {
-        double v1 = s1.m_Coefficients[i];
-        double v2 = s2.m_Coefficients[i];
-        result.m_Coefficients[i] = v1 < v2 ? v1 : v2;
-    }
-
+    BasicSpectrum result;
+    Kernels<T, N>::ApplyBinary(s1.m_Coefficients, s2.m_Coefficients, result.m_Coefficients, [](auto a, auto b) { return Simd::Min(a, b); });
     return result;
 }
 
-Spectrum Spectrum::Max(const Spectrum& s1, const Spectrum& s2)
+template <typename T, int N>
+BasicSpectrum<T, N> BasicSpectrum<T, N>::Max(const BasicSpectrum& s1, const BasicSpectrum& s2)
 {
-    Spectrum result;
-    for (int i = 0; i < NumSpectralSamples; ++i)
-    {
-        double v1 = s1.m_Coefficients[i];
-        double v2 = s2.m_Coefficients[i];
-        result.m_Coefficients[i] = v1 > v2 ? v1 : v2;
-    }
-
+    BasicSpectrum result;
+    Kernels<T, N>::ApplyBinary(s1.m_Coefficients, s2.m_Coefficients, result.m_Coefficients, [](auto a, auto b) { return Simd::Max(a, b); });
     return result;
 }
 
+template class BasicSpectrum<float, 16>;
+template class BasicSpectrum<float, 32>;
+template class BasicSpectrum<float, 60>;
+template class BasicSpectrum<float, 128>;
+template class BasicSpectrum<double, 16>;
+template class BasicSpectrum<double, 32>;
+template class BasicSpectrum<double, 60>;
+template class BasicSpectrum<double, 128>;
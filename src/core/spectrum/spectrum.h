@@ -20,44 +20,118 @@
 
 #pragma once
 
+#include "spectrumexpression.h"
+
+// Default number of bins, used by the Spectrum typedefs. Other bin counts are
+// selected per render job through SpectralResolution.
 const int NumSpectralSamples = 60;
-static_assert(NumSpectralSamples % 4 == 0, "NumSpectralSamples should be 32byte (AVX2) aligned");
 
-class Spectrum
+template <typename T, int N>
+class BasicSpectrum : public SpectrumExpression<BasicSpectrum<T, N>>
 {
+    static_assert(std::is_floating_point_v<T>, "Spectra must be floating point");
+    static_assert(N > 0 && N % 4 == 0, "Spectral bin count should be 32byte (AVX2) aligned");
+
 public:
-    Spectrum(double v = 0.0);
-    ~Spectrum() = default;
+    using ValueType = T;
+    static const int NumSamples = N;
 
 public:
-    inline bool operator==(const Spectrum& other) const { return IsEqual(other); }
-    inline bool operator!=(const Spectrum& other) const { return !IsEqual(other); }
-
-    Spectrum operator+(const Spectrum& c) const;
-    Spectrum& operator+=(const Spectrum& c);
-    Spectrum operator-(const Spectrum& c) const;
-    Spectrum& operator-=(const Spectrum& c);
-    Spectrum operator*(const Spectrum& c) const;
-    Spectrum& operator*=(const Spectrum& c);
-    Spectrum operator/(const Spectrum& c) const;
-    Spectrum& operator/=(const Spectrum& c);
+    constexpr BasicSpectrum(T v = 0.0) { std::fill(std::begin(m_Coefficients), std::end(m_Coefficients), v); }
+    template <typename E>
+    BasicSpectrum(const SpectrumExpression<E>& e) { Assign(e.Derived()); }
+    ~BasicSpectrum() = default;
+
+public:
+    template <typename E>
+    inline BasicSpectrum& operator=(const SpectrumExpression<E>& e) { Assign(e.Derived()); return *this; }
+
+    template <typename E>
+    inline BasicSpectrum& operator+=(const SpectrumExpression<E>& e) { Assign(*this + e); return *this; }
+    template <typename E>
+    inline BasicSpectrum& operator-=(const SpectrumExpression<E>& e) { Assign(*this - e); return *this; }
+    template <typename E>
+    inline BasicSpectrum& operator*=(const SpectrumExpression<E>& e) { Assign(*this * e); return *this; }
+    template <typename E>
+    inline BasicSpectrum& operator/=(const SpectrumExpression<E>& e) { Assign(*this / e); return *this; }
+
+    inline BasicSpectrum& operator+=(double v) { Assign(*this + v); return *this; }
+    inline BasicSpectrum& operator-=(double v) { Assign(*this - v); return *this; }
+    inline BasicSpectrum& operator*=(double v) { Assign(*this * v); return *this; }
+    inline BasicSpectrum& operator/=(double v) { Assign(*this / v); return *this; }
+
+    template <typename P>
+    inline P Load(int i) const { return P::Load(m_Coefficients + i); }
 
 public:
     bool IsBlack() const;
     bool HasNans() const;
-    bool IsEqual(const Spectrum& other) const;
+    bool IsEqual(const BasicSpectrum& other) const;
 
     void ClampZero();
 
 public:
-    static Spectrum Sqrt(const Spectrum& s);
-    static Spectrum Pow(const Spectrum& s, double n);
-    static Spectrum Lerp(const Spectrum& s1, const Spectrum& s2, double t);
-    static Spectrum Clamp(const Spectrum& s1, const Spectrum& l, const Spectrum& h);
-    static Spectrum Min(const Spectrum& s1, const Spectrum& s2);
-    static Spectrum Max(const Spectrum& s1, const Spectrum& s2);
+    static BasicSpectrum Sqrt(const BasicSpectrum& s);
+    static BasicSpectrum Pow(const BasicSpectrum& s, double n);
+    static BasicSpectrum Lerp(const BasicSpectrum& s1, const BasicSpectrum& s2, double t);
+    static BasicSpectrum Clamp(const BasicSpectrum& s1, const BasicSpectrum& l, const BasicSpectrum& h);
+    static BasicSpectrum Min(const BasicSpectrum& s1, const BasicSpectrum& s2);
+    static BasicSpectrum Max(const BasicSpectrum& s1, const BasicSpectrum& s2);
+
+private:
+    template <typename E>
+    void Assign(const E& e);
 
 public:
-    double m_Coefficients[NumSpectralSamples];
+    alignas(Simd::Alignment) T m_Coefficients[N];
 };
 
+template <typename T, int N>
+template <typename E>
+inline void BasicSpectrum<T, N>::Assign(const E& e)
+{
+    static_assert(std::is_same_v<typename E::ValueType, T>, "Spectra of different precision cannot be mixed");
+    static_assert(E::NumSamples == N, "Spectra of different bin counts cannot be mixed");
+
+    using Pack = Simd::Pack<T>;
+    using Scalar = Simd::Scalar<T>;
+
+    // Every node only reads the lane it writes, so evaluating in place is safe
+    // even when this spectrum also appears inside the expression.
+    int i = 0;
+    for (; i + Pack::Width <= N; i += Pack::Width)
+        e.template Load<Pack>(i).Store(m_Coefficients + i);
+
+    for (; i < N; ++i)
+        e.template Load<Scalar>(i).Store(m_Coefficients + i);
+}
+
+template <typename L, typename R>
+inline bool operator==(const SpectrumExpression<L>& l, const SpectrumExpression<R>& r)
+{
+    using Spectrum = BasicSpectrum<typename L::ValueType, L::NumSamples>;
+
+    if constexpr (std::is_same_v<L, Spectrum> && std::is_same_v<R, Spectrum>)
+        return l.Derived().IsEqual(r.Derived());
+    else
+        return Spectrum(l).IsEqual(Spectrum(r));
+}
+
+template <typename L, typename R>
+inline bool operator!=(const SpectrumExpression<L>& l, const SpectrumExpression<R>& r)
+{
+    return !(l == r);
+}
+
+// Defined and explicitly instantiated in spectrum.cpp for every supported
+// SpectralResolution
+extern template class BasicSpectrum<float, 16>;
+extern template class BasicSpectrum<float, 32>;
+extern template class BasicSpectrum<float, 60>;
+extern template class BasicSpectrum<float, 128>;
+extern template class BasicSpectrum<double, 16>;
+extern template class BasicSpectrum<double, 32>;
+extern template class BasicSpectrum<double, 60>;
+extern template class BasicSpectrum<double, 128>;
+
+typedef BasicSpectrum<SpectralReal, NumSpectralSamples> Spectrum;
@@ -0,0 +1,179 @@
+/*
+    This file is part of Spectre, an open-source physically based
+    spectral raytracing library.
+
+    Copyright (c) 2020-2023 Samuel Van Allen - All rights reserved.
+
+    Spectre is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+// Lazy arithmetic on spectra. Operators on spectra build a tree of expression
+// nodes instead of full 60 coefficient temporaries, and the whole tree is
+// evaluated in a single SIMD pass when assigned to a Spectrum.
+//
+// Expression nodes reference their Spectrum operands, so an expression must be
+// consumed within the full-expression that created it. Never store one in an
+// auto variable.
+//
+// Every node exposes the ValueType and NumSamples of the spectra it reads (void
+// and 0 for scalars), so that mixing precisions or bin counts fails to compile
+// instead of silently converting or reading out of bounds.
+template <typename E>
+class SpectrumExpression
+{
+public:
+    inline const E& Derived() const { return static_cast<const E&>(*this); }
+};
+
+namespace SpectrumOps
+{
+    struct Add { template <typename P> static inline P Apply(const P& a, const P& b) { return a + b; } };
+    struct Subtract { template <typename P> static inline P Apply(const P& a, const P& b) { return a - b; } };
+    struct Multiply { template <typename P> static inline P Apply(const P& a, const P& b) { return a * b; } };
+    struct Divide { template <typename P> static inline P Apply(const P& a, const P& b) { return a / b; } };
+}
+
+class SpectrumScalarExpression : public SpectrumExpression<SpectrumScalarExpression>
+{
+public:
+    using ValueType = void;
+    static const int NumSamples = 0;
+
+    SpectrumScalarExpression(double v) : m_Value(v) {}
+
+    template <typename P>
+    inline P Load(int) const { return P(m_Value); }
+
+private:
+    double m_Value;
+};
+
+template <typename L, typename R, typename Op>
+class SpectrumBinaryExpression;
+
+// Spectra are held by reference, while the (small) intermediate nodes are
+// held by value so that nested expressions do not dangle.
+template <typename T>
+struct SpectrumOperand
+{
+    using Type = const T&;
+};
+
+template <>
+struct SpectrumOperand<SpectrumScalarExpression>
+{
+    using Type = const SpectrumScalarExpression;
+};
+
+template <typename L, typename R, typename Op>
+struct SpectrumOperand<SpectrumBinaryExpression<L, R, Op>>
+{
+    using Type = const SpectrumBinaryExpression<L, R, Op>;
+};
+
+template <typename L, typename R, typename Op>
+class SpectrumBinaryExpression : public SpectrumExpression<SpectrumBinaryExpression<L, R, Op>>
+{
+public:
+    using ValueType = std::conditional_t<std::is_void_v<typename L::ValueType>, typename R::ValueType, typename L::ValueType>;
+    static_assert(std::is_void_v<typename L::ValueType> || std::is_void_v<typename R::ValueType> ||
+                  std::is_same_v<typename L::ValueType, typename R::ValueType>, "Spectra of different precision cannot be mixed");
+
+    static const int NumSamples = L::NumSamples != 0 ? L::NumSamples : R::NumSamples;
+    static_assert(L::NumSamples == 0 || R::NumSamples == 0 || L::NumSamples == R::NumSamples, "Spectra of different bin counts cannot be mixed");
+
+    SpectrumBinaryExpression(const L& l, const R& r) : m_Left(l), m_Right(r) {}
+
+    template <typename P>
+    inline P Load(int i) const { return Op::Apply(m_Left.template Load<P>(i), m_Right.template Load<P>(i)); }
+
+private:
+    typename SpectrumOperand<L>::Type m_Left;
+    typename SpectrumOperand<R>::Type m_Right;
+};
+
+template <typename L, typename R>
+inline SpectrumBinaryExpression<L, R, SpectrumOps::Add> operator+(const SpectrumExpression<L>& l, const SpectrumExpression<R>& r)
+{
+    return { l.Derived(), r.Derived() };
+}
+
+template <typename L, typename R>
+inline SpectrumBinaryExpression<L, R, SpectrumOps::Subtract> operator-(const SpectrumExpression<L>& l, const SpectrumExpression<R>& r)
+{
+    return { l.Derived(), r.Derived() };
+}
+
+template <typename L, typename R>
+inline SpectrumBinaryExpression<L, R, SpectrumOps::Multiply> operator*(const SpectrumExpression<L>& l, const SpectrumExpression<R>& r)
+{
+    return { l.Derived(), r.Derived() };
+}
+
+template <typename L, typename R>
+inline SpectrumBinaryExpression<L, R, SpectrumOps::Divide> operator/(const SpectrumExpression<L>& l, const SpectrumExpression<R>& r)
+{
+    return { l.Derived(), r.Derived() };
+}
+
+template <typename L>
+inline SpectrumBinaryExpression<L, SpectrumScalarExpression, SpectrumOps::Add> operator+(const SpectrumExpression<L>& l, double r)
+{
+    return { l.Derived(), r };
+}
+
+template <typename L>
+inline SpectrumBinaryExpression<L, SpectrumScalarExpression, SpectrumOps::Subtract> operator-(const SpectrumExpression<L>& l, double r)
+{
+    return { l.Derived(), r };
+}
+
+template <typename L>
+inline SpectrumBinaryExpression<L, SpectrumScalarExpression, SpectrumOps::Multiply> operator*(const SpectrumExpression<L>& l, double r)
+{
+    return { l.Derived(), r };
+}
+
+template <typename L>
+inline SpectrumBinaryExpression<L, SpectrumScalarExpression, SpectrumOps::Divide> operator/(const SpectrumExpression<L>& l, double r)
+{
+    return { l.Derived(), r };
+}
+
+template <typename R>
+inline SpectrumBinaryExpression<SpectrumScalarExpression, R, SpectrumOps::Add> operator+(double l, const SpectrumExpression<R>& r)
+{
+    return { l, r.Derived() };
+}
+
+template <typename R>
+inline SpectrumBinaryExpression<SpectrumScalarExpression, R, SpectrumOps::Subtract> operator-(double l, const SpectrumExpression<R>& r)
+{
+    return { l, r.Derived() };
+}
+
+template <typename R>
+inline SpectrumBinaryExpression<SpectrumScalarExpression, R, SpectrumOps::Multiply> operator*(double l, const SpectrumExpression<R>& r)
+{
+    return { l, r.Derived() };
+}
+
+template <typename R>
+inline SpectrumBinaryExpression<SpectrumScalarExpression, R, SpectrumOps::Divide> operator/(double l, const SpectrumExpression<R>& r)
+{
+    return { l, r.Derived() };
+}
+
@@ -72,21 +72,36 @@ RgbCoefficients uncharted2_filmic(RgbCoefficients v)
 std::vector<char> StbExporter::ExtractPixelData(const Film& film) const
 {
     std::vector<char> data(GetBufferSize(film));
-    Resolution resolution = film.GetResolution();
-    int iterator = 0;
-    for (int y = 0; y < resolution.GetHeight(); ++y)
+    int width = film.GetResolution().GetWidth();
+
+    // Streams the channel rows of every tile instead of looking up each pixel
+    for (int i = 0; i < film.GetNumTiles(); ++i)
     {
-        for (int x = 0; x < resolution.GetWidth(); ++x)
+        const FilmTile& tile = film.GetTile(i);
+        Point2i position = tile.GetPosition();
+        Vector2i size = tile.GetSize();
+        for (int y = 0; y < size.y; ++y)
         {
-            Pixel p = const_cast<Film&>(film).GetTile({ x, y }).GetFilmSpacePixel({ x, y });
-            RgbCoefficients rgb = SampledSpectrum::XyzToRgb(p.m_Xyz / p.m_TotalSplat);
-
-            if (m_Tonemapper != nullptr)
-                rgb = m_Tonemapper->ApplyTonemap(rgb);
-
-            data[iterator++] = (char)(std::clamp(rgb[0] * 255.0, 0.0, 255.0));
-            data[iterator++] = (char)(std::clamp(rgb[1] * 255.0, 0.0, 255.0));
-            data[iterator++] = (char)(std::clamp(rgb[2] * 255.0, 0.0, 255.0));
+            ConstPixelRow row = tile.GetRow(y);
+            int iterator = ((position.y + y) * width + position.x) * NumColorChannels;
+            for (int x = 0; x < size.x; ++x)
+            {
+                // Pixels only reached by splats have no filter weight to normalize by
+                XyzCoefficients xyz(row.m_X[x], row.m_Y[x], row.m_Z[x]);
+                if (row.m_TotalSplat[x] != 0)
+                    xyz /= row.m_TotalSplat[x];
+                if (film.HasSplats())
+                    xyz += film.GetSplats().GetPixel({ position.x + x, position.y + y }) * film.GetSplats().GetScale();
+
+                RgbCoefficients rgb = SampledSpectrum::XyzToRgb(xyz);
+
+                if (m_Tonemapper != nullptr)
+                    rgb = m_Tonemapper->ApplyTonemap(rgb);
+
+                data[iterator++] = (char)(std::clamp(rgb[0] * 255.0, 0.0, 255.0));
+                data[iterator++] = (char)(std::clamp(rgb[1] * 255.0, 0.0, 255.0));
+                data[iterator++] = (char)(std::clamp(rgb[2] * 255.0, 0.0, 255.0));
+            }
         }
     }
 
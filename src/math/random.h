@@ -20,30 +20,159 @@
 
 #pragma once
 
-#include <random>
+#include <cstdint>
 
+// PCG32 (O'Neill 2014), a 64 bit LCG with a permuted 32 bit output. The whole
+// state is 16 bytes, so every thread, or every pixel sample, can own one.
+// Generators on different sequences produce independent streams.
+class Pcg32
+{
+public:
+    static const uint64_t DefaultState = 0x853c49e6748fea9bULL;
+    static const uint64_t DefaultSequence = 0xda3e39cb94b95bdbULL;
+
+    Pcg32() : m_State(DefaultState), m_Increment(DefaultSequence) {}
+    Pcg32(uint64_t sequenceIndex, uint64_t seed) { SetSequence(sequenceIndex, seed); }
+
+public:
+    // Generator for one pixel sample, positioned at the given dimension. Each
+    // pixel and seed selects its own stream, in which every sample owns 65536
+    // consecutive numbers, one per dimension. The dimension is only an offset
+    // into that block, so the generator for dimension d + 1 yields the numbers
+    // that follow the first one of dimension d. The same arguments always yield
+    // the same numbers, regardless of which thread asks, or in which order.
+    static inline Pcg32 ForSample(const Point2i& pixel, int64_t sampleIndex, int dimension, uint64_t seed = 0)
+    {
+        Pcg32 rng(MixBits(((uint64_t)(uint32_t)pixel.x << 32) ^ (uint32_t)pixel.y ^ MixBits(seed)), seed);
+        rng.Advance(sampleIndex * 65536 + dimension);
+        return rng;
+    }
+
+    // Finalizer of SplitMix64, spreads nearby integers over all 64 bits
+    static inline uint64_t MixBits(uint64_t v)
+    {
+        v ^= v >> 31;
+        v *= 0x7fb5d329728ea185ULL;
+        v ^= v >> 27;
+        v *= 0x81dadef4bc2dd44dULL;
+        v ^= v >> 33;
+        return v;
+    }
+
+public:
+    inline void SetSequence(uint64_t sequenceIndex, uint64_t seed)
+    {
+        m_State = 0;
+        m_Increment = (sequenceIndex << 1) | 1;
+        NextUInt();
+        m_State += seed;
+        NextUInt();
+    }
+
+    inline uint32_t NextUInt()
+    {
+        uint64_t oldState = m_State;
+        m_State = oldState * Multiplier + m_Increment;
+        uint32_t xorShifted = (uint32_t)(((oldState >> 18) ^ oldState) >> 27);
+        uint32_t rotation = (uint32_t)(oldState >> 59);
+        return (xorShifted >> rotation) | (xorShifted << ((~rotation + 1) & 31));
+    }
+
+    // Unbiased integer in [0, bound), bound must be positive
+    inline uint32_t NextUInt(uint32_t bound)
+    {
+        uint32_t threshold = (~bound + 1) % bound;
+        while (true)
+        {
+            uint32_t r = NextUInt();
+            if (r >= threshold)
+                return r % bound;
+        }
+    }
+
+    // Uniform in [0, 1), built from 32 random bits
+    inline float NextFloat() { return std::min(OneMinusEpsilonFloat, NextUInt() * 0x1p-32f); }
+    inline double NextDouble() { return NextUInt() * 0x1p-32; }
+
+    inline void NextFloats(std::span<float> values)
+    {
+        for (float& value : values)
+            value = NextFloat();
+    }
+
+    inline void NextDoubles(std::span<double> values)
+    {
+        for (double& value : values)
+            value = NextDouble();
+    }
+
+    // Skips delta numbers ahead (or back) in O(log delta), Brown 1994
+    inline void Advance(int64_t delta)
+    {
+        uint64_t multiplier = Multiplier;
+        uint64_t increment = m_Increment;
+        uint64_t accumulatedMultiplier = 1;
+        uint64_t accumulatedIncrement = 0;
+
+        for (uint64_t remaining = (uint64_t)delta; remaining > 0; remaining >>= 1)
+        {
+            if (remaining & 1)
+            {
+                accumulatedMultiplier *= multiplier;
+                accumulatedIncrement = accumulatedIncrement * multiplier + increment;
+            }
+
+            increment = (multiplier + 1) * increment;
+            multiplier *= multiplier;
+        }
+
+        m_State = accumulatedMultiplier * m_State + accumulatedIncrement;
+    }
+
+    inline bool operator==(const Pcg32& other) const { return m_State == other.m_State && m_Increment == other.m_Increment; }
+
+private:
+    static const uint64_t Multiplier = 0x5851f42d4c957f2dULL;
+    static constexpr float OneMinusEpsilonFloat = 0x1.fffffep-1f;
+
+    uint64_t m_State;
+    uint64_t m_Increment;
+};
+
+// Convenience functions on a generator owned by the calling thread, so that
+// threads never share state. Render code that must be reproducible should use
+// Pcg32::ForSample instead, as the numbers a thread sees depend on which work
+// it happened to run.
 namespace Random
 {
-    static std::mt19937 m_Rng;
+    inline Pcg32& GetThreadGenerator()
+    {
+        thread_local Pcg32 generator;
+        return generator;
+    }
 
+    // Seeds the calling thread's generator only
     inline void Seed(int seed)
     {
-        m_Rng = std::mt19937(seed); 
+        GetThreadGenerator().SetSequence(Pcg32::DefaultSequence, (uint64_t)seed);
     }
 
     inline int UniformInt()
-    { 
-        return m_Rng();
+    {
+        return (int)GetThreadGenerator().NextUInt();
     }
-    
+
     inline int UniformInt(int min, int max)
     {
-        return (std::uniform_int_distribution<int>(min, max))(m_Rng);
+        uint64_t range = (uint64_t)((int64_t)max - min) + 1;
+        if (range > UINT32_MAX)
+            return (int)GetThreadGenerator().NextUInt();
+
+        return (int)((int64_t)min + GetThreadGenerator().NextUInt((uint32_t)range));
     }
 
     inline double UniformFloat()
     {
-        return (std::uniform_real_distribution<double>(0, 1))(m_Rng);
+        return GetThreadGenerator().NextDouble();
     }
-};
-
+}
@@ -0,0 +1,135 @@
+/*
+    This file is part of Spectre, an open-source physically based
+    spectral raytracing library.
+
+    Copyright (c) 2020-2023 Samuel Van Allen - All rights reserved.
+
+    Spectre is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "raybuffer.h"
+#include "core/film/filmtile.h"
+
+namespace
+{
+    // Arrays are padded to whole vector registers, so that every array starts
+    // aligned when the first one does
+    int PadToAlignment(int count, int elementSize)
+    {
+        int elementsPerVector = Simd::Alignment / elementSize;
+        return (count + elementsPerVector - 1) / elementsPerVector * elementsPerVector;
+    }
+
+    template <typename T>
+    T* AlignPointer(T* p)
+    {
+        uintptr_t address = reinterpret_cast<uintptr_t>(p);
+        uintptr_t aligned = (address + Simd::Alignment - 1) & ~(uintptr_t)(Simd::Alignment - 1);
+        return reinterpret_cast<T*>(aligned);
+    }
+}
+
+RayBuffer::RayBuffer(int size)
+    : m_Size(0)
+    , m_Capacity(0)
+{
+    if (size < 0)
+        throw std::invalid_argument("Ray buffer size cannot be negative");
+
+    Allocate(size);
+    m_Size = size;
+}
+
+void RayBuffer::Resize(int size)
+{
+    if (size < 0)
+        throw std::invalid_argument("Ray buffer size cannot be negative");
+
+    if (size > m_Capacity)
+        Allocate(std::max(size, m_Capacity * 2));
+
+    m_Size = size;
+}
+
+void RayBuffer::SetTileSamples(const FilmTile& tile, const Vector2& offset)
+{
+    Vector2i size = tile.GetSize();
+    Resize(size.x * size.y);
+
+    int i = 0;
+    for (int y = 0; y < size.y; ++y)
+    {
+        for (int x = 0; x < size.x; ++x, ++i)
+            SetSample(i, tile.TileToFilmSpace({ x, y }), offset);
+    }
+}
+
+Ray RayBuffer::GetRay(int i) const
+{
+    return Ray({ m_Origin[0][i], m_Origin[1][i], m_Origin[2][i] }, { m_Direction[0][i], m_Direction[1][i], m_Direction[2][i] });
+}
+
+void RayBuffer::SetRay(int i, const Ray& ray)
+{
+    Point3 origin = ray.GetOrigin();
+    Vector3 direction = ray.GetDirection();
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        m_Origin[axis][i] = origin[axis];
+        m_Direction[axis][i] = direction[axis];
+    }
+}
+
+void RayBuffer::Allocate(int capacity)
+{
+    const int NumDoubleArrays = 8;
+    int paddedDoubles = PadToAlignment(capacity, sizeof(double));
+    int paddedInts = PadToAlignment(capacity, sizeof(int));
+    int slackDoubles = Simd::Alignment / sizeof(double);
+    int slackInts = Simd::Alignment / sizeof(int);
+
+    std::unique_ptr<double[]> storage = std::make_unique<double[]>(NumDoubleArrays * paddedDoubles + slackDoubles);
+    std::unique_ptr<int[]> pixelStorage = std::make_unique<int[]>(2 * paddedInts + slackInts);
+
+    double* doubles = AlignPointer(storage.get());
+    int* ints = AlignPointer(pixelStorage.get());
+    double* arrays[NumDoubleArrays];
+    for (int i = 0; i < NumDoubleArrays; ++i)
+        arrays[i] = doubles + i * paddedDoubles;
+
+    // Keep the rays that are already in the buffer
+    if (m_Storage)
+    {
+        double* oldArrays[NumDoubleArrays] = { m_OffsetX, m_OffsetY, m_Origin[0], m_Origin[1], m_Origin[2], m_Direction[0], m_Direction[1], m_Direction[2] };
+        for (int i = 0; i < NumDoubleArrays; ++i)
+            std::copy(oldArrays[i], oldArrays[i] + m_Size, arrays[i]);
+
+        std::copy(m_PixelX, m_PixelX + m_Size, ints);
+        std::copy(m_PixelY, m_PixelY + m_Size, ints + paddedInts);
+    }
+
+    m_Storage = std::move(storage);
+    m_PixelStorage = std::move(pixelStorage);
+    m_Capacity = capacity;
+
+    m_PixelX = ints;
+    m_PixelY = ints + paddedInts;
+    m_OffsetX = arrays[0];
+    m_OffsetY = arrays[1];
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        m_Origin[axis] = arrays[2 + axis];
+        m_Direction[axis] = arrays[5 + axis];
+    }
+}
@@ -0,0 +1,88 @@
+/*
+    This file is part of Spectre, an open-source physically based
+    spectral raytracing library.
+
+    Copyright (c) 2020-2023 Samuel Van Allen - All rights reserved.
+
+    Spectre is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+class FilmTile;
+
+// Rays in structure of arrays layout, together with the pixel and in-pixel
+// offset each ray was generated for. Every component lives in its own array
+// aligned to Simd::Alignment, so loops over a buffer vectorize and packets of
+// rays can be loaded straight into SIMD registers. Directions are normalized.
+class RayBuffer
+{
+public:
+    RayBuffer(int size = 0);
+
+public:
+    inline int GetSize() const { return m_Size; }
+    inline int GetCapacity() const { return m_Capacity; }
+
+    // Keeps existing rays up to the new size. Only reallocates when growing
+    // beyond the capacity, so a buffer reused per tile allocates once.
+    void Resize(int size);
+
+    // Resizes to the tile's pixel count and lays out one sample per pixel in
+    // row-major order, every one offset by offset within its pixel
+    void SetTileSamples(const FilmTile& tile, const Vector2& offset = {});
+
+    inline void SetSample(int i, const Point2i& pixel, const Vector2& offset)
+    {
+        m_PixelX[i] = pixel.x;
+        m_PixelY[i] = pixel.y;
+        m_OffsetX[i] = offset.x;
+        m_OffsetY[i] = offset.y;
+    }
+
+    inline Point2i GetPixel(int i) const { return { m_PixelX[i], m_PixelY[i] }; }
+    inline Vector2 GetOffset(int i) const { return { m_OffsetX[i], m_OffsetY[i] }; }
+
+    Ray GetRay(int i) const;
+    void SetRay(int i, const Ray& ray);
+
+public:
+    inline int* GetPixelX() { return m_PixelX; }
+    inline int* GetPixelY() { return m_PixelY; }
+    inline double* GetOffsetX() { return m_OffsetX; }
+    inline double* GetOffsetY() { return m_OffsetY; }
+    inline double* GetOriginX() { return m_Origin[0]; }
+    inline double* GetOriginY() { return m_Origin[1]; }
+    inline double* GetOriginZ() { return m_Origin[2]; }
+    inline double* GetDirectionX() { return m_Direction[0]; }
+    inline double* GetDirectionY() { return m_Direction[1]; }
+    inline double* GetDirectionZ() { return m_Direction[2]; }
+
+private:
+    void Allocate(int capacity);
+
+private:
+    int m_Size;
+    int m_Capacity;
+
+    std::unique_ptr<double[]> m_Storage;
+    std::unique_ptr<int[]> m_PixelStorage;
+
+    int* m_PixelX;
+    int* m_PixelY;
+    double* m_OffsetX;
+    double* m_OffsetY;
+    double* m_Origin[3];
+    double* m_Direction[3];
+};
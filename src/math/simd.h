@@ -0,0 +1,318 @@
+/*
+    This file is part of Spectre, an open-source physically based
+    spectral raytracing library.
+
+    Copyright (c) 2020-2023 Samuel Van Allen - All rights reserved.
+
+    Spectre is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#if defined(SPC_USE_AVX_512) || defined(SPC_USE_AVX_2)
+#include <immintrin.h>
+#endif
+
+// Thin wrappers around the widest vector registers enabled at build time.
+// Kernels are written once as generic lambdas over Simd::Pack<T> and reuse the
+// same lambda with Simd::Scalar<T> for any remainder lanes. When neither
+// SPC_USE_AVX_2 nor SPC_USE_AVX_512 is defined, Pack<T> is simply Scalar<T>.
+namespace Simd
+{
+#if defined(SPC_USE_AVX_512)
+    const int Alignment = 64;
+#else
+    const int Alignment = 32;
+#endif
+
+    template <typename T>
+    class Scalar
+    {
+    public:
+        static const int Width = 1;
+
+        Scalar() = default;
+        Scalar(T v) : m_Data(v) {}
+
+        static inline Scalar Load(const T* p) { return *p; }
+        static inline Scalar LoadUnaligned(const T* p) { return *p; }
+        inline void Store(T* p) const { *p = m_Data; }
+        inline void StoreUnaligned(T* p) const { *p = m_Data; }
+
+        inline Scalar operator+(const Scalar& b) const { return m_Data + b.m_Data; }
+        inline Scalar operator-(const Scalar& b) const { return m_Data - b.m_Data; }
+        inline Scalar operator*(const Scalar& b) const { return m_Data * b.m_Data; }
+        inline Scalar operator/(const Scalar& b) const { return m_Data / b.m_Data; }
+
+        inline bool AnyNonZero() const { return m_Data != 0; }
+        inline bool AnyNan() const { return std::isnan(m_Data); }
+        inline T ReduceAdd() const { return m_Data; }
+
+        T m_Data;
+    };
+
+    template <typename T>
+    inline Scalar<T> Sqrt(const Scalar<T>& a) { return std::sqrt(a.m_Data); }
+
+    template <typename T>
+    inline Scalar<T> Min(const Scalar<T>& a, const Scalar<T>& b) { return a.m_Data < b.m_Data ? a.m_Data : b.m_Data; }
+
+    template <typename T>
+    inline Scalar<T> Max(const Scalar<T>& a, const Scalar<T>& b) { return a.m_Data > b.m_Data ? a.m_Data : b.m_Data; }
+
+    template <typename T>
+    inline Scalar<T> Floor(const Scalar<T>& a) { return std::floor(a.m_Data); }
+
+    // Lane-wise a < b ? ifLess : otherwise
+    template <typename T>
+    inline Scalar<T> SelectLess(const Scalar<T>& a, const Scalar<T>& b, const Scalar<T>& ifLess, const Scalar<T>& otherwise)
+    {
+        return a.m_Data < b.m_Data ? ifLess : otherwise;
+    }
+
+    template <typename T>
+    struct NativePack
+    {
+        using Type = Scalar<T>;
+    };
+
+#if defined(SPC_USE_AVX_512)
+    class PackAvx512d
+    {
+    public:
+        static const int Width = 8;
+
+        PackAvx512d() = default;
+        PackAvx512d(__m512d v) : m_Data(v) {}
+        PackAvx512d(double v) : m_Data(_mm512_set1_pd(v)) {}
+
+        static inline PackAvx512d Load(const double* p) { return _mm512_load_pd(p); }
+        static inline PackAvx512d LoadUnaligned(const double* p) { return _mm512_loadu_pd(p); }
+        inline void Store(double* p) const { _mm512_store_pd(p, m_Data); }
+        inline void StoreUnaligned(double* p) const { _mm512_storeu_pd(p, m_Data); }
+
+        inline PackAvx512d operator+(const PackAvx512d& b) const { return _mm512_add_pd(m_Data, b.m_Data); }
+        inline PackAvx512d operator-(const PackAvx512d& b) const { return _mm512_sub_pd(m_Data, b.m_Data); }
+        inline PackAvx512d operator*(const PackAvx512d& b) const { return _mm512_mul_pd(m_Data, b.m_Data); }
+        inline PackAvx512d operator/(const PackAvx512d& b) const { return _mm512_div_pd(m_Data, b.m_Data); }
+
+        inline bool AnyNonZero() const { return _mm512_cmp_pd_mask(m_Data, _mm512_setzero_pd(), _CMP_NEQ_UQ) != 0; }
+        inline bool AnyNan() const { return _mm512_cmp_pd_mask(m_Data, m_Data, _CMP_UNORD_Q) != 0; }
+        inline double ReduceAdd() const { return _mm512_reduce_add_pd(m_Data); }
+
+        __m512d m_Data;
+    };
+
+    inline PackAvx512d Sqrt(const PackAvx512d& a) { return _mm512_sqrt_pd(a.m_Data); }
+    inline PackAvx512d Min(const PackAvx512d& a, const PackAvx512d& b) { return _mm512_min_pd(a.m_Data, b.m_Data); }
+    inline PackAvx512d Max(const PackAvx512d& a, const PackAvx512d& b) { return _mm512_max_pd(a.m_Data, b.m_Data); }
+    inline PackAvx512d Floor(const PackAvx512d& a) { return _mm512_roundscale_pd(a.m_Data, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC); }
+
+    inline PackAvx512d SelectLess(const PackAvx512d& a, const PackAvx512d& b, const PackAvx512d& ifLess, const PackAvx512d& otherwise)
+    {
+        return _mm512_mask_blend_pd(_mm512_cmp_pd_mask(a.m_Data, b.m_Data, _CMP_LT_OQ), otherwise.m_Data, ifLess.m_Data);
+    }
+
+    class PackAvx512f
+    {
+    public:
+        static const int Width = 16;
+
+        PackAvx512f() = default;
+        PackAvx512f(__m512 v) : m_Data(v) {}
+        PackAvx512f(float v) : m_Data(_mm512_set1_ps(v)) {}
+
+        static inline PackAvx512f Load(const float* p) { return _mm512_load_ps(p); }
+        static inline PackAvx512f LoadUnaligned(const float* p) { return _mm512_loadu_ps(p); }
+        inline void Store(float* p) const { _mm512_store_ps(p, m_Data); }
+        inline void StoreUnaligned(float* p) const { _mm512_storeu_ps(p, m_Data); }
+
+        inline PackAvx512f operator+(const PackAvx512f& b) const { return _mm512_add_ps(m_Data, b.m_Data); }
+        inline PackAvx512f operator-(const PackAvx512f& b) const { return _mm512_sub_ps(m_Data, b.m_Data); }
+        inline PackAvx512f operator*(const PackAvx512f& b) const { return _mm512_mul_ps(m_Data, b.m_Data); }
+        inline PackAvx512f operator/(const PackAvx512f& b) const { return _mm512_div_ps(m_Data, b.m_Data); }
+
+        inline bool AnyNonZero() const { return _mm512_cmp_ps_mask(m_Data, _mm512_setzero_ps(), _CMP_NEQ_UQ) != 0; }
+        inline bool AnyNan() const { return _mm512_cmp_ps_mask(m_Data, m_Data, _CMP_UNORD_Q) != 0; }
+        inline float ReduceAdd() const { return _mm512_reduce_add_ps(m_Data); }
+
+        __m512 m_Data;
+    };
+
+    inline PackAvx512f Sqrt(const PackAvx512f& a) { return _mm512_sqrt_ps(a.m_Data); }
+    inline PackAvx512f Min(const PackAvx512f& a, const PackAvx512f& b) { return _mm512_min_ps(a.m_Data, b.m_Data); }
+    inline PackAvx512f Max(const PackAvx512f& a, const PackAvx512f& b) { return _mm512_max_ps(a.m_Data, b.m_Data); }
+    inline PackAvx512f Floor(const PackAvx512f& a) { return _mm512_roundscale_ps(a.m_Data, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC); }
+
+    inline PackAvx512f SelectLess(const PackAvx512f& a, const PackAvx512f& b, const PackAvx512f& ifLess, const PackAvx512f& otherwise)
+    {
+        return _mm512_mask_blend_ps(_mm512_cmp_ps_mask(a.m_Data, b.m_Data, _CMP_LT_OQ), otherwise.m_Data, ifLess.m_Data);
+    }
+
+    template <>
+    struct NativePack<double>
+    {
+        using Type = PackAvx512d;
+    };
+
+    template <>
+    struct NativePack<float>
+    {
+        using Type = PackAvx512f;
+    };
+#elif defined(SPC_USE_AVX_2)
+    class PackAvx2d
+    {
+    public:
+        static const int Width = 4;
+
+        PackAvx2d() = default;
+        PackAvx2d(__m256d v) : m_Data(v) {}
+        PackAvx2d(double v) : m_Data(_mm256_set1_pd(v)) {}
+
+        static inline PackAvx2d Load(const double* p) { return _mm256_load_pd(p); }
+        static inline PackAvx2d LoadUnaligned(const double* p) { return _mm256_loadu_pd(p); }
+        inline void Store(double* p) const { _mm256_store_pd(p, m_Data); }
+        inline void StoreUnaligned(double* p) const { _mm256_storeu_pd(p, m_Data); }
+
+        inline PackAvx2d operator+(const PackAvx2d& b) const { return _mm256_add_pd(m_Data, b.m_Data); }
+        inline PackAvx2d operator-(const PackAvx2d& b) const { return _mm256_sub_pd(m_Data, b.m_Data); }
+        inline PackAvx2d operator*(const PackAvx2d& b) const { return _mm256_mul_pd(m_Data, b.m_Data); }
+        inline PackAvx2d operator/(const PackAvx2d& b) const { return _mm256_div_pd(m_Data, b.m_Data); }
+
+        inline bool AnyNonZero() const { return _mm256_movemask_pd(_mm256_cmp_pd(m_Data, _mm256_setzero_pd(), _CMP_NEQ_UQ)) != 0; }
+        inline bool AnyNan() const { return _mm256_movemask_pd(_mm256_cmp_pd(m_Data, m_Data, _CMP_UNORD_Q)) != 0; }
+
+        inline double ReduceAdd() const
+        {
+            __m128d sum = _mm_add_pd(_mm256_castpd256_pd128(m_Data), _mm256_extractf128_pd(m_Data, 1));
+            return _mm_cvtsd_f64(_mm_add_sd(sum, _mm_unpackhi_pd(sum, sum)));
+        }
+
+        __m256d m_Data;
+    };
+
+    inline PackAvx2d Sqrt(const PackAvx2d& a) { return _mm256_sqrt_pd(a.m_Data); }
+    inline PackAvx2d Min(const PackAvx2d& a, const PackAvx2d& b) { return _mm256_min_pd(a.m_Data, b.m_Data); }
+    inline PackAvx2d Max(const PackAvx2d& a, const PackAvx2d& b) { return _mm256_max_pd(a.m_Data, b.m_Data); }
+    inline PackAvx2d Floor(const PackAvx2d& a) { return _mm256_floor_pd(a.m_Data); }
+
+    inline PackAvx2d SelectLess(const PackAvx2d& a, const PackAvx2d& b, const PackAvx2d& ifLess, const PackAvx2d& otherwise)
+    {
+        return _mm256_blendv_pd(otherwise.m_Data, ifLess.m_Data, _mm256_cmp_pd(a.m_Data, b.m_Data, _CMP_LT_OQ));
+    }
+
+    class PackAvx2f
+    {
+    public:
+        static const int Width = 8;
+
+        PackAvx2f() = default;
+        PackAvx2f(__m256 v) : m_Data(v) {}
+        PackAvx2f(float v) : m_Data(_mm256_set1_ps(v)) {}
+
+        static inline PackAvx2f Load(const float* p) { return _mm256_load_ps(p); }
+        static inline PackAvx2f LoadUnaligned(const float* p) { return _mm256_loadu_ps(p); }
+        inline void Store(float* p) const { _mm256_store_ps(p, m_Data); }
+        inline void StoreUnaligned(float* p) const { _mm256_storeu_ps(p, m_Data); }
+
+        inline PackAvx2f operator+(const PackAvx2f& b) const { return _mm256_add_ps(m_Data, b.m_Data); }
+        inline PackAvx2f operator-(const PackAvx2f& b) const { return _mm256_sub_ps(m_Data, b.m_Data); }
+        inline PackAvx2f operator*(const PackAvx2f& b) const { return _mm256_mul_ps(m_Data, b.m_Data); }
+        inline PackAvx2f operator/(const PackAvx2f& b) const { return _mm256_div_ps(m_Data, b.m_Data); }
+
+        inline bool AnyNonZero() const { return _mm256_movemask_ps(_mm256_cmp_ps(m_Data, _mm256_setzero_ps(), _CMP_NEQ_UQ)) != 0; }
+        inline bool AnyNan() const { return _mm256_movemask_ps(_mm256_cmp_ps(m_Data, m_Data, _CMP_UNORD_Q)) != 0; }
+
+        inline float ReduceAdd() const
+        {
+            __m128 sum = _mm_add_ps(_mm256_castps256_ps128(m_Data), _mm256_extractf128_ps(m_Data, 1));
+            sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+            return _mm_cvtss_f32(_mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1)));
+        }
+
+        __m256 m_Data;
+    };
+
+    inline PackAvx2f Sqrt(const PackAvx2f& a) { return _mm256_sqrt_ps(a.m_Data); }
+    inline PackAvx2f Min(const PackAvx2f& a, const PackAvx2f& b) { return _mm256_min_ps(a.m_Data, b.m_Data); }
+    inline PackAvx2f Max(const PackAvx2f& a, const PackAvx2f& b) { return _mm256_max_ps(a.m_Data, b.m_Data); }
+    inline PackAvx2f Floor(const PackAvx2f& a) { return _mm256_floor_ps(a.m_Data); }
+
+    inline PackAvx2f SelectLess(const PackAvx2f& a, const PackAvx2f& b, const PackAvx2f& ifLess, const PackAvx2f& otherwise)
+    {
+        return _mm256_blendv_ps(otherwise.m_Data, ifLess.m_Data, _mm256_cmp_ps(a.m_Data, b.m_Data, _CMP_LT_OQ));
+    }
+
+    template <>
+    struct NativePack<double>
+    {
+        using Type = PackAvx2d;
+    };
+
+    template <>
+    struct NativePack<float>
+    {
+        using Type = PackAvx2f;
+    };
+#endif
+
+    template <typename T>
+    using Pack = typename NativePack<T>::Type;
+
+    // Sine and cosine of every lane, for any pack or scalar type. The argument
+    // is reduced to [-pi/4, pi/4] with a two part pi/2 (Cody and Waite), where
+    // Taylor polynomials are accurate to double precision. Meant for angles of
+    // moderate size, such as the [0, 2pi) of sampling code.
+    template <typename P>
+    inline void SinCos(const P& x, P& sine, P& cosine)
+    {
+        const double TwoOverPi = 0.63661977236758134308;
+        const double PiOver2High = 1.57079632673412561417;
+        const double PiOver2Low = 6.07710050650619224932e-11;
+
+        P quadrant = Floor(x * P(TwoOverPi) + P(0.5));
+        P r = (x - quadrant * P(PiOver2High)) - quadrant * P(PiOver2Low);
+        P r2 = r * r;
+
+        P s = P(1.0 / 1307674368000.0);
+        s = s * r2 - P(1.0 / 6227020800.0);
+        s = s * r2 + P(1.0 / 39916800.0);
+        s = s * r2 - P(1.0 / 362880.0);
+        s = s * r2 + P(1.0 / 5040.0);
+        s = s * r2 - P(1.0 / 120.0);
+        s = s * r2 + P(1.0 / 6.0);
+        s = r - r * r2 * s;
+
+        P c = P(1.0 / 20922789888000.0);
+        c = c * r2 - P(1.0 / 87178291200.0);
+        c = c * r2 + P(1.0 / 479001600.0);
+        c = c * r2 - P(1.0 / 3628800.0);
+        c = c * r2 + P(1.0 / 40320.0);
+        c = c * r2 - P(1.0 / 720.0);
+        c = c * r2 + P(1.0 / 24.0);
+        c = c * r2 - P(0.5);
+        c = P(1.0) + r2 * c;
+
+        // quadrant mod 4 picks which polynomial and which sign each result uses
+        P q = quadrant - P(4.0) * Floor(quadrant * P(0.25));
+        P odd = q - P(2.0) * Floor(q * P(0.5));
+        P distance = q - P(1.5);
+        distance = Max(distance, P(0.0) - distance);
+
+        sine = SelectLess(odd, P(0.5), s, c) * SelectLess(q, P(1.5), P(1.0), P(-1.0));
+        cosine = SelectLess(odd, P(0.5), c, s) * SelectLess(distance, P(1.0), P(-1.0), P(1.0));
+    }
+}
+
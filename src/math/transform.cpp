@@ -19,6 +19,7 @@
 */
 
 #include "transform.h"
+#include <atomic>
 
 Transform::Transform()
     : m_TransientTransform(0.0)
@@ -51,6 +52,14 @@ void Transform::UpdateMatrices()
     m_MatrixInverse = m_Matrix.Inversed();
     m_MatrixTranspose = m_Matrix.Transposed();
     m_MatrixInverseTranspose = m_MatrixInverse.Transposed();
+    m_Revision = NextRevision();
+}
+
+uint64_t Transform::NextRevision()
+{
+    // Revision 0 is left to default constructed transforms, which all hold the identity
+    static std::atomic_uint64_t lastRevision = 0;
+    return ++lastRevision;
 }
 
 Vector3 Transform::operator()(const Vector3& v) const
@@ -85,6 +94,70 @@ Ray Transform::operator()(const Ray& r) const
     return Ray((*this)(origin), (*this)(direction));
 }
 
+void Transform::TransformVectors(std::span<const Vector3> in, std::span<Vector3> out) const
+{
+    if (out.size() < in.size())
+        throw std::invalid_argument("Output span is smaller than the input span");
+
+    const Matrix4x4& m = m_Matrix;
+    for (size_t i = 0; i < in.size(); i++)
+    {
+        const Vector3 v = in[i];
+        out[i] = { m.m_11 * v.x + m.m_12 * v.y + m.m_13 * v.z,
+                   m.m_21 * v.x + m.m_22 * v.y + m.m_23 * v.z,
+                   m.m_31 * v.x + m.m_32 * v.y + m.m_33 * v.z };
+    }
+}
+
+void Transform::TransformPoints(std::span<const Point3> in, std::span<Point3> out) const
+{
+    if (out.size() < in.size())
+        throw std::invalid_argument("Output span is smaller than the input span");
+
+    const Matrix4x4& m = m_Matrix;
+    for (size_t i = 0; i < in.size(); i++)
+    {
+        const Point3 p = in[i];
+        double w = m.m_41 * p.x + m.m_42 * p.y + m.m_43 * p.z + m.m_44;
+        double invW = w != 1.0 ? 1.0 / w : 1.0;
+        out[i] = { (m.m_11 * p.x + m.m_12 * p.y + m.m_13 * p.z + m.m_14) * invW,
+                   (m.m_21 * p.x + m.m_22 * p.y + m.m_23 * p.z + m.m_24) * invW,
+                   (m.m_31 * p.x + m.m_32 * p.y + m.m_33 * p.z + m.m_34) * invW };
+    }
+}
+
+void Transform::TransformVectors(std::span<double> x, std::span<double> y, std::span<double> z) const
+{
+    if (x.size() != y.size() || x.size() != z.size())
+        throw std::invalid_argument("Component spans must have the same size");
+
+    const Matrix4x4& m = m_Matrix;
+    for (size_t i = 0; i < x.size(); i++)
+    {
+        double vx = x[i], vy = y[i], vz = z[i];
+        x[i] = m.m_11 * vx + m.m_12 * vy + m.m_13 * vz;
+        y[i] = m.m_21 * vx + m.m_22 * vy + m.m_23 * vz;
+        z[i] = m.m_31 * vx + m.m_32 * vy + m.m_33 * vz;
+    }
+}
+
+void Transform::TransformPoints(std::span<double> x, std::span<double> y, std::span<double> z) const
+{
+    if (x.size() != y.size() || x.size() != z.size())
+        throw std::invalid_argument("Component spans must have the same size");
+
+    const Matrix4x4& m = m_Matrix;
+    for (size_t i = 0; i < x.size(); i++)
+    {
+        double px = x[i], py = y[i], pz = z[i];
+        double w = m.m_41 * px + m.m_42 * py + m.m_43 * pz + m.m_44;
+        double invW = w != 1.0 ? 1.0 / w : 1.0;
+        x[i] = (m.m_11 * px + m.m_12 * py + m.m_13 * pz + m.m_14) * invW;
+        y[i] = (m.m_21 * px + m.m_22 * py + m.m_23 * pz + m.m_24) * invW;
+        z[i] = (m.m_31 * px + m.m_32 * py + m.m_33 * pz + m.m_34) * invW;
+    }
+}
+
 Transform Transform::Inversed() const
 {
     Transform inv;
@@ -92,6 +165,7 @@ Transform Transform::Inversed() const
     inv.m_Matrix = m_MatrixInverse;
     inv.m_MatrixInverseTranspose = m_MatrixTranspose;
     inv.m_MatrixTranspose = m_MatrixInverseTranspose;
+    inv.m_Revision = NextRevision();
     return inv;
 }
 
@@ -32,6 +32,12 @@ public:
     inline Matrix4x4 GetMatrix() const { return m_Matrix; };
     inline Matrix4x4 GetMatrixInverse() const { return m_MatrixInverse; };
 
+    // Changes whenever the matrices change, lets owners invalidate derived data.
+    // Revisions are drawn from a counter shared by all transforms, so two
+    // transforms only have the same revision if one is a copy of the other, and
+    // assigning a different transform always changes the revision.
+    inline uint64_t GetRevision() const { return m_Revision; };
+
 public:
     void SetTranslation(const Vector3& translation);
     void SetRotation(const Vector3& eulerRotation);
@@ -43,11 +49,21 @@ public:
     Point3 operator()(const Point3& p) const;
     Ray operator()(const Ray& r) const;
 
+public:
+    // Batched transforms, out must be at least as large as in and may alias it
+    void TransformVectors(std::span<const Vector3> in, std::span<Vector3> out) const;
+    void TransformPoints(std::span<const Point3> in, std::span<Point3> out) const;
+
+    // Structure of arrays variants, transforming the components in place
+    void TransformVectors(std::span<double> x, std::span<double> y, std::span<double> z) const;
+    void TransformPoints(std::span<double> x, std::span<double> y, std::span<double> z) const;
+
 public:
     Transform Inversed() const;
 
 private:
     void UpdateMatrices();
+    static uint64_t NextRevision();
 
 private:
     static Matrix4x4 GetTranslationMatrix(const Vector3& translation);
@@ -67,4 +83,6 @@ private:
     Matrix4x4 m_MatrixInverse;
     Matrix4x4 m_MatrixTranspose;
     Matrix4x4 m_MatrixInverseTranspose;
+
+    uint64_t m_Revision = 0;
 };
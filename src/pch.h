@@ -24,6 +24,7 @@
 #include <assert.h>
 #include <memory>
 #include <mutex>
+#include <span>
 #include <stdexcept>
 #include <string>
 #include <stdexcept>
@@ -35,6 +36,7 @@
 #include <cmath>
 #include "math/constants.h"
 #include "math/mathutils.h"
+#include "math/simd.h"
 #include "math/linalg.h"
 #include "math/transform.h"
 #include "math/ray.h"
@@ -0,0 +1,262 @@
+/*
+    This file is part of Spectre, an open-source physically based
+    spectral raytracing library.
+
+    Copyright (c) 2020-2023 Samuel Van Allen - All rights reserved.
+
+    Spectre is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "cputopology.h"
+
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <thread>
+
+#ifdef SPC_PLATFORM_WIN
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#elif defined(SPC_PLATFORM_LINUX)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace
+{
+#ifdef SPC_PLATFORM_LINUX
+    bool ReadFile(const std::string& path, std::string& contents)
+    {
+        std::ifstream file(path);
+        return file && std::getline(file, contents);
+    }
+
+    int ReadInt(const std::string& path, int fallback)
+    {
+        std::string contents;
+        if (!ReadFile(path, contents))
+            return fallback;
+
+        try
+        {
+            return std::stoi(contents);
+        }
+        catch (const std::exception&)
+        {
+            return fallback;
+        }
+    }
+#endif
+}
+
+CpuTopology::CpuTopology()
+    : CpuTopology(std::vector<LogicalCpu>())
+{
+}
+
+CpuTopology::CpuTopology(const std::vector<LogicalCpu>& cpus)
+    : m_NumCores(0)
+    , m_NumNumaNodes(0)
+{
+    std::vector<LogicalCpu> input = cpus;
+    if (input.empty())
+    {
+        int numCpus = std::max(1, (int)std::thread::hardware_concurrency());
+        for (int i = 0; i < numCpus; ++i)
+            input.push_back({ i, i, 0, 0 });
+    }
+
+    // Remap OS ids, which may be sparse, to dense indices in order of appearance
+    std::map<std::pair<int, int>, int> coreIndices;
+    std::map<int, int> nodeIndices;
+    for (const LogicalCpu& cpu : input)
+    {
+        if (cpu.m_Id < 0)
+            throw std::invalid_argument("Logical CPU ids cannot be negative");
+
+        auto core = coreIndices.emplace(std::make_pair(cpu.m_Package, cpu.m_Core), (int)coreIndices.size()).first;
+        auto node = nodeIndices.emplace(cpu.m_NumaNode, (int)nodeIndices.size()).first;
+        m_Cpus.push_back({ cpu.m_Id, core->second, cpu.m_Package, node->second });
+    }
+
+    m_NumCores = (int)coreIndices.size();
+    m_NumNumaNodes = (int)nodeIndices.size();
+}
+
+CpuTopology CpuTopology::Detect()
+{
+#ifdef SPC_PLATFORM_LINUX
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0)
+        return CpuTopology();
+
+    std::map<int, int> nodeOfCpu;
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator("/sys/devices/system/node", error))
+    {
+        std::string name = entry.path().filename().string();
+        if (name.rfind("node", 0) != 0 || name.size() == 4 || !std::isdigit((unsigned char)name[4]))
+            continue;
+
+        std::string cpuList;
+        if (!ReadFile(entry.path().string() + "/cpulist", cpuList))
+            continue;
+
+        int node = std::stoi(name.substr(4));
+        for (int cpu : ParseCpuList(cpuList))
+            nodeOfCpu[cpu] = node;
+    }
+
+    std::vector<LogicalCpu> cpus;
+    for (int id = 0; id < CPU_SETSIZE; ++id)
+    {
+        if (!CPU_ISSET(id, &allowed))
+            continue;
+
+        std::string topology = "/sys/devices/system/cpu/cpu" + std::to_string(id) + "/topology/";
+        int package = ReadInt(topology + "physical_package_id", 0);
+        int core = ReadInt(topology + "core_id", id);
+        auto node = nodeOfCpu.find(id);
+        cpus.push_back({ id, core, package, node != nodeOfCpu.end() ? node->second : 0 });
+    }
+
+    return CpuTopology(cpus);
+#else
+    return CpuTopology();
+#endif
+}
+
+std::vector<int> CpuTopology::ParseCpuList(const std::string& list)
+{
+    std::vector<int> cpus;
+    std::stringstream stream(list);
+    std::string range;
+
+    while (std::getline(stream, range, ','))
+    {
+        range.erase(std::remove_if(range.begin(), range.end(), [](unsigned char c) { return std::isspace(c); }), range.end());
+        if (range.empty())
+            continue;
+
+        try
+        {
+            size_t dash = range.find('-');
+            int first = std::stoi(range.substr(0, dash));
+            int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+            if (first < 0 || last < first)
+                throw std::invalid_argument("Invalid cpu range " + range);
+
+            for (int cpu = first; cpu <= last; ++cpu)
+                cpus.push_back(cpu);
+        }
+        catch (const std::logic_error&)
+        {
+            throw std::invalid_argument("Invalid cpu list " + list);
+        }
+    }
+
+    return cpus;
+}
+
+bool CpuTopology::PinCurrentThread(int cpu)
+{
+#ifdef SPC_PLATFORM_LINUX
+    if (cpu < 0 || cpu >= CPU_SETSIZE)
+        return false;
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#elif defined(SPC_PLATFORM_WIN)
+    if (cpu < 0 || cpu >= (int)sizeof(DWORD_PTR) * 8)
+        return false;
+
+    return SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR(1) << cpu) != 0;
+#else
+    return false;
+#endif
+}
+
+std::vector<LogicalCpu> CpuTopology::SelectCpus(AffinityPolicy policy, int numThreads) const
+{
+    std::vector<LogicalCpu> order;
+    switch (policy)
+    {
+    case AffinityPolicy::None:
+        return {};
+    case AffinityPolicy::Compact:
+        order = OrderCompact();
+        break;
+    case AffinityPolicy::Scatter:
+        order = OrderScatter();
+        break;
+    case AffinityPolicy::PhysicalCores:
+        for (const LogicalCpu& cpu : OrderCompact())
+            if (order.empty() || order.back().m_Core != cpu.m_Core)
+                order.push_back(cpu);
+        break;
+    }
+
+    std::vector<LogicalCpu> selected;
+    for (int i = 0; i < numThreads; ++i)
+        selected.push_back(order[i % order.size()]);
+
+    return selected;
+}
+
+std::vector<LogicalCpu> CpuTopology::OrderCompact() const
+{
+    std::vector<LogicalCpu> order = m_Cpus;
+    std::sort(order.begin(), order.end(), [](const LogicalCpu& a, const LogicalCpu& b)
+    {
+        return std::tie(a.m_NumaNode, a.m_Core, a.m_Id) < std::tie(b.m_NumaNode, b.m_Core, b.m_Id);
+    });
+
+    return order;
+}
+
+std::vector<LogicalCpu> CpuTopology::OrderScatter() const
+{
+    // siblings[node][core] holds the logical CPUs of each core, in compact order
+    std::vector<std::vector<std::vector<LogicalCpu>>> siblings(m_NumNumaNodes);
+    for (const LogicalCpu& cpu : OrderCompact())
+    {
+        std::vector<std::vector<LogicalCpu>>& cores = siblings[cpu.m_NumaNode];
+        if (cores.empty() || cores.back().front().m_Core != cpu.m_Core)
+            cores.emplace_back();
+
+        cores.back().push_back(cpu);
+    }
+
+    size_t maxCores = 0;
+    size_t maxSiblings = 0;
+    for (const auto& cores : siblings)
+    {
+        maxCores = std::max(maxCores, cores.size());
+        for (const auto& core : cores)
+            maxSiblings = std::max(maxSiblings, core.size());
+    }
+
+    std::vector<LogicalCpu> order;
+    for (size_t sibling = 0; sibling < maxSiblings; ++sibling)
+        for (size_t core = 0; core < maxCores; ++core)
+            for (const auto& cores : siblings)
+                if (core < cores.size() && sibling < cores[core].size())
+                    order.push_back(cores[core][sibling]);
+
+    return order;
+}
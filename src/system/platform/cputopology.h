@@ -0,0 +1,89 @@
+/*
+    This file is part of Spectre, an open-source physically based
+    spectral raytracing library.
+
+    Copyright (c) 2020-2023 Samuel Van Allen - All rights reserved.
+
+    Spectre is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+// How worker threads are pinned to logical CPUs
+enum class AffinityPolicy
+{
+    // Threads are left to the OS scheduler
+    None,
+
+    // Fill every core's SMT siblings, then the next core on the same NUMA
+    // node, keeping threads close together and sharing caches
+    Compact,
+
+    // Spread threads round-robin over NUMA nodes and physical cores before
+    // doubling up on SMT siblings, maximizing memory bandwidth
+    Scatter,
+
+    // One thread per physical core, SMT siblings are left idle
+    PhysicalCores
+};
+
+struct LogicalCpu
+{
+    int m_Id;
+    int m_Core;
+    int m_Package;
+    int m_NumaNode;
+};
+
+// Logical CPUs available to this process together with the physical core,
+// package and NUMA node each one belongs to. Core and node indices are dense,
+// starting at 0, regardless of the ids the OS uses.
+class CpuTopology
+{
+public:
+    CpuTopology();
+    CpuTopology(const std::vector<LogicalCpu>& cpus);
+
+public:
+    // On Linux this reads the CPUs in the process affinity mask and their
+    // placement from sysfs. Elsewhere every CPU is reported as its own core on
+    // a single node.
+    static CpuTopology Detect();
+
+    // Parses a kernel cpulist such as "0-3,8,10-11"
+    static std::vector<int> ParseCpuList(const std::string& list);
+
+    // Pins the calling thread to the given logical CPU, returns false if the
+    // platform does not support it or the call failed
+    static bool PinCurrentThread(int cpu);
+
+public:
+    inline const std::vector<LogicalCpu>& GetCpus() const { return m_Cpus; }
+    inline int GetNumLogicalCpus() const { return (int)m_Cpus.size(); }
+    inline int GetNumPhysicalCores() const { return m_NumCores; }
+    inline int GetNumNumaNodes() const { return m_NumNumaNodes; }
+
+    // Logical CPU for every one of numThreads workers. Workers wrap around when
+    // there are more of them than the policy has CPUs to offer.
+    std::vector<LogicalCpu> SelectCpus(AffinityPolicy policy, int numThreads) const;
+
+private:
+    std::vector<LogicalCpu> OrderCompact() const;
+    std::vector<LogicalCpu> OrderScatter() const;
+
+private:
+    std::vector<LogicalCpu> m_Cpus;
+    int m_NumCores;
+    int m_NumNumaNodes;
+};
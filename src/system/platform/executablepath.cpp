@@ -0,0 +1,59 @@
+/*
+    This file is part of Spectre, an open-source physically based
+    spectral raytracing library.
+
+    Copyright (c) 2020-2023 Samuel Van Allen - All rights reserved.
+
+    Spectre is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "executablepath.h"
+
+#ifdef SPC_PLATFORM_WIN
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#elif defined(SPC_PLATFORM_MAC)
+#include <mach-o/dyld.h>
+#endif
+
+std::filesystem::path GetExecutableDirectory()
+{
+    std::error_code error;
+
+#ifdef SPC_PLATFORM_WIN
+    std::vector<wchar_t> buffer(MAX_PATH);
+    DWORD length;
+    while ((length = GetModuleFileNameW(nullptr, buffer.data(), DWORD(buffer.size()))) == buffer.size())
+        buffer.resize(buffer.size() * 2);
+
+    if (length > 0)
+        return std::filesystem::path(std::wstring(buffer.data(), length)).parent_path();
+#elif defined(SPC_PLATFORM_MAC)
+    uint32_t size = 0;
+    _NSGetExecutablePath(nullptr, &size);
+    std::vector<char> buffer(size);
+    if (_NSGetExecutablePath(buffer.data(), &size) == 0)
+    {
+        std::filesystem::path path = std::filesystem::canonical(buffer.data(), error);
+        if (!error)
+            return path.parent_path();
+    }
+#elif defined(SPC_PLATFORM_LINUX)
+    std::filesystem::path path = std::filesystem::read_symlink("/proc/self/exe", error);
+    if (!error)
+        return path.parent_path();
+#endif
+
+    return std::filesystem::current_path();
+}
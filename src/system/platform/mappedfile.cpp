@@ -0,0 +1,97 @@
+/*
+    This file is part of Spectre, an open-source physically based
+    spectral raytracing library.
+
+    Copyright (c) 2020-2023 Samuel Van Allen - All rights reserved.
+
+    Spectre is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "mappedfile.h"
+
+#ifdef SPC_PLATFORM_WIN
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef SPC_PLATFORM_WIN
+MappedFile::MappedFile(const std::string& path)
+    : m_Data(nullptr), m_Size(0), m_Mapping(nullptr)
+{
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        throw std::runtime_error("Could not open " + path);
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+    {
+        CloseHandle(file);
+        throw std::runtime_error("Could not map empty file " + path);
+    }
+
+    m_Size = size_t(size.QuadPart);
+    m_Mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+
+    if (!m_Mapping)
+        throw std::runtime_error("Could not map " + path);
+
+    m_Data = MapViewOfFile(m_Mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!m_Data)
+    {
+        CloseHandle(m_Mapping);
+        throw std::runtime_error("Could not map " + path);
+    }
+}
+
+MappedFile::~MappedFile()
+{
+    UnmapViewOfFile(m_Data);
+    CloseHandle(m_Mapping);
+}
+#else
+MappedFile::MappedFile(const std::string& path)
+    : m_Data(nullptr), m_Size(0)
+{
+    int file = open(path.c_str(), O_RDONLY);
+    if (file < 0)
+        throw std::runtime_error("Could not open " + path);
+
+    struct stat info;
+    if (fstat(file, &info) != 0 || info.st_size == 0)
+    {
+        close(file);
+        throw std::runtime_error("Could not map empty file " + path);
+    }
+
+    m_Size = size_t(info.st_size);
+    void* data = mmap(nullptr, m_Size, PROT_READ, MAP_PRIVATE, file, 0);
+    close(file);
+
+    if (data == MAP_FAILED)
+        throw std::runtime_error("Could not map " + path);
+
+    m_Data = data;
+}
+
+MappedFile::~MappedFile()
+{
+    munmap(const_cast<void*>(m_Data), m_Size);
+}
+#endif
@@ -0,0 +1,44 @@
+/*
+    This file is part of Spectre, an open-source physically based
+    spectral raytracing library.
+
+    Copyright (c) 2020-2023 Samuel Van Allen - All rights reserved.
+
+    Spectre is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+// Read-only memory mapping of a whole file. The mapping lives as long as the
+// MappedFile, and is shared between processes by the OS page cache.
+class MappedFile
+{
+public:
+    MappedFile(const std::string& path);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+public:
+    inline const void* GetData() const { return m_Data; }
+    inline size_t GetSize() const { return m_Size; }
+
+private:
+    const void* m_Data;
+    size_t m_Size;
+#ifdef SPC_PLATFORM_WIN
+    void* m_Mapping;
+#endif
+};
@@ -0,0 +1,40 @@
+/*
+    This file is part of Spectre, an open-source physically based
+    spectral raytracing library.
+
+    Copyright (c) 2020-2023 Samuel Van Allen - All rights reserved.
+
+    Spectre is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <atomic>
+
+// Flag shared between the code that issues work and the tasks doing it. Copies
+// share one flag, so cancelling any copy is seen by every task holding another.
+// Cancellation is sticky, stale work gets a token of its own and fresh work a
+// new one.
+class CancellationToken
+{
+public:
+    CancellationToken() : m_Cancelled(std::make_shared<std::atomic_bool>(false)) {}
+
+public:
+    inline void Cancel() { m_Cancelled->store(true, std::memory_order_relaxed); }
+    inline bool IsCancelled() const { return m_Cancelled->load(std::memory_order_relaxed); }
+
+private:
+    std::shared_ptr<std::atomic_bool> m_Cancelled;
+};
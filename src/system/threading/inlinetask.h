@@ -0,0 +1,127 @@
+/*
+    This file is part of Spectre, an open-source physically based
+    spectral raytracing library.
+
+    Copyright (c) 2020-2023 Samuel Van Allen - All rights reserved.
+
+    Spectre is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+// Move-only void() callable that stores its target inline in a fixed-size
+// buffer, so wrapping a task never allocates. Targets that do not fit fail to
+// compile, use Fits<F> to check up front and box larger targets explicitly.
+template <size_t Capacity>
+class InlineTask
+{
+public:
+    template <typename F>
+    static constexpr bool Fits = sizeof(F) <= Capacity && alignof(F) <= alignof(std::max_align_t) && std::is_nothrow_move_constructible_v<F>;
+
+public:
+    InlineTask() = default;
+    template <typename F, typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, InlineTask>>>
+    InlineTask(F&& function);
+    InlineTask(InlineTask&& other) noexcept;
+    ~InlineTask();
+
+    InlineTask(const InlineTask&) = delete;
+    InlineTask& operator=(const InlineTask&) = delete;
+    InlineTask& operator=(InlineTask&& other) noexcept;
+
+public:
+    inline void operator()() { m_Invoke(m_Storage); }
+    inline explicit operator bool() const { return m_Invoke != nullptr; }
+
+private:
+    void Reset();
+
+private:
+    typedef void (*InvokeFunction)(void* storage);
+
+    // Move constructs the target from source into destination and destroys the
+    // source, or only destroys source when destination is null
+    typedef void (*RelocateFunction)(void* destination, void* source);
+
+private:
+    alignas(std::max_align_t) unsigned char m_Storage[Capacity];
+    InvokeFunction m_Invoke = nullptr;
+    RelocateFunction m_Relocate = nullptr;
+};
+
+template <size_t Capacity>
+template <typename F, typename>
+InlineTask<Capacity>::InlineTask(F&& function)
+{
+    using Target = std::decay_t<F>;
+    static_assert(Fits<Target>, "Callable does not fit into the InlineTask buffer");
+
+    new (m_Storage) Target(std::forward<F>(function));
+    m_Invoke = [](void* storage) { (*static_cast<Target*>(storage))(); };
+    m_Relocate = [](void* destination, void* source)
+    {
+        Target* target = static_cast<Target*>(source);
+        if (destination)
+            new (destination) Target(std::move(*target));
+
+        target->~Target();
+    };
+}
+
+template <size_t Capacity>
+InlineTask<Capacity>::InlineTask(InlineTask&& other) noexcept
+    : m_Invoke(other.m_Invoke)
+    , m_Relocate(other.m_Relocate)
+{
+    if (m_Relocate)
+        m_Relocate(m_Storage, other.m_Storage);
+
+    other.m_Invoke = nullptr;
+    other.m_Relocate = nullptr;
+}
+
+template <size_t Capacity>
+InlineTask<Capacity>::~InlineTask()
+{
+    Reset();
+}
+
+template <size_t Capacity>
+InlineTask<Capacity>& InlineTask<Capacity>::operator=(InlineTask&& other) noexcept
+{
+    if (this != &other)
+    {
+        Reset();
+        if (other.m_Relocate)
+            other.m_Relocate(m_Storage, other.m_Storage);
+
+        m_Invoke = other.m_Invoke;
+        m_Relocate = other.m_Relocate;
+        other.m_Invoke = nullptr;
+        other.m_Relocate = nullptr;
+    }
+
+    return *this;
+}
+
+template <size_t Capacity>
+void InlineTask<Capacity>::Reset()
+{
+    if (m_Relocate)
+        m_Relocate(nullptr, m_Storage);
+
+    m_Invoke = nullptr;
+    m_Relocate = nullptr;
+}
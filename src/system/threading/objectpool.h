@@ -0,0 +1,79 @@
+/*
+    This file is part of Spectre, an open-source physically based
+    spectral raytracing library.
+
+    Copyright (c) 2020-2023 Samuel Van Allen - All rights reserved.
+
+    Spectre is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+// Process-wide pool of fixed-size T slots for objects that are allocated and
+// freed at a high rate from many threads, such as scheduled tasks.
+//
+// Every thread keeps a local free list, so the common Allocate/Free pair never
+// locks. Threads that free more than they allocate (workers running tasks that
+// another thread scheduled) hand surplus slots back to a shared list in
+// batches, which is also where empty threads refill from before new memory is
+// requested from the system. Slots are never returned to the system.
+//
+// Slots start on a cache line and are padded to whole cache lines, so objects
+// used by different threads never share one.
+template <typename T>
+class ObjectPool
+{
+public:
+    template <typename... Args>
+    static T* Allocate(Args&&... args);
+    static void Free(T* object);
+
+    static const int BatchSize = 256;
+
+private:
+    union alignas(64) Slot
+    {
+        Slot* m_Next;
+        alignas(T) unsigned char m_Storage[sizeof(T)];
+    };
+
+    struct Batch
+    {
+        Slot* m_Head;
+        int m_Size;
+    };
+
+    struct SharedList
+    {
+        std::mutex m_Mutex;
+        std::vector<Batch> m_Batches;
+        std::vector<std::unique_ptr<Slot[]>> m_Blocks;
+    };
+
+    struct LocalList
+    {
+        ~LocalList();
+
+        Slot* m_Head = nullptr;
+        int m_Size = 0;
+    };
+
+private:
+    static SharedList& GetSharedList();
+    static LocalList& GetLocalList();
+    static void Refill(LocalList& local);
+    static void Spill(LocalList& local, int numSlots);
+};
+
+#include "objectpool_impl.h"
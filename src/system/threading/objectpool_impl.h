@@ -0,0 +1,127 @@
+/*
+    This file is part of Spectre, an open-source physically based
+    spectral raytracing library.
+
+    Copyright (c) 2020-2023 Samuel Van Allen - All rights reserved.
+
+    Spectre is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+template <typename T>
+template <typename... Args>
+T* ObjectPool<T>::Allocate(Args&&... args)
+{
+    LocalList& local = GetLocalList();
+    if (!local.m_Head)
+        Refill(local);
+
+    Slot* slot = local.m_Head;
+    local.m_Head = slot->m_Next;
+    --local.m_Size;
+
+    try
+    {
+        return new (slot->m_Storage) T(std::forward<Args>(args)...);
+    }
+    catch (...)
+    {
+        slot->m_Next = local.m_Head;
+        local.m_Head = slot;
+        ++local.m_Size;
+        throw;
+    }
+}
+
+template <typename T>
+void ObjectPool<T>::Free(T* object)
+{
+    if (!object)
+        return;
+
+    object->~T();
+
+    LocalList& local = GetLocalList();
+    Slot* slot = reinterpret_cast<Slot*>(object);
+    slot->m_Next = local.m_Head;
+    local.m_Head = slot;
+
+    if (++local.m_Size > 2 * BatchSize)
+        Spill(local, BatchSize);
+}
+
+template <typename T>
+typename ObjectPool<T>::SharedList& ObjectPool<T>::GetSharedList()
+{
+    // Intentionally leaked, thread local lists may still return slots to it
+    // while static objects are being destroyed
+    static SharedList* shared = new SharedList();
+    return *shared;
+}
+
+template <typename T>
+typename ObjectPool<T>::LocalList& ObjectPool<T>::GetLocalList()
+{
+    static thread_local LocalList local;
+    return local;
+}
+
+template <typename T>
+ObjectPool<T>::LocalList::~LocalList()
+{
+    if (m_Head)
+        Spill(*this, m_Size);
+}
+
+template <typename T>
+void ObjectPool<T>::Refill(LocalList& local)
+{
+    SharedList& shared = GetSharedList();
+    std::lock_guard<std::mutex> lock(shared.m_Mutex);
+
+    if (!shared.m_Batches.empty())
+    {
+        Batch batch = shared.m_Batches.back();
+        shared.m_Batches.pop_back();
+        local.m_Head = batch.m_Head;
+        local.m_Size = batch.m_Size;
+        return;
+    }
+
+    shared.m_Blocks.emplace_back(new Slot[BatchSize]);
+    Slot* block = shared.m_Blocks.back().get();
+    for (int i = 0; i + 1 < BatchSize; ++i)
+        block[i].m_Next = &block[i + 1];
+
+    block[BatchSize - 1].m_Next = nullptr;
+    local.m_Head = block;
+    local.m_Size = BatchSize;
+}
+
+template <typename T>
+void ObjectPool<T>::Spill(LocalList& local, int numSlots)
+{
+    Batch batch = { local.m_Head, numSlots };
+
+    Slot* last = local.m_Head;
+    for (int i = 1; i < numSlots; ++i)
+        last = last->m_Next;
+
+    local.m_Head = last->m_Next;
+    local.m_Size -= numSlots;
+    last->m_Next = nullptr;
+
+    SharedList& shared = GetSharedList();
+    std::lock_guard<std::mutex> lock(shared.m_Mutex);
+    shared.m_Batches.push_back(batch);
+}
@@ -0,0 +1,150 @@
+/*
+    This file is part of Spectre, an open-source physically based
+    spectral raytracing library.
+
+    Copyright (c) 2020-2023 Samuel Van Allen - All rights reserved.
+
+    Spectre is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "parallelfor.h"
+
+namespace
+{
+    const int ChunksPerThread = 8;
+}
+
+ParallelForLoop::ParallelForLoop(int64_t begin, int64_t end, int64_t chunkSize, ChunkFunction function, void* body)
+    : m_Begin(begin)
+    , m_End(end)
+    , m_ChunkSize(chunkSize)
+    , m_NumChunks((end - begin + chunkSize - 1) / chunkSize)
+    , m_Function(function)
+    , m_Body(body)
+    , m_NextChunk(0)
+    , m_NumChunksDone(0)
+{
+    if (chunkSize <= 0)
+        throw std::invalid_argument("ParallelFor chunk size must be positive");
+}
+
+void ParallelForLoop::RunChunks()
+{
+    while (true)
+    {
+        int64_t chunk = m_NextChunk.fetch_add(1, std::memory_order_relaxed);
+        if (chunk >= m_NumChunks)
+            return;
+
+        int64_t begin = m_Begin + chunk * m_ChunkSize;
+        int64_t end = std::min(begin + m_ChunkSize, m_End);
+
+        try
+        {
+            m_Function(m_Body, begin, end);
+        }
+        catch (...)
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_ExceptionMutex);
+                if (!m_Exception)
+                    m_Exception = std::current_exception();
+            }
+
+            // Cancel every chunk that has not been claimed yet
+            int64_t firstUnclaimed = m_NextChunk.exchange(m_NumChunks, std::memory_order_relaxed);
+            if (firstUnclaimed < m_NumChunks)
+                FinishChunks(m_NumChunks - firstUnclaimed);
+        }
+
+        FinishChunks(1);
+    }
+}
+
+void ParallelForLoop::Wait()
+{
+    int64_t numDone = m_NumChunksDone.load(std::memory_order_acquire);
+    while (numDone < m_NumChunks)
+    {
+        m_NumChunksDone.wait(numDone, std::memory_order_acquire);
+        numDone = m_NumChunksDone.load(std::memory_order_acquire);
+    }
+
+    if (m_Exception)
+        std::rethrow_exception(m_Exception);
+}
+
+int64_t ParallelForLoop::ComputeChunkSize(int64_t count, int numThreads, int64_t grainSize)
+{
+    if (grainSize < 0)
+        throw std::invalid_argument("ParallelFor grain size cannot be negative");
+
+    int64_t numChunks = std::max<int64_t>(1, (int64_t)numThreads * ChunksPerThread);
+    int64_t chunkSize = (count + numChunks - 1) / numChunks;
+    return std::max<int64_t>({ chunkSize, grainSize, 1 });
+}
+
+void ParallelForLoop::FinishChunks(int64_t numChunks)
+{
+    if (m_NumChunksDone.fetch_add(numChunks, std::memory_order_acq_rel) + numChunks == m_NumChunks)
+        m_NumChunksDone.notify_all();
+}
+
+NumaParallelForLoop::NumaParallelForLoop(std::vector<std::vector<int64_t>> nodeIndices, IndexFunction function, void* body)
+    : m_Nodes(nodeIndices.size())
+{
+    // Every loop points back at its node, so the nodes must not move after this
+    for (size_t i = 0; i < m_Nodes.size(); ++i)
+    {
+        Node& node = m_Nodes[i];
+        node.m_Indices = std::move(nodeIndices[i]);
+        node.m_Function = function;
+        node.m_Body = body;
+        node.m_Loop = std::make_unique<ParallelForLoop>(0, (int64_t)node.m_Indices.size(), 1, &RunIndices, &node);
+    }
+}
+
+void NumaParallelForLoop::RunChunks(int preferredNode)
+{
+    int numNodes = GetNumNodes();
+    for (int i = 0; i < numNodes; ++i)
+        m_Nodes[(preferredNode + i) % numNodes].m_Loop->RunChunks();
+}
+
+void NumaParallelForLoop::Wait()
+{
+    std::exception_ptr exception;
+    for (Node& node : m_Nodes)
+    {
+        try
+        {
+            node.m_Loop->Wait();
+        }
+        catch (...)
+        {
+            if (!exception)
+                exception = std::current_exception();
+        }
+    }
+
+    if (exception)
+        std::rethrow_exception(exception);
+}
+
+void NumaParallelForLoop::RunIndices(void* node, int64_t begin, int64_t end)
+{
+    Node& indices = *static_cast<Node*>(node);
+    for (int64_t i = begin; i < end; ++i)
+        indices.m_Function(indices.m_Body, indices.m_Indices[i]);
+}
@@ -0,0 +1,180 @@
+/*
+    This file is part of Spectre, an open-source physically based
+    spectral raytracing library.
+
+    Copyright (c) 2020-2023 Samuel Van Allen - All rights reserved.
+
+    Spectre is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "threadpool.h"
+
+// Shared state of one ParallelFor call. The range is split into fixed-size
+// chunks that participating threads claim through a single atomic counter, so
+// scheduling a chunk never allocates or takes a lock. Only a handful of helper
+// tasks (at most one per worker) are scheduled per loop.
+class ParallelForLoop
+{
+public:
+    typedef void (*ChunkFunction)(void* body, int64_t begin, int64_t end);
+
+public:
+    ParallelForLoop(int64_t begin, int64_t end, int64_t chunkSize, ChunkFunction function, void* body);
+
+public:
+    void RunChunks();
+    void Wait();
+
+    inline int64_t GetNumChunks() const { return m_NumChunks; }
+
+    // Aims for several chunks per thread so that uneven chunks balance out,
+    // without going below grainSize iterations per chunk
+    static int64_t ComputeChunkSize(int64_t count, int numThreads, int64_t grainSize);
+
+private:
+    void FinishChunks(int64_t numChunks);
+
+private:
+    const int64_t m_Begin;
+    const int64_t m_End;
+    const int64_t m_ChunkSize;
+    const int64_t m_NumChunks;
+
+    ChunkFunction m_Function;
+    void* m_Body;
+
+    std::atomic<int64_t> m_NextChunk;
+    std::atomic<int64_t> m_NumChunksDone;
+
+    std::mutex m_ExceptionMutex;
+    std::exception_ptr m_Exception;
+};
+
+// One ParallelForLoop per NUMA node, each over the iterations assigned to that
+// node. Threads drain their own node's loop before helping the other nodes.
+class NumaParallelForLoop
+{
+public:
+    typedef void (*IndexFunction)(void* body, int64_t index);
+
+public:
+    NumaParallelForLoop(std::vector<std::vector<int64_t>> nodeIndices, IndexFunction function, void* body);
+
+public:
+    void RunChunks(int preferredNode);
+
+    // Waits for every node, then rethrows the first exception of any of them
+    void Wait();
+
+    inline int GetNumNodes() const { return (int)m_Nodes.size(); }
+    inline int64_t GetNumChunks(int node) const { return m_Nodes[node].m_Loop->GetNumChunks(); }
+
+private:
+    static void RunIndices(void* node, int64_t begin, int64_t end);
+
+private:
+    struct Node
+    {
+        std::vector<int64_t> m_Indices;
+        IndexFunction m_Function;
+        void* m_Body;
+        std::unique_ptr<ParallelForLoop> m_Loop;
+    };
+
+    std::vector<Node> m_Nodes;
+};
+
+// Calls body(i) for every i in [begin, end) on pool and the calling thread,
+// handing out chunks of exactly chunkSize iterations, and blocks until all
+// iterations have finished. The first exception thrown by body cancels the
+// remaining chunks and is rethrown here. May be nested inside another loop,
+// the calling thread always works on its own loop.
+template <typename Body>
+void ParallelForChunks(ThreadPool& pool, int64_t begin, int64_t end, int64_t chunkSize, Body&& body)
+{
+    if (begin >= end)
+        return;
+
+    using BodyType = std::remove_reference_t<Body>;
+    ParallelForLoop::ChunkFunction function = [](void* body, int64_t chunkBegin, int64_t chunkEnd)
+    {
+        for (int64_t i = chunkBegin; i < chunkEnd; ++i)
+            (*static_cast<BodyType*>(body))(i);
+    };
+
+    auto loop = std::make_shared<ParallelForLoop>(begin, end, chunkSize, function, (void*)&body);
+
+    // Helpers that only start after the loop has finished find no chunks left
+    // and never touch body, so the loop state is shared but body is not
+    int64_t numHelpers = std::min<int64_t>(pool.GetNumThreads(), loop->GetNumChunks() - 1);
+    for (int64_t i = 0; i < numHelpers; ++i)
+        pool.SpawnTask([loop]() { loop->RunChunks(); });
+
+    loop->RunChunks();
+    loop->Wait();
+}
+
+// Same as ParallelForChunks, but picks the chunk size from the range and thread
+// count. grainSize sets the minimum number of iterations per chunk.
+template <typename Body>
+void ParallelFor(ThreadPool& pool, int64_t begin, int64_t end, Body&& body, int64_t grainSize = 0)
+{
+    int64_t chunkSize = ParallelForLoop::ComputeChunkSize(end - begin, pool.GetNumThreads() + 1, grainSize);
+    ParallelForChunks(pool, begin, end, chunkSize, std::forward<Body>(body));
+}
+
+// Same as ParallelForChunks with a chunk size of one, but every iteration runs
+// preferably on the NUMA node returned by nodeOf(i). Helpers are spawned onto
+// each node and only move on to other nodes once their own has no work left.
+// Meant for large items, such as film tiles, that own memory on one node.
+template <typename NodeOf, typename Body>
+void ParallelForNuma(ThreadPool& pool, int64_t begin, int64_t end, NodeOf&& nodeOf, Body&& body)
+{
+    int numNodes = pool.GetNumNumaNodes();
+    if (numNodes <= 1)
+    {
+        ParallelForChunks(pool, begin, end, 1, std::forward<Body>(body));
+        return;
+    }
+
+    if (begin >= end)
+        return;
+
+    std::vector<std::vector<int64_t>> nodeIndices(numNodes);
+    for (int64_t i = begin; i < end; ++i)
+    {
+        int node = nodeOf(i);
+        nodeIndices[node >= 0 && node < numNodes ? node : 0].push_back(i);
+    }
+
+    using BodyType = std::remove_reference_t<Body>;
+    NumaParallelForLoop::IndexFunction function = [](void* body, int64_t index)
+    {
+        (*static_cast<BodyType*>(body))(index);
+    };
+
+    auto loop = std::make_shared<NumaParallelForLoop>(std::move(nodeIndices), function, (void*)&body);
+
+    for (int node = 0; node < numNodes; ++node)
+    {
+        int64_t numHelpers = std::min<int64_t>(pool.GetNumWorkersOnNode(node), loop->GetNumChunks(node));
+        for (int64_t i = 0; i < numHelpers; ++i)
+            pool.SpawnTaskOnNode(node, [loop, node]() { loop->RunChunks(node); });
+    }
+
+    loop->RunChunks(pool.GetCurrentNumaNode());
+    loop->Wait();
+}
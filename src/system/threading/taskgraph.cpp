@@ -0,0 +1,212 @@
+/*
+    This file is part of Spectre, an open-source physically based
+    spectral raytracing library.
+
+    Copyright (c) 2020-2023 Samuel Van Allen - All rights reserved.
+
+    Spectre is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "taskgraph.h"
+#include <utility>
+
+TaskGraph::NodeId TaskGraph::AddNode(std::function<void()> task, std::initializer_list<NodeId> dependencies)
+{
+    if (!task)
+        throw std::invalid_argument("Task graph nodes need a task");
+
+    NodeId id = (NodeId)m_Nodes.size();
+    m_Nodes.push_back(std::make_unique<Node>());
+    m_Nodes.back()->m_Task = std::move(task);
+
+    for (NodeId dependency : dependencies)
+        AddDependency(dependency, id);
+
+    return id;
+}
+
+void TaskGraph::AddDependency(NodeId dependency, NodeId dependant)
+{
+    if (dependency < 0 || dependency >= GetNumNodes() || dependant < 0 || dependant >= GetNumNodes())
+        throw std::invalid_argument("Task graph dependency refers to an unknown node");
+
+    if (dependency == dependant)
+        throw std::invalid_argument("Task graph node cannot depend on itself");
+
+    m_Nodes[dependency]->m_Dependants.push_back(dependant);
+    m_Nodes[dependant]->m_NumDependencies++;
+}
+
+void TaskGraph::Run(ThreadPool& pool)
+{
+    if (pool.IsWorkerThread())
+        throw std::runtime_error("TaskGraph cannot be run from a worker of the same ThreadPool");
+
+    ValidateAcyclic();
+    if (m_Nodes.empty())
+        return;
+
+    m_Exception = nullptr;
+    m_Done = false;
+    m_Discarded = false;
+    m_NumTasksLeft = 1;
+    for (const std::unique_ptr<Node>& node : m_Nodes)
+    {
+        node->m_NumPendingDependencies = node->m_NumDependencies;
+        node->m_Skip = false;
+    }
+
+    try
+    {
+        for (NodeId id = 0; id < GetNumNodes(); ++id)
+            if (m_Nodes[id]->m_NumDependencies == 0)
+                Schedule(pool, id);
+    }
+    catch (...)
+    {
+        // The pool was stopped, roots spawned before still have to settle
+        std::lock_guard<std::mutex> lock(m_ExceptionMutex);
+        if (!m_Exception)
+            m_Exception = std::current_exception();
+    }
+
+    FinishTask();
+    {
+        std::unique_lock<std::mutex> lock(m_DoneMutex);
+        m_DoneCondition.wait(lock, [this] { return m_Done; });
+    }
+
+    if (m_Exception)
+        std::rethrow_exception(m_Exception);
+
+    if (m_Discarded)
+        throw std::runtime_error("TaskGraph nodes were discarded by the ThreadPool");
+}
+
+void TaskGraph::ValidateAcyclic() const
+{
+    // Kahn's algorithm, every node is reachable from a root unless it is on a cycle
+    std::vector<int> numDependencies(m_Nodes.size());
+    std::vector<NodeId> ready;
+    for (NodeId id = 0; id < GetNumNodes(); ++id)
+    {
+        numDependencies[id] = m_Nodes[id]->m_NumDependencies;
+        if (numDependencies[id] == 0)
+            ready.push_back(id);
+    }
+
+    int numVisited = 0;
+    while (!ready.empty())
+    {
+        NodeId id = ready.back();
+        ready.pop_back();
+        ++numVisited;
+
+        for (NodeId dependant : m_Nodes[id]->m_Dependants)
+            if (--numDependencies[dependant] == 0)
+                ready.push_back(dependant);
+    }
+
+    if (numVisited != GetNumNodes())
+        throw std::invalid_argument("Task graph contains a cycle");
+}
+
+void TaskGraph::Schedule(ThreadPool& pool, NodeId id)
+{
+    ++m_NumTasksLeft;
+    pool.SpawnTask(NodeTask(*this, pool, id));
+}
+
+void TaskGraph::RunNode(ThreadPool& pool, NodeId id)
+{
+    Node& node = *m_Nodes[id];
+    bool failed = node.m_Skip;
+
+    if (!failed)
+    {
+        try
+        {
+            node.m_Task();
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock(m_ExceptionMutex);
+            if (!m_Exception)
+                m_Exception = std::current_exception();
+
+            failed = true;
+        }
+    }
+
+    CompleteNode(pool, id, failed);
+}
+
+void TaskGraph::CompleteNode(ThreadPool& pool, NodeId id, bool failed)
+{
+    // Skipped nodes still pass through the pool so that a long chain of
+    // dependants cannot recurse arbitrarily deep here
+    for (NodeId dependant : m_Nodes[id]->m_Dependants)
+    {
+        Node& node = *m_Nodes[dependant];
+        if (failed)
+            node.m_Skip = true;
+
+        if (--node.m_NumPendingDependencies == 0)
+            Schedule(pool, dependant);
+    }
+}
+
+void TaskGraph::FinishTask()
+{
+    // Dependants are spawned before the task that spawns them finishes, so the
+    // count only drops to zero once nothing can be spawned anymore
+    if (--m_NumTasksLeft == 0)
+    {
+        std::lock_guard<std::mutex> lock(m_DoneMutex);
+        m_Done = true;
+        m_DoneCondition.notify_all();
+    }
+}
+
+TaskGraph::NodeTask::NodeTask(TaskGraph& graph, ThreadPool& pool, NodeId id)
+    : m_Graph(&graph)
+    , m_Pool(&pool)
+    , m_Id(id)
+{
+}
+
+TaskGraph::NodeTask::NodeTask(NodeTask&& other) noexcept
+    : m_Graph(std::exchange(other.m_Graph, nullptr))
+    , m_Pool(other.m_Pool)
+    , m_Id(other.m_Id)
+{
+}
+
+TaskGraph::NodeTask::~NodeTask()
+{
+    // Only a task that never ran, because the pool discarded or refused it,
+    // still refers to the graph here
+    if (m_Graph != nullptr)
+    {
+        m_Graph->m_Discarded = true;
+        m_Graph->FinishTask();
+    }
+}
+
+void TaskGraph::NodeTask::operator()()
+{
+    TaskGraph* graph = std::exchange(m_Graph, nullptr);
+    graph->RunNode(*m_Pool, m_Id);
+    graph->FinishTask();
+}
@@ -0,0 +1,113 @@
+/*
+    This file is part of Spectre, an open-source physically based
+    spectral raytracing library.
+
+    Copyright (c) 2020-2023 Samuel Van Allen - All rights reserved.
+
+    Spectre is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "threadpool.h"
+
+// A DAG of tasks executed on a ThreadPool. Every node is spawned as soon as
+// all of its dependencies have completed, so independent chains (e.g. exporting
+// frame N while frame N+1 renders) overlap instead of waiting for a global
+// barrier between stages.
+//
+// If a node throws, the nodes depending on it are skipped, unrelated nodes
+// still run, and Run rethrows the first exception once the graph has settled.
+class TaskGraph
+{
+public:
+    typedef int NodeId;
+
+public:
+    TaskGraph() = default;
+    ~TaskGraph() = default;
+
+    TaskGraph(const TaskGraph&) = delete;
+    TaskGraph& operator=(const TaskGraph&) = delete;
+
+public:
+    NodeId AddNode(std::function<void()> task, std::initializer_list<NodeId> dependencies = {});
+    void AddDependency(NodeId dependency, NodeId dependant);
+
+    // Runs every node once and blocks until all of them have completed or were
+    // skipped. A graph can be run again after it has completed. Must not be
+    // called from one of the pool's own workers. A paused pool holds Run until
+    // it is resumed, and if the pool discards any of the nodes instead of
+    // running them, Run throws once the remaining nodes have settled.
+    void Run(ThreadPool& pool);
+
+public:
+    inline int GetNumNodes() const { return (int)m_Nodes.size(); }
+
+private:
+    void ValidateAcyclic() const;
+    void Schedule(ThreadPool& pool, NodeId id);
+    void RunNode(ThreadPool& pool, NodeId id);
+    void CompleteNode(ThreadPool& pool, NodeId id, bool failed);
+    void FinishTask();
+
+private:
+    struct Node
+    {
+        std::function<void()> m_Task;
+        std::vector<NodeId> m_Dependants;
+        int m_NumDependencies = 0;
+
+        std::atomic_int m_NumPendingDependencies = 0;
+        std::atomic_bool m_Skip = false;
+    };
+
+    // Pool task running a single node. A task the pool discards is destroyed
+    // without running, which is reported to the graph so that Run returns.
+    class NodeTask
+    {
+    public:
+        NodeTask(TaskGraph& graph, ThreadPool& pool, NodeId id);
+        NodeTask(NodeTask&& other) noexcept;
+        ~NodeTask();
+
+        NodeTask(const NodeTask&) = delete;
+        NodeTask& operator=(const NodeTask&) = delete;
+
+    public:
+        void operator()();
+
+    private:
+        TaskGraph* m_Graph;
+        ThreadPool* m_Pool;
+        NodeId m_Id;
+    };
+
+private:
+    std::vector<std::unique_ptr<Node>> m_Nodes;
+
+    // Pool tasks that have been spawned but neither run nor discarded yet. Run
+    // holds one count of its own while it spawns the roots.
+    std::atomic_int m_NumTasksLeft = 0;
+    std::atomic_bool m_Discarded = false;
+
+    // Completion is signalled under a lock so that Run cannot return, and the
+    // graph be destroyed, while the last node is still signalling
+    std::mutex m_DoneMutex;
+    std::condition_variable m_DoneCondition;
+    bool m_Done = false;
+
+    std::mutex m_ExceptionMutex;
+    std::exception_ptr m_Exception;
+};
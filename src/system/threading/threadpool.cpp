@@ -20,44 +20,372 @@
 
 #include "threadpool.h"
 
-ThreadPool::ThreadPool(int numThreads)
+namespace
+{
+    // Lets SpawnTask tell a pool's own workers apart from outside threads
+    thread_local ThreadPool* currentPool = nullptr;
+    thread_local int currentWorkerIndex = -1;
+
+    // Rounds of failed stealing before an idle worker goes to sleep
+    const int NumStealRounds = 4;
+}
+
+ThreadPool::ThreadPool(int numThreads, SchedulingMode mode)
+    : ThreadPool(numThreads, mode, AffinityPolicy::None, CpuTopology())
+{
+}
+
+ThreadPool::ThreadPool(int numThreads, SchedulingMode mode, AffinityPolicy affinity, const CpuTopology& topology)
     : m_Stop(false)
+    , m_Paused(false)
+    , m_Discard(false)
+    , m_Mode(mode)
+    , m_Affinity(affinity)
+    , m_Placement(topology.SelectCpus(affinity, std::max(numThreads, 0)))
+    , m_NumQueuedTasks(0)
+    , m_NumUnfinishedTasks(0)
+    , m_NumPriorityTasks(0)
+    , m_NumSleepingWorkers(0)
+    , m_NextInbox(0)
+    , m_NumRunningTasks(0)
+    , m_NumFinishedTasks(0)
+    , m_NumCancelledTasks(0)
 {
+    if (m_Mode == SchedulingMode::WorkStealing)
+    {
+        if (numThreads <= 0)
+            throw std::invalid_argument("Work stealing needs at least one worker thread");
+
+        // The node of an unpinned worker is unknown, so they all count as node 0
+        m_NodeWorkers.resize(m_Placement.empty() ? 1 : topology.GetNumNumaNodes());
+
+        for (int i = 0; i < numThreads; ++i)
+        {
+            int numaNode = m_Placement.empty() ? 0 : m_Placement[i].m_NumaNode;
+            m_Workers.push_back(std::make_unique<Worker>(i, numaNode));
+            m_NodeWorkers[numaNode].push_back(i);
+        }
+
+        for (int i = 0; i < numThreads; ++i)
+            m_Threads.emplace_back([this, i] { PinWorker(i); WorkStealingMain(i); });
+
+        return;
+    }
+
+    m_NodeWorkers.resize(1);
+
     for (int i = 0; i < numThreads; ++i)
     {
-        m_Threads.emplace_back([this] { ThreadMain(*this); });
+        m_NodeWorkers[0].push_back(i);
+        m_Threads.emplace_back([this, i] { PinWorker(i); ThreadMain(*this); });
     }
 }
 
 ThreadPool::~ThreadPool()
 {
-    m_Stop = true;
+    Shutdown(ShutdownMode::Drain);
+}
+
+void ThreadPool::Shutdown(ShutdownMode mode)
+{
+    if (IsWorkerThread())
+        throw std::runtime_error("A ThreadPool cannot be shut down from one of its own workers");
+
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        if (mode == ShutdownMode::Discard)
+            m_Discard = true;
+
+        m_Stop = true;
+        m_Paused = false;
+    }
+
     m_Condition.notify_all();
 
     for (std::thread& thread : m_Threads)
-        thread.join();
+    {
+        if (thread.joinable())
+            thread.join();
+    }
+
+    // Only a pool without threads can be left with unstarted tasks
+    while (!m_Tasks.empty())
+    {
+        ObjectPool<Task>::Free(m_Tasks.top().m_Task);
+        m_Tasks.pop();
+        --m_NumQueuedTasks;
+        ++m_NumCancelledTasks;
+        ++m_NumFinishedTasks;
+        FinishTask();
+    }
+}
+
+void ThreadPool::Pause()
+{
+    m_Paused = true;
+}
+
+void ThreadPool::Resume()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Paused = false;
+    }
+
+    m_Condition.notify_all();
+}
+
+ThreadPoolProgress ThreadPool::GetProgress() const
+{
+    return { m_NumQueuedTasks, m_NumRunningTasks, m_NumFinishedTasks, m_NumCancelledTasks };
+}
+
+bool ThreadPool::IsWorkerThread() const
+{
+    return currentPool == this;
+}
+
+int ThreadPool::GetCurrentNumaNode() const
+{
+    if (!IsWorkerThread() || m_Mode != SchedulingMode::WorkStealing)
+        return 0;
+
+    return m_Workers[currentWorkerIndex]->m_NumaNode;
+}
+
+int ThreadPool::GetNumWorkersOnNode(int numaNode) const
+{
+    if (numaNode < 0 || numaNode >= GetNumNumaNodes())
+        throw std::invalid_argument("ThreadPool has no NUMA node " + std::to_string(numaNode));
+
+    return (int)m_NodeWorkers[numaNode].size();
+}
+
+void ThreadPool::PinWorker(int workerIndex)
+{
+    // Pinning is best effort, an unpinned worker still runs correctly
+    if (!m_Placement.empty())
+        CpuTopology::PinCurrentThread(m_Placement[workerIndex].m_Id);
 }
 
 void ThreadPool::ThreadMain(ThreadPool& pool)
 {
+    currentPool = this;
+
     while (true)
     {
         std::unique_lock<std::mutex> lock(m_Mutex);
-        m_Condition.wait(lock, [&pool] { return pool.m_Stop || !pool.m_Tasks.empty(); });
+        m_Condition.wait(lock, [&pool] { return pool.m_Stop || (!pool.m_Paused && !pool.m_Tasks.empty()); });
 
         if (ShouldStop() && !HasTasksLeft())
             return;
 
-        auto nextTask = pool.PopNextTask();
+        Task* nextTask = pool.PopNextTask();
         lock.unlock();
 
-        nextTask();
+        RunTask(nextTask);
     }
 }
 
-std::function<void()> ThreadPool::PopNextTask()
+ThreadPool::Task* ThreadPool::PopNextTask()
 {
-    auto nextTask = m_Tasks.top().m_Task;
+    Task* nextTask = m_Tasks.top().m_Task;
     m_Tasks.pop();
+    --m_NumQueuedTasks;
+    --m_NumPriorityTasks;
     return nextTask;
 }
+
+void ThreadPool::RunTask(Task* task)
+{
+    if (m_Discard)
+    {
+        ++m_NumCancelledTasks;
+    }
+    else
+    {
+        ++m_NumRunningTasks;
+        (*task)();
+        --m_NumRunningTasks;
+    }
+
+    ObjectPool<Task>::Free(task);
+    ++m_NumFinishedTasks;
+    FinishTask();
+}
+
+void ThreadPool::WorkStealingMain(int workerIndex)
+{
+    currentPool = this;
+    currentWorkerIndex = workerIndex;
+    Worker& worker = *m_Workers[workerIndex];
+
+    while (true)
+    {
+        if (!m_Paused)
+        {
+            if (Task* task = FindTask(worker))
+            {
+                RunTask(task);
+                continue;
+            }
+        }
+
+        if (ShouldStop() && !HasTasksLeft())
+            return;
+
+        WaitForTasks();
+    }
+}
+
+void ThreadPool::PushTask(Task* task, int numaNode)
+{
+    ++m_NumUnfinishedTasks;
+    ++m_NumQueuedTasks;
+
+    if (IsWorkerThread() && (numaNode < 0 || m_Workers[currentWorkerIndex]->m_NumaNode == numaNode))
+    {
+        m_Workers[currentWorkerIndex]->m_Deque.Push(task);
+    }
+    else
+    {
+        if (m_Stop && !IsWorkerThread())
+        {
+            --m_NumQueuedTasks;
+            --m_NumUnfinishedTasks;
+            ObjectPool<Task>::Free(task);
+            throw std::runtime_error("Task enqueued on a stopped ThreadPool!");
+        }
+
+        // A node without workers of its own leaves the task to any worker
+        unsigned int next = m_NextInbox++;
+        bool hasNodeWorkers = numaNode >= 0 && !m_NodeWorkers[numaNode].empty();
+        int workerIndex = hasNodeWorkers ? m_NodeWorkers[numaNode][next % m_NodeWorkers[numaNode].size()] : next % m_Workers.size();
+
+        Worker& worker = *m_Workers[workerIndex];
+        std::lock_guard<std::mutex> lock(worker.m_InboxMutex);
+        worker.m_Inbox.push_back(task);
+        ++worker.m_InboxSize;
+    }
+
+    NotifyWorker();
+}
+
+ThreadPool::Task* ThreadPool::FindTask(Worker& worker)
+{
+    Task* task = nullptr;
+    if (worker.m_Deque.Pop(task))
+    {
+        --m_NumQueuedTasks;
+        return task;
+    }
+
+    if (m_NumPriorityTasks > 0)
+    {
+        std::unique_lock<std::mutex> lock(m_Mutex);
+        if (!m_Tasks.empty())
+            return PopNextTask();
+    }
+
+    // Move the whole inbox onto the deque so that other workers can steal from it
+    if (worker.m_InboxSize > 0)
+    {
+        std::lock_guard<std::mutex> lock(worker.m_InboxMutex);
+        for (Task* inboxTask : worker.m_Inbox)
+            worker.m_Deque.Push(inboxTask);
+
+        worker.m_Inbox.clear();
+        worker.m_InboxSize = 0;
+    }
+
+    if (worker.m_Deque.Pop(task))
+    {
+        --m_NumQueuedTasks;
+        return task;
+    }
+
+    return StealTask(worker);
+}
+
+ThreadPool::Task* ThreadPool::StealTask(Worker& thief)
+{
+    int numWorkers = (int)m_Workers.size();
+    if (numWorkers <= 1)
+        return nullptr;
+
+    // Tasks of workers on the same node are more likely to work on memory local
+    // to the thief, so those are tried first on multi node pools
+    const std::vector<int>& neighbours = m_NodeWorkers[thief.m_NumaNode];
+    int numNeighbourRounds = GetNumNumaNodes() > 1 ? NumStealRounds * (int)neighbours.size() : 0;
+    int numRounds = numNeighbourRounds + NumStealRounds * numWorkers;
+
+    Task* task = nullptr;
+    for (int round = 0; round < numRounds; ++round)
+    {
+        int victimIndex = round < numNeighbourRounds ? neighbours[thief.m_Random() % neighbours.size()] : thief.m_Random() % numWorkers;
+        Worker& victim = *m_Workers[victimIndex];
+        if (&victim == &thief)
+            continue;
+
+        if (victim.m_Deque.Steal(task))
+        {
+            --m_NumQueuedTasks;
+            return task;
+        }
+
+        // The victim may be stuck in a long task with work still in its inbox
+        if (victim.m_InboxSize > 0)
+        {
+            std::unique_lock<std::mutex> lock(victim.m_InboxMutex, std::try_to_lock);
+            if (lock.owns_lock() && !victim.m_Inbox.empty())
+            {
+                task = victim.m_Inbox.front();
+                victim.m_Inbox.pop_front();
+                --victim.m_InboxSize;
+                --m_NumQueuedTasks;
+                return task;
+            }
+        }
+    }
+
+    return nullptr;
+}
+
+void ThreadPool::WaitForTasks()
+{
+    // m_NumSleepingWorkers is raised before re-checking for tasks, and pushers
+    // raise m_NumQueuedTasks before checking for sleepers, so either the worker
+    // sees the task or the pusher sees the sleeper
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    ++m_NumSleepingWorkers;
+    m_Condition.wait(lock, [this] { return m_Stop || (!m_Paused && m_NumQueuedTasks > 0); });
+    --m_NumSleepingWorkers;
+}
+
+void ThreadPool::NotifyWorker()
+{
+    if (m_NumSleepingWorkers > 0)
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Condition.notify_one();
+    }
+}
+
+void ThreadPool::FinishTask()
+{
+    if (--m_NumUnfinishedTasks == 0)
+        m_NumUnfinishedTasks.notify_all();
+}
+
+void ThreadPool::WaitAll()
+{
+    if (IsWorkerThread())
+        throw std::runtime_error("WaitAll cannot be called from a worker of the same ThreadPool");
+
+    int numUnfinished = m_NumUnfinishedTasks;
+    while (numUnfinished > 0)
+    {
+        m_NumUnfinishedTasks.wait(numUnfinished);
+        numUnfinished = m_NumUnfinishedTasks;
+    }
+}
@@ -21,36 +21,177 @@
 #pragma once
 
 #include <condition_variable>
+#include <deque>
 #include <future>
 #include <queue>
+#include <random>
+
+#include "workstealingdeque.h"
+#include "inlinetask.h"
+#include "objectpool.h"
+#include "cancellationtoken.h"
+#include "system/platform/cputopology.h"
+
+enum class SchedulingMode
+{
+    // All tasks go through one mutex protected priority queue. Tasks start in
+    // strict priority order, but every schedule and pop contends on one lock.
+    GlobalPriority,
+
+    // Every worker owns a Chase-Lev deque and steals from random victims once
+    // it runs dry. Prioritized tasks keep their ordering through a global lane,
+    // which workers check after their own deque.
+    WorkStealing
+};
+
+enum class ShutdownMode
+{
+    // Every queued task still runs before the workers exit
+    Drain,
+
+    // Queued tasks are released without running, only running tasks finish
+    Discard
+};
+
+// Snapshot of the pool's counters, cheap enough to poll from a UI or log
+struct ThreadPoolProgress
+{
+    int m_NumQueued;
+    int m_NumRunning;
+
+    // Tasks that left the pool, including the cancelled ones
+    int64_t m_NumFinished;
+    int64_t m_NumCancelled;
+};
 
 class ThreadPool
 {
 public:
-    ThreadPool(int numThreads);
+    ThreadPool(int numThreads, SchedulingMode mode = SchedulingMode::GlobalPriority);
+
+    // Pins every worker to a logical CPU of topology chosen by affinity. Under
+    // work stealing, workers also remember their NUMA node, so that tasks can
+    // be spawned onto a node and idle workers steal from their own node first.
+    ThreadPool(int numThreads, SchedulingMode mode, AffinityPolicy affinity, const CpuTopology& topology = CpuTopology::Detect());
     ~ThreadPool();
 
-    template <typename Task, typename... Args>
-    void ScheduleTask(double priority, Task&& task, Args&&... args);
+    template <typename Function, typename... Args>
+    void ScheduleTask(double priority, Function&& function, Args&&... args);
+
+    // Schedules a task without a priority. Under work stealing, tasks spawned
+    // from a worker go to that worker's own deque, and tasks spawned from other
+    // threads are spread over the workers' inboxes. Never takes the global lock.
+    template <typename Function, typename... Args>
+    void SpawnTask(Function&& function, Args&&... args);
+
+    // Same as SpawnTask, but hands the task to a worker pinned to the given
+    // NUMA node, so that it runs close to the memory it works on. The task may
+    // still be stolen by another node once that node runs out of work.
+    template <typename Function, typename... Args>
+    void SpawnTaskOnNode(int numaNode, Function&& function, Args&&... args);
+
+    // Same as ScheduleTask and SpawnTask, but the returned future yields the
+    // task's result or rethrows its exception
+    template <typename Function, typename... Args>
+    auto ScheduleFuture(double priority, Function&& function, Args&&... args);
+    template <typename Function, typename... Args>
+    auto SpawnFuture(Function&& function, Args&&... args);
+
+    // Same as ScheduleTask and SpawnTask, but the task is skipped if token has
+    // been cancelled by the time a worker picks it up. Long tasks should also
+    // check the token themselves to stop early.
+    template <typename Function, typename... Args>
+    void ScheduleCancellableTask(const CancellationToken& token, double priority, Function&& function, Args&&... args);
+    template <typename Function, typename... Args>
+    void SpawnCancellableTask(const CancellationToken& token, Function&& function, Args&&... args);
+
+    // Blocks until every scheduled task, including tasks scheduled by running
+    // tasks, has finished. Acts as a barrier between stages of work, and must
+    // not be called from one of the pool's own workers.
+    void WaitAll();
+
+    // Workers finish their running tasks and then leave queued tasks alone
+    // until the pool is resumed. WaitAll blocks for as long as the pool is
+    // paused with tasks left.
+    void Pause();
+    void Resume();
+
+    // Stops the pool and joins its workers, after running or discarding the
+    // queued tasks. Tasks can no longer be scheduled from outside the pool
+    // afterwards. The destructor drains the pool unless it was shut down.
+    void Shutdown(ShutdownMode mode = ShutdownMode::Drain);
 
 public:
-    inline bool HasTasksLeft() const { return !m_Tasks.empty(); }
+    inline bool HasTasksLeft() const { return m_NumQueuedTasks > 0; }
     inline bool ShouldStop() const { return m_Stop; }
+    inline bool IsPaused() const { return m_Paused; }
+    inline SchedulingMode GetSchedulingMode() const { return m_Mode; }
+    inline int GetNumThreads() const { return (int)m_Threads.size(); }
+    inline AffinityPolicy GetAffinityPolicy() const { return m_Affinity; }
+
+    // Pools without affinity, or in global priority mode, report a single node
+    inline int GetNumNumaNodes() const { return (int)m_NodeWorkers.size(); }
+    int GetNumWorkersOnNode(int numaNode) const;
+
+    bool IsWorkerThread() const;
+    ThreadPoolProgress GetProgress() const;
+
+    // NUMA node of the calling worker, 0 for threads outside the pool
+    int GetCurrentNumaNode() const;
+
+public:
+    // Tasks are stored inline in pooled, cache line sized nodes. Callables
+    // with larger captures are boxed on the heap instead.
+    static const size_t TaskCapacity = 48;
+    typedef InlineTask<TaskCapacity> Task;
 
 private:
+    struct Worker
+    {
+        Worker(int index, int numaNode) : m_NumaNode(numaNode), m_Random(index + 1) {}
+
+        WorkStealingDeque<Task*> m_Deque;
+
+        // Tasks spawned from outside the pool, only the owner may push to its deque
+        std::mutex m_InboxMutex;
+        std::deque<Task*> m_Inbox;
+        std::atomic_int m_InboxSize = 0;
+
+        const int m_NumaNode;
+        std::minstd_rand m_Random;
+    };
+
+private:
+    void PinWorker(int workerIndex);
     void ThreadMain(ThreadPool& pool);
-    std::function<void()> PopNextTask();
+    void WorkStealingMain(int workerIndex);
+    Task* PopNextTask();
+    void RunTask(Task* task);
+
+    void PushTask(Task* task, int numaNode = -1);
+    Task* FindTask(Worker& worker);
+    Task* StealTask(Worker& thief);
+    void WaitForTasks();
+    void NotifyWorker();
+    void FinishTask();
+
+    template <typename Function, typename... Args>
+    static auto BindTask(Function&& function, Args&&... args);
+    template <typename Function, typename... Args>
+    auto BindCancellableTask(const CancellationToken& token, Function&& function, Args&&... args);
+    template <typename Function, typename... Args>
+    static Task* CreateTask(Function&& function, Args&&... args);
 
 private:
     struct ThreadTask
     {
-        ThreadTask(double priority, std::function<void()> task)
+        ThreadTask(double priority, Task* task)
             : m_Task(task)
             , m_Priority(priority) {}
 
         inline bool operator<(const ThreadTask& t) const { return t.m_Priority > m_Priority; }
 
-        std::function<void()> m_Task;
+        Task* m_Task;
         double m_Priority;
     };
 
@@ -61,18 +202,124 @@ private:
     std::condition_variable m_Condition;
     std::vector<std::thread> m_Threads;
     std::atomic_bool m_Stop;
+    std::atomic_bool m_Paused;
+    std::atomic_bool m_Discard;
+
+    SchedulingMode m_Mode;
+    AffinityPolicy m_Affinity;
+    std::vector<LogicalCpu> m_Placement;
+    std::vector<std::unique_ptr<Worker>> m_Workers;
+
+    // Indices of the workers on every NUMA node
+    std::vector<std::vector<int>> m_NodeWorkers;
+    std::atomic_int m_NumQueuedTasks;
+    std::atomic_int m_NumUnfinishedTasks;
+    std::atomic_int m_NumPriorityTasks;
+    std::atomic_int m_NumSleepingWorkers;
+    std::atomic_uint m_NextInbox;
+
+    std::atomic_int m_NumRunningTasks;
+    std::atomic<int64_t> m_NumFinishedTasks;
+    std::atomic<int64_t> m_NumCancelledTasks;
 };
 
-template <typename Task, typename... Args>
-void ThreadPool::ScheduleTask(double priority, Task&& task, Args&&... args)
+template <typename Function, typename... Args>
+auto ThreadPool::BindTask(Function&& function, Args&&... args)
+{
+    return [function = std::forward<Function>(function), ...args = std::forward<Args>(args)]() mutable { return function(args...); };
+}
+
+template <typename Function, typename... Args>
+auto ThreadPool::BindCancellableTask(const CancellationToken& token, Function&& function, Args&&... args)
+{
+    return [this, token, task = BindTask(std::forward<Function>(function), std::forward<Args>(args)...)]() mutable
+    {
+        if (token.IsCancelled())
+            ++m_NumCancelledTasks;
+        else
+            task();
+    };
+}
+
+template <typename Function, typename... Args>
+ThreadPool::Task* ThreadPool::CreateTask(Function&& function, Args&&... args)
+{
+    auto bound = BindTask(std::forward<Function>(function), std::forward<Args>(args)...);
+    using Bound = decltype(bound);
+
+    if constexpr (Task::Fits<Bound>)
+        return ObjectPool<Task>::Allocate(std::move(bound));
+    else
+        return ObjectPool<Task>::Allocate([boxed = std::make_unique<Bound>(std::move(bound))]() { (*boxed)(); });
+}
+
+template <typename Function, typename... Args>
+void ThreadPool::ScheduleTask(double priority, Function&& function, Args&&... args)
 {
     std::unique_lock<std::mutex> lock(m_Mutex);
 
-    if (m_Stop)
+    // Running tasks may still schedule follow-up work while the pool drains
+    if (m_Stop && !IsWorkerThread())
         throw std::runtime_error("Task enqueued on a stopped ThreadPool!");
 
-    auto taskFunc = [=]() { task(args...); };
-    m_Tasks.emplace(priority, taskFunc);
+    m_Tasks.emplace(priority, CreateTask(std::forward<Function>(function), std::forward<Args>(args)...));
+    ++m_NumQueuedTasks;
+    ++m_NumUnfinishedTasks;
+    ++m_NumPriorityTasks;
     m_Condition.notify_one();
 }
 
+template <typename Function, typename... Args>
+void ThreadPool::SpawnTask(Function&& function, Args&&... args)
+{
+    if (m_Mode == SchedulingMode::GlobalPriority)
+        ScheduleTask(0, std::forward<Function>(function), std::forward<Args>(args)...);
+    else
+        PushTask(CreateTask(std::forward<Function>(function), std::forward<Args>(args)...));
+}
+
+template <typename Function, typename... Args>
+void ThreadPool::SpawnTaskOnNode(int numaNode, Function&& function, Args&&... args)
+{
+    if (numaNode < 0 || numaNode >= GetNumNumaNodes())
+        throw std::invalid_argument("ThreadPool has no NUMA node " + std::to_string(numaNode));
+
+    if (m_Mode == SchedulingMode::GlobalPriority)
+        ScheduleTask(0, std::forward<Function>(function), std::forward<Args>(args)...);
+    else
+        PushTask(CreateTask(std::forward<Function>(function), std::forward<Args>(args)...), numaNode);
+}
+
+template <typename Function, typename... Args>
+void ThreadPool::ScheduleCancellableTask(const CancellationToken& token, double priority, Function&& function, Args&&... args)
+{
+    ScheduleTask(priority, BindCancellableTask(token, std::forward<Function>(function), std::forward<Args>(args)...));
+}
+
+template <typename Function, typename... Args>
+void ThreadPool::SpawnCancellableTask(const CancellationToken& token, Function&& function, Args&&... args)
+{
+    SpawnTask(BindCancellableTask(token, std::forward<Function>(function), std::forward<Args>(args)...));
+}
+
+template <typename Function, typename... Args>
+auto ThreadPool::ScheduleFuture(double priority, Function&& function, Args&&... args)
+{
+    using Result = std::invoke_result_t<std::decay_t<Function>&, std::decay_t<Args>&...>;
+
+    std::packaged_task<Result()> packagedTask(BindTask(std::forward<Function>(function), std::forward<Args>(args)...));
+    std::future<Result> future = packagedTask.get_future();
+    ScheduleTask(priority, std::move(packagedTask));
+    return future;
+}
+
+template <typename Function, typename... Args>
+auto ThreadPool::SpawnFuture(Function&& function, Args&&... args)
+{
+    using Result = std::invoke_result_t<std::decay_t<Function>&, std::decay_t<Args>&...>;
+
+    std::packaged_task<Result()> packagedTask(BindTask(std::forward<Function>(function), std::forward<Args>(args)...));
+    std::future<Result> future = packagedTask.get_future();
+    SpawnTask(std::move(packagedTask));
+    return future;
+}
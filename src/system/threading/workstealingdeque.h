@@ -0,0 +1,76 @@
+/*
+    This file is part of Spectre, an open-source physically based
+    spectral raytracing library.
+
+    Copyright (c) 2020-2023 Samuel Van Allen - All rights reserved.
+
+    Spectre is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <atomic>
+
+// Chase-Lev work-stealing deque, using the C11 memory model formulation from
+// "Correct and Efficient Work-Stealing for Weak Memory Models", Le et al. (2013).
+//
+// Only the owning thread may Push and Pop, which work on the bottom end in LIFO
+// order. Any thread may Steal from the top end. The buffer grows on demand, and
+// replaced buffers are kept alive until destruction because a concurrent thief
+// may still be reading from them.
+template <typename T>
+class WorkStealingDeque
+{
+    static_assert(std::is_trivially_copyable_v<T>, "Work-stealing deque items must be trivially copyable");
+
+public:
+    WorkStealingDeque(int64_t capacity = 256);
+    ~WorkStealingDeque();
+
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+public:
+    void Push(T item);
+    bool Pop(T& item);
+    bool Steal(T& item);
+
+public:
+    inline int64_t GetSize() const;
+    inline bool IsEmpty() const { return GetSize() <= 0; }
+
+private:
+    struct Buffer
+    {
+        Buffer(int64_t capacity);
+
+        inline T Get(int64_t i) const { return m_Items[i & m_Mask].load(std::memory_order_relaxed); }
+        inline void Put(int64_t i, T item) { m_Items[i & m_Mask].store(item, std::memory_order_relaxed); }
+        Buffer* Grow(int64_t top, int64_t bottom) const;
+
+        int64_t m_Capacity;
+        int64_t m_Mask;
+        std::unique_ptr<std::atomic<T>[]> m_Items;
+    };
+
+private:
+    // Kept on separate cache lines, thieves hammer m_Top while the owner
+    // works on m_Bottom
+    alignas(64) std::atomic<int64_t> m_Top;
+    alignas(64) std::atomic<int64_t> m_Bottom;
+    alignas(64) std::atomic<Buffer*> m_Buffer;
+    std::vector<std::unique_ptr<Buffer>> m_RetiredBuffers;
+};
+
+#include "workstealingdeque_impl.h"
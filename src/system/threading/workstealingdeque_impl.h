@@ -0,0 +1,127 @@
+/*
+    This file is part of Spectre, an open-source physically based
+    spectral raytracing library.
+
+    Copyright (c) 2020-2023 Samuel Van Allen - All rights reserved.
+
+    Spectre is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+template <typename T>
+WorkStealingDeque<T>::Buffer::Buffer(int64_t capacity)
+    : m_Capacity(capacity)
+    , m_Mask(capacity - 1)
+    , m_Items(new std::atomic<T>[capacity])
+{
+}
+
+template <typename T>
+typename WorkStealingDeque<T>::Buffer* WorkStealingDeque<T>::Buffer::Grow(int64_t top, int64_t bottom) const
+{
+    Buffer* buffer = new Buffer(m_Capacity * 2);
+    for (int64_t i = top; i < bottom; ++i)
+        buffer->Put(i, Get(i));
+
+    return buffer;
+}
+
+template <typename T>
+WorkStealingDeque<T>::WorkStealingDeque(int64_t capacity)
+    : m_Top(0)
+    , m_Bottom(0)
+{
+    if (capacity <= 0 || (capacity & (capacity - 1)) != 0)
+        throw std::invalid_argument("Work-stealing deque capacity must be a power of two");
+
+    m_Buffer.store(new Buffer(capacity), std::memory_order_relaxed);
+}
+
+template <typename T>
+WorkStealingDeque<T>::~WorkStealingDeque()
+{
+    delete m_Buffer.load(std::memory_order_relaxed);
+}
+
+template <typename T>
+void WorkStealingDeque<T>::Push(T item)
+{
+    int64_t bottom = m_Bottom.load(std::memory_order_relaxed);
+    int64_t top = m_Top.load(std::memory_order_acquire);
+    Buffer* buffer = m_Buffer.load(std::memory_order_relaxed);
+
+    if (bottom - top > buffer->m_Capacity - 1)
+    {
+        m_RetiredBuffers.emplace_back(buffer);
+        buffer = buffer->Grow(top, bottom);
+        m_Buffer.store(buffer, std::memory_order_release);
+    }
+
+    buffer->Put(bottom, item);
+    std::atomic_thread_fence(std::memory_order_release);
+    m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+}
+
+template <typename T>
+bool WorkStealingDeque<T>::Pop(T& item)
+{
+    int64_t bottom = m_Bottom.load(std::memory_order_relaxed) - 1;
+    Buffer* buffer = m_Buffer.load(std::memory_order_relaxed);
+    m_Bottom.store(bottom, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t top = m_Top.load(std::memory_order_relaxed);
+
+    if (top > bottom)
+    {
+        m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+        return false;
+    }
+
+    item = buffer->Get(bottom);
+    if (top == bottom)
+    {
+        // Last item, race any thieves for it
+        bool won = m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+        m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+        return won;
+    }
+
+    return true;
+}
+
+template <typename T>
+bool WorkStealingDeque<T>::Steal(T& item)
+{
+    int64_t top = m_Top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t bottom = m_Bottom.load(std::memory_order_acquire);
+
+    if (top >= bottom)
+        return false;
+
+    Buffer* buffer = m_Buffer.load(std::memory_order_acquire);
+    T stolen = buffer->Get(top);
+    if (!m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+        return false;
+
+    item = stolen;
+    return true;
+}
+
+template <typename T>
+inline int64_t WorkStealingDeque<T>::GetSize() const
+{
+    int64_t bottom = m_Bottom.load(std::memory_order_relaxed);
+    int64_t top = m_Top.load(std::memory_order_relaxed);
+    return bottom - top;
+}
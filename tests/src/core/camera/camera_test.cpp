@@ -193,3 +193,21 @@ TEST(CameraTest, CanTransformWorldPointToCameraSpace)
     EXPECT_EQ(camera.ToCameraSpace(cameraSpaceRight), cameraSpaceRight - translation);
 }
 
+TEST(CameraTest, CachedWorldToCameraFollowsTransform)
+{
+    CameraImplStub camera;
+    Transform& transform = camera.GetTransform();
+    Point3 point(1, 2, 3);
+    Vector3 vector(-1, 0.5, 2);
+
+    transform.SetRotation({ 0.5, 1.0, -0.25 });
+    EXPECT_EQ(camera.ToCameraSpace(point), transform.Inversed()(point));
+    EXPECT_EQ(camera.ToCameraSpace(vector), transform.Inversed()(vector));
+
+    // Mutating through the held reference must invalidate the cached inverse
+    transform.SetScale({ 2, 3, 4 });
+    EXPECT_EQ(camera.ToCameraSpace(point), transform.Inversed()(point));
+    EXPECT_EQ(camera.ToCameraSpace(vector), transform.Inversed()(vector));
+    EXPECT_EQ(camera.ToWorldSpace(camera.ToCameraSpace(point)), point);
+}
+
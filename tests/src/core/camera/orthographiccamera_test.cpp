@@ -93,3 +93,31 @@ TEST(OrthographicCameraTest, CanGenerateRay)
     EXPECT_FALSE(topLeftCornerRay.GetOrigin() == Point3(1, 0, 0));
 }
 
+
+TEST(OrthographicCameraTest, BatchMatchesSingleRays)
+{
+    OrthographicCamera camera(2.0);
+    camera.GetTransform().SetTranslation({ 1, 2, 3 });
+    camera.GetTransform().SetRotation({ 0.1, Math::DegToRad(30), 0 });
+
+    RayBuffer rays(3);
+    rays.SetSample(0, { 0, 0 }, {});
+    rays.SetSample(1, { 17, 300 }, { 0.5, 0.5 });
+    rays.SetSample(2, { 640, 10 }, { -0.25, 0.1 });
+    camera.GenerateRays(rays);
+
+    for (int i = 0; i < rays.GetSize(); ++i)
+    {
+        Ray expected = camera.GenerateRay(rays.GetPixel(i), rays.GetOffset(i));
+        Ray ray = rays.GetRay(i);
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            EXPECT_NEAR(ray.GetOrigin()[axis], expected.GetOrigin()[axis], 1e-12);
+            EXPECT_NEAR(ray.GetDirection()[axis], expected.GetDirection()[axis], 1e-12);
+        }
+    }
+
+    camera.SetSize(4.0);
+    camera.GenerateRays(rays);
+    EXPECT_NEAR(rays.GetRay(2).GetOrigin()[0], camera.GenerateRay({ 640, 10 }, { -0.25, 0.1 }).GetOrigin()[0], 1e-12);
+}
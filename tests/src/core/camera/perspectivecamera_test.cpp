@@ -93,3 +93,75 @@ TEST(PerspectiveCameraTest, CanGenerateRay)
     EXPECT_EQ(topLeftCornerRay.GetOrigin(), Point3(1, 0, 0));
 }
 
+
+TEST(PerspectiveCameraTest, BatchMatchesSingleRays)
+{
+    PerspectiveCamera camera(60);
+    camera.GetTransform().SetTranslation({ 1, 2, 3 });
+    camera.GetTransform().SetRotation({ 0.1, Math::DegToRad(30), 0 });
+
+    RayBuffer rays;
+    FilmTile& tile = camera.GetFilm().GetTile(5);
+    camera.GenerateRays(tile, rays, { 0.25, 0.75 });
+    ASSERT_EQ(rays.GetSize(), tile.GetSize().x * tile.GetSize().y);
+
+    for (int i = 0; i < rays.GetSize(); i += 7)
+    {
+        Ray expected = camera.GenerateRay(rays.GetPixel(i), { 0.25, 0.75 });
+        Ray ray = rays.GetRay(i);
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            EXPECT_NEAR(ray.GetOrigin()[axis], expected.GetOrigin()[axis], 1e-12);
+            EXPECT_NEAR(ray.GetDirection()[axis], expected.GetDirection()[axis], 1e-12);
+        }
+    }
+}
+
+TEST(PerspectiveCameraTest, RefreshesCachedConstants)
+{
+    PerspectiveCamera camera;
+    Ray before = camera.GenerateRay({ 0, 0 });
+
+    camera.SetHorizontalFov(30);
+    Ray narrower = camera.GenerateRay({ 0, 0 });
+    EXPECT_GT(narrower.GetDirection().z, before.GetDirection().z);
+
+    camera.GetTransform().SetTranslation({ 0, 5, 0 });
+    EXPECT_EQ(camera.GenerateRay({ 0, 0 }).GetOrigin(), Point3(0, 5, 0));
+
+    RayBuffer rays(1);
+    rays.SetSample(0, { 0, 0 }, {});
+    camera.GenerateRays(rays);
+    EXPECT_EQ(rays.GetRay(0).GetOrigin(), Point3(0, 5, 0));
+}
+
+TEST(PerspectiveCameraTest, RefreshesConstantsThroughHeldReferences)
+{
+    PerspectiveCamera camera;
+    Transform& transform = camera.GetTransform();
+    Film& film = camera.GetFilm();
+    Ray before = camera.GenerateRay({ 10, 10 });
+
+    transform.SetTranslation({ 1, 2, 3 });
+    EXPECT_EQ(camera.GenerateRay({ 0, 0 }).GetOrigin(), Point3(1, 2, 3));
+
+    Resolution resolution = film.GetResolution();
+    resolution.SetWidth(resolution.GetWidth() * 2);
+    resolution.SetHeight(resolution.GetHeight() * 2);
+    film.SetResolution(resolution);
+    Ray wider = camera.GenerateRay({ 10, 10 });
+    EXPECT_NE(wider.GetDirection(), before.GetDirection());
+}
+
+TEST(PerspectiveCameraTest, RefreshesConstantsOnTransformAssignment)
+{
+    PerspectiveCamera camera;
+    camera.GetTransform().SetTranslation({ 1, 0, 0 });
+    EXPECT_EQ(camera.GenerateRay({ 0, 0 }).GetOrigin(), Point3(1, 0, 0));
+
+    // Both transforms had a single setter called, which used to give them the same revision
+    Transform other;
+    other.SetTranslation({ 0, 0, 7 });
+    camera.GetTransform() = other;
+    EXPECT_EQ(camera.GenerateRay({ 0, 0 }).GetOrigin(), Point3(0, 0, 7));
+}
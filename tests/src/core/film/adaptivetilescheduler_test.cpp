@@ -0,0 +1,138 @@
+/*
+    This file is part of Spectre, an open-source physically based
+    spectral raytracing library.
+
+    Copyright (c) 2020-2023 Samuel Van Allen - All rights reserved.
+
+    Spectre is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "gtest.h"
+#include "core/film/adaptivetilescheduler.h"
+
+namespace
+{
+    // Film of 4 x 2 tiles where only the first tile is noisy
+    Film CreateFilm()
+    {
+        Film film;
+        Resolution resolution;
+        resolution.SetWidth(4 * film.GetTileSize());
+        resolution.SetHeight(2 * film.GetTileSize());
+        film.SetResolution(resolution);
+        film.EnableStatistics();
+        return film;
+    }
+
+    void SampleTile(FilmTile& tile, int firstSample, int numSamples, bool isNoisy)
+    {
+        Pcg32 rng(firstSample, tile.GetPosition().x + 7919 * tile.GetPosition().y);
+        Vector2i size = tile.GetSize();
+        for (int y = 0; y < size.y; ++y)
+        {
+            for (int x = 0; x < size.x; ++x)
+            {
+                Point2i pixel = tile.TileToFilmSpace({ x, y });
+                for (int s = 0; s < numSamples; ++s)
+                {
+                    double luminance = isNoisy ? 2.0 * rng.NextDouble() : 0.5;
+                    tile.AddFilteredSample({ pixel.x + 0.5, pixel.y + 0.5 }, luminance);
+                }
+            }
+        }
+    }
+}
+
+TEST(AdaptiveTileSchedulerTest, ThrowOnInvalidSetup)
+{
+    Film film;
+    EXPECT_THROW(AdaptiveTileScheduler scheduler(film), std::invalid_argument);
+
+    film.EnableStatistics();
+    AdaptiveSamplingSettings settings;
+    settings.m_MaxSamples = settings.m_MinSamples - 1;
+    EXPECT_THROW(AdaptiveTileScheduler scheduler(film, settings), std::invalid_argument);
+
+    settings = {};
+    settings.m_MaxPassShare = 0;
+    EXPECT_THROW(AdaptiveTileScheduler scheduler(film, settings), std::invalid_argument);
+}
+
+TEST(AdaptiveTileSchedulerTest, FirstPassCoversEveryTile)
+{
+    Film film = CreateFilm();
+    AdaptiveTileScheduler scheduler(film);
+
+    std::vector<TileWork> pass = scheduler.NextPass();
+    ASSERT_EQ(pass.size(), film.GetNumTiles());
+    for (int i = 0; i < film.GetNumTiles(); ++i)
+    {
+        EXPECT_EQ(pass[i].m_TileIndex, i);
+        EXPECT_EQ(pass[i].m_FirstSample, 0);
+        EXPECT_EQ(pass[i].m_NumSamples, scheduler.GetSettings().m_MinSamples);
+    }
+}
+
+TEST(AdaptiveTileSchedulerTest, RedistributesSamplesToNoisyTiles)
+{
+    Film film = CreateFilm();
+    AdaptiveSamplingSettings settings;
+    settings.m_MaxSamples = 256;
+    AdaptiveTileScheduler scheduler(film, settings);
+
+    for (std::vector<TileWork> pass = scheduler.NextPass(); !pass.empty(); pass = scheduler.NextPass())
+    {
+        for (const TileWork& work : pass)
+        {
+            SampleTile(film.GetTile(work.m_TileIndex), work.m_FirstSample, work.m_NumSamples, work.m_TileIndex == 0);
+
+            // The converged tiles drop out after the first pass, and their budget goes
+            // to the noisy one, up to its share per pass
+            if (scheduler.GetNumPasses() > 1)
+            {
+                EXPECT_EQ(work.m_TileIndex, 0);
+                EXPECT_GT(work.m_NumSamples, settings.m_SamplesPerPass);
+                EXPECT_LE(work.m_NumSamples, settings.m_SamplesPerPass * settings.m_MaxPassShare);
+            }
+        }
+    }
+
+    EXPECT_EQ(scheduler.GetNumSamples(0), settings.m_MaxSamples);
+    for (int i = 1; i < film.GetNumTiles(); ++i)
+        EXPECT_EQ(scheduler.GetNumSamples(i), settings.m_MinSamples);
+
+    EXPECT_EQ(film.GetTile(1).GetError(), 0.0);
+    EXPECT_GT(film.GetTile(0).GetError(), settings.m_TargetError);
+    EXPECT_EQ(film.GetError(), film.GetTile(0).GetError());
+}
+
+TEST(AdaptiveTileSchedulerTest, StopsOnceConverged)
+{
+    Film film = CreateFilm();
+    AdaptiveSamplingSettings settings;
+    settings.m_TargetError = 1.0;
+    AdaptiveTileScheduler scheduler(film, settings);
+
+    int numPasses = 0;
+    for (std::vector<TileWork> pass = scheduler.NextPass(); !pass.empty(); pass = scheduler.NextPass())
+    {
+        for (const TileWork& work : pass)
+            SampleTile(film.GetTile(work.m_TileIndex), work.m_FirstSample, work.m_NumSamples, work.m_TileIndex == 0);
+        numPasses++;
+    }
+
+    EXPECT_EQ(numPasses, scheduler.GetNumPasses());
+    EXPECT_LE(film.GetError(), settings.m_TargetError);
+    EXPECT_LT(scheduler.GetNumSamples(0), settings.m_MaxSamples);
+}
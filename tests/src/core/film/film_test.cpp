@@ -20,6 +20,7 @@
 
 #include "gtest.h"
 #include "core/film/film.h"
+#include "core/film/filter/mitchellfilter.h"
 #include "core/film/standardresolution.h"
 
 TEST(FilmTest, CanBeCreated)
@@ -98,3 +99,119 @@ TEST(FilmTest, CanGetTotalTileCount)
     ASSERT_EQ(film.GetNumTiles(), std::ceil(3840 / tileSize) * std::ceil(2160 / tileSize));
 }
 
+
+TEST(FilmTest, TileLookupMatchesTileBounds)
+{
+    Film film;
+    film.SetResolution(Resolution800X600());
+
+    for (int y = 0; y < 600; y += 37)
+    {
+        for (int x = 0; x < 800; x += 29)
+        {
+            FilmTile& tile = film.GetTile({ x, y });
+            Point2i position = tile.GetPosition();
+            Vector2i size = tile.GetSize();
+            EXPECT_TRUE(x >= position.x && x < position.x + size.x);
+            EXPECT_TRUE(y >= position.y && y < position.y + size.y);
+        }
+    }
+}
+
+TEST(FilmTest, ThrowOnMissingFilter)
+{
+    Film film;
+    EXPECT_THROW(film.SetFilter(nullptr), std::invalid_argument);
+}
+
+TEST(FilmTest, MergedApronsMatchSingleTile)
+{
+    Film film;
+    Resolution resolution;
+    resolution.SetWidth(150);
+    resolution.SetHeight(70);
+    film.SetResolution(resolution);
+    film.SetFilter(std::make_shared<MitchellFilter>(Vector2(2.0, 2.0)));
+    ASSERT_EQ(film.GetTile(0).GetApron(), 2);
+
+    // Reference accumulating the same samples without any tile boundaries
+    FilmTile reference({ 0, 0 }, { 150, 70 }, std::make_shared<FilterTable>(film.GetFilter()));
+
+    Pcg32 rng(7, 0);
+    for (int i = 0; i < 2000; ++i)
+    {
+        Point2 position(rng.NextDouble() * 150, rng.NextDouble() * 70);
+        XyzCoefficients xyz(rng.NextDouble(), rng.NextDouble(), rng.NextDouble());
+        film.GetTile({ (int)position.x, (int)position.y }).AddFilteredSample(position, xyz);
+        reference.AddFilteredSample(position, xyz);
+    }
+
+    film.MergeAprons();
+
+    for (int y = 0; y < 70; ++y)
+    {
+        for (int x = 0; x < 150; ++x)
+        {
+            const Pixel& expected = reference.GetTileSpacePixel({ x, y });
+            const Pixel& actual = film.GetTile({ x, y }).GetFilmSpacePixel({ x, y });
+            EXPECT_NEAR(actual.m_Xyz[1], expected.m_Xyz[1], 1e-4);
+            EXPECT_NEAR(actual.m_TotalSplat, expected.m_TotalSplat, 1e-4);
+        }
+    }
+}
+
+TEST(FilmTest, TilesShareAlignedStorage)
+{
+    Film film;
+    film.SetResolution(Resolution800X600());
+    const FilmBuffer& buffer = film.GetBuffer();
+
+    // Every tile starts a cache line aligned block of the shared channels
+    const SpectralReal* begin = buffer.GetChannel(FilmBuffer::X);
+    for (int i = 0; i < film.GetNumTiles(); ++i)
+    {
+        const SpectralReal* row = film.GetTile(i).GetRow(0).m_X.data();
+        EXPECT_GE(row, begin);
+        EXPECT_LT(row, begin + buffer.GetSize());
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(row) % FilmBuffer::CacheLineSize, 0);
+    }
+
+    film.GetTile({ 100, 100 }).SetPixel({ 36, 36 }, { 0.5, 0.5, 0.5 });
+    EXPECT_DOUBLE_EQ(film.GetTile({ 100, 100 }).GetFilmSpacePixel({ 100, 100 }).m_TotalSplat, SpectralReal(1.0));
+
+    // Reallocating keeps the tiles but starts from a clear film
+    film.AllocateStorage();
+    EXPECT_DOUBLE_EQ(film.GetTile({ 100, 100 }).GetFilmSpacePixel({ 100, 100 }).m_TotalSplat, SpectralReal(0.0));
+}
+
+TEST(FilmTest, CanEnableSplats)
+{
+    Film film;
+    EXPECT_FALSE(film.HasSplats());
+    EXPECT_THROW(film.GetSplats(), std::runtime_error);
+
+    film.EnableSplats(SplatMode::PerThread);
+    ASSERT_TRUE(film.HasSplats());
+    EXPECT_EQ(film.GetSplats().GetMode(), SplatMode::PerThread);
+    EXPECT_EQ(film.GetSplats().GetResolution(), film.GetResolution());
+
+    // The splat layer follows the film resolution and keeps its scale
+    film.GetSplats().SetScale(0.25);
+    film.SetResolution(Resolution800X600());
+    EXPECT_EQ(film.GetSplats().GetResolution(), Resolution800X600());
+    EXPECT_EQ(film.GetSplats().GetMode(), SplatMode::PerThread);
+    EXPECT_EQ(film.GetSplats().GetScale(), 0.25);
+}
+
+TEST(FilmTest, FinishingSplatsReducesThreadLayers)
+{
+    Film film;
+    EXPECT_NO_THROW(film.FinishSplats());
+
+    film.EnableSplats(SplatMode::PerThread);
+    film.GetSplats().AddSplat({ 10.5, 20.5 }, XyzCoefficients(1.0));
+    EXPECT_THROW(film.GetSplats().GetPixel({ 10, 20 }), std::runtime_error);
+
+    film.FinishSplats();
+    EXPECT_DOUBLE_EQ(film.GetSplats().GetPixel({ 10, 20 })[1], SpectralReal(1.0));
+}
@@ -0,0 +1,67 @@
+/*
+    This file is part of Spectre, an open-source physically based
+    spectral raytracing library.
+
+    Copyright (c) 2020-2023 Samuel Van Allen - All rights reserved.
+
+    Spectre is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "gtest.h"
+#include "core/film/filmbuffer.h"
+
+TEST(FilmBufferTest, ChannelsAreCacheLineAligned)
+{
+    FilmBuffer buffer(1000);
+    ASSERT_EQ(buffer.GetSize(), 1000);
+
+    for (int i = 0; i < FilmBuffer::NumChannels; ++i)
+    {
+        const SpectralReal* channel = buffer.GetChannel((FilmBuffer::Channel)i);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(channel) % FilmBuffer::CacheLineSize, 0);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(channel) % FilmBuffer::PageSize, 0);
+    }
+
+    EXPECT_NE(buffer.GetChannel(FilmBuffer::X), buffer.GetChannel(FilmBuffer::Y));
+}
+
+TEST(FilmBufferTest, CanClear)
+{
+    FilmBuffer buffer(100);
+    buffer.Clear();
+
+    for (int i = 0; i < FilmBuffer::NumChannels; ++i)
+    {
+        const SpectralReal* channel = buffer.GetChannel((FilmBuffer::Channel)i);
+        EXPECT_TRUE(std::all_of(channel, channel + 100, [](SpectralReal v) { return v == 0; }));
+    }
+}
+
+TEST(FilmBufferTest, CanPadToCacheLine)
+{
+    const size_t pixelsPerLine = FilmBuffer::CacheLineSize / sizeof(SpectralReal);
+    EXPECT_EQ(FilmBuffer::PadToCacheLine(0), 0);
+    EXPECT_EQ(FilmBuffer::PadToCacheLine(1), pixelsPerLine);
+    EXPECT_EQ(FilmBuffer::PadToCacheLine(pixelsPerLine), pixelsPerLine);
+    EXPECT_EQ(FilmBuffer::PadToCacheLine(pixelsPerLine + 1), 2 * pixelsPerLine);
+}
+
+TEST(FilmBufferTest, CanPadToPage)
+{
+    const size_t pixelsPerPage = FilmBuffer::PageSize / sizeof(SpectralReal);
+    EXPECT_EQ(FilmBuffer::PadToPage(0), 0);
+    EXPECT_EQ(FilmBuffer::PadToPage(1), pixelsPerPage);
+    EXPECT_EQ(FilmBuffer::PadToPage(pixelsPerPage), pixelsPerPage);
+    EXPECT_EQ(FilmBuffer::PadToPage(pixelsPerPage + 1), 2 * pixelsPerPage);
+}
@@ -18,6 +18,8 @@
 
 #include "gtest.h"
 #include "core/film/filmtile.h"
+#include "core/film/filter/boxfilter.h"
+#include "core/film/filter/gaussianfilter.h"
 
 TEST(FilmTileTest, CanBeCreated)
 {
@@ -107,9 +109,9 @@ TEST(FilmTileTest, CanSetPixelValue)
     FilmTile filmTile({ 0, 0 }, { 100, 100 });
     ASSERT_NO_THROW(filmTile.SetPixel({ 50, 50 }, { 0.2, 0.3, 0.4 }));
     Pixel p = filmTile.GetFilmSpacePixel({ 50, 50 });
-    EXPECT_DOUBLE_EQ(p.m_Xyz[0], 0.2);
-    EXPECT_DOUBLE_EQ(p.m_Xyz[1], 0.3);
-    EXPECT_DOUBLE_EQ(p.m_Xyz[2], 0.4);
+    EXPECT_DOUBLE_EQ(p.m_Xyz[0], SpectralReal(0.2));
+    EXPECT_DOUBLE_EQ(p.m_Xyz[1], SpectralReal(0.3));
+    EXPECT_DOUBLE_EQ(p.m_Xyz[2], SpectralReal(0.4));
 }
 
 TEST(FilmTileTest, CanSplatPixelValue)
@@ -119,15 +121,15 @@ TEST(FilmTileTest, CanSplatPixelValue)
     ASSERT_THROW(filmTile.SplatPixel({ 50, 50 }, { 0.2, 0.3, 0.4 }, -0.0001), std::invalid_argument);
     ASSERT_NO_THROW(filmTile.SplatPixel({ 50, 50 }, { 0.2, 0.3, 0.4 }, 0.5));
     Pixel p = filmTile.GetFilmSpacePixel({ 50, 50 });
-    EXPECT_DOUBLE_EQ(p.m_Xyz[0], 0.1);
-    EXPECT_DOUBLE_EQ(p.m_Xyz[1], 0.15);
-    EXPECT_DOUBLE_EQ(p.m_Xyz[2], 0.2);
+    EXPECT_DOUBLE_EQ(p.m_Xyz[0], SpectralReal(0.1));
+    EXPECT_DOUBLE_EQ(p.m_Xyz[1], SpectralReal(0.15));
+    EXPECT_DOUBLE_EQ(p.m_Xyz[2], SpectralReal(0.2));
 
     ASSERT_NO_THROW(filmTile.SplatPixel({ 50, 50 }, { 0.2, 0.3, 0.4 }, 0.5));
     p = filmTile.GetFilmSpacePixel({ 50, 50 });
-    EXPECT_DOUBLE_EQ(p.m_Xyz[0], 0.2);
-    EXPECT_DOUBLE_EQ(p.m_Xyz[1], 0.3);
-    EXPECT_DOUBLE_EQ(p.m_Xyz[2], 0.4);
+    EXPECT_DOUBLE_EQ(p.m_Xyz[0], SpectralReal(0.2));
+    EXPECT_DOUBLE_EQ(p.m_Xyz[1], SpectralReal(0.3));
+    EXPECT_DOUBLE_EQ(p.m_Xyz[2], SpectralReal(0.4));
     ASSERT_THROW(filmTile.SplatPixel({ 50, 50 }, { 0.2, 0.3, 0.4 }, 0.0001), std::invalid_argument);
 }
 
@@ -144,3 +146,130 @@ TEST(FilmTileTest, SplatEpsilonValueSufficient)
     }
 }
 
+
+TEST(FilmTileTest, CanSplatSpectralPacket)
+{
+    FilmTile filmTile({ 0, 0 }, { 10, 10 });
+    SampledWavelengths wavelengths = SampledWavelengths::SampleUniform(0.25);
+    SpectralPacket radiance(0.5);
+
+    ASSERT_NO_THROW(filmTile.SplatPixel({ 5, 5 }, radiance, wavelengths, 0.5));
+    Pixel p = filmTile.GetTileSpacePixel({ 5, 5 });
+    XyzCoefficients expected = radiance.ToXyz(wavelengths) * 0.5;
+    EXPECT_DOUBLE_EQ(p.m_Xyz[0], expected[0]);
+    EXPECT_DOUBLE_EQ(p.m_Xyz[1], expected[1]);
+    EXPECT_DOUBLE_EQ(p.m_Xyz[2], expected[2]);
+    EXPECT_DOUBLE_EQ(p.m_TotalSplat, SpectralReal(0.5));
+}
+
+TEST(FilmTileTest, AddSampleMatchesSplatPixel)
+{
+    FilmTile checked({ 64, 0 }, { 16, 8 });
+    FilmTile unchecked({ 64, 0 }, { 16, 8 });
+
+    checked.SplatPixel({ 15, 7 }, { 0.2, 0.3, 0.4 }, 0.25);
+    checked.SplatPixel({ 15, 7 }, { 0.6, 0.1, 0.0 }, 0.5);
+    unchecked.AddSample({ 15, 7 }, { 0.2, 0.3, 0.4 }, 0.25);
+    unchecked.AddSample({ 15, 7 }, { 0.6, 0.1, 0.0 }, 0.5);
+
+    Pixel expected = checked.GetTileSpacePixel({ 15, 7 });
+    Pixel actual = unchecked.GetTileSpacePixel({ 15, 7 });
+    EXPECT_DOUBLE_EQ(actual.m_Xyz[0], expected.m_Xyz[0]);
+    EXPECT_DOUBLE_EQ(actual.m_Xyz[1], expected.m_Xyz[1]);
+    EXPECT_DOUBLE_EQ(actual.m_Xyz[2], expected.m_Xyz[2]);
+    EXPECT_DOUBLE_EQ(actual.m_TotalSplat, expected.m_TotalSplat);
+}
+
+TEST(FilmTileTest, CanWriteThroughRow)
+{
+    FilmTile filmTile({ 0, 0 }, { 8, 4 });
+    PixelRow row = filmTile.GetRow(2);
+    ASSERT_EQ(row.m_X.size(), 8);
+    ASSERT_EQ(row.m_TotalSplat.size(), 8);
+
+    row.m_Y[5] = SpectralReal(0.2);
+    row.m_TotalSplat[5] = SpectralReal(1.0);
+    EXPECT_DOUBLE_EQ(filmTile.GetTileSpacePixel({ 5, 2 }).m_Xyz[1], SpectralReal(0.2));
+    EXPECT_DOUBLE_EQ(filmTile.GetTileSpacePixel({ 5, 2 }).m_TotalSplat, SpectralReal(1.0));
+
+    EXPECT_THROW(filmTile.GetRow(-1), std::invalid_argument);
+    EXPECT_THROW(filmTile.GetRow(4), std::invalid_argument);
+}
+
+TEST(FilmTileTest, FilteredBoxSampleMatchesAddSample)
+{
+    auto table = std::make_shared<FilterTable>(BoxFilter());
+    FilmTile filtered({ 10, 20 }, { 8, 8 }, table);
+    FilmTile unfiltered({ 10, 20 }, { 8, 8 });
+    ASSERT_EQ(filtered.GetApron(), 0);
+
+    // Samples on the lower pixel edges belong to that pixel only
+    filtered.AddFilteredSample({ 13.0, 25.0 }, { 0.2, 0.3, 0.4 });
+    filtered.AddFilteredSample({ 13.7, 25.2 }, { 0.4, 0.1, 0.0 });
+    unfiltered.AddSample({ 3, 5 }, { 0.2, 0.3, 0.4 }, 1.0);
+    unfiltered.AddSample({ 3, 5 }, { 0.4, 0.1, 0.0 }, 1.0);
+
+    for (int y = 0; y < 8; ++y)
+    {
+        for (int x = 0; x < 8; ++x)
+        {
+            const Pixel& expected = unfiltered.GetTileSpacePixel({ x, y });
+            const Pixel& actual = filtered.GetTileSpacePixel({ x, y });
+            EXPECT_DOUBLE_EQ(actual.m_Xyz[0], expected.m_Xyz[0]);
+            EXPECT_DOUBLE_EQ(actual.m_TotalSplat, expected.m_TotalSplat);
+        }
+    }
+}
+
+TEST(FilmTileTest, ThrowOnFilteredSampleWithoutFilter)
+{
+    FilmTile filmTile({ 0, 0 }, { 4, 4 });
+    EXPECT_THROW(filmTile.AddFilteredSample({ 1.5, 1.5 }, { 1.0, 1.0, 1.0 }), std::runtime_error);
+}
+
+TEST(FilmTileTest, CanMergeApronIntoNeighbour)
+{
+    auto table = std::make_shared<FilterTable>(GaussianFilter(Vector2(1.5, 1.5)));
+    FilmTile left({ 0, 0 }, { 4, 4 }, table);
+    FilmTile right({ 4, 0 }, { 4, 4 }, table);
+    ASSERT_EQ(left.GetApron(), 1);
+
+    // A sample at the right edge of the left tile also lands on the first column of the right tile
+    left.AddFilteredSample({ 3.9, 2.5 }, { 1.0, 1.0, 1.0 });
+    EXPECT_DOUBLE_EQ(right.GetTileSpacePixel({ 0, 2 }).m_TotalSplat, SpectralReal(0.0));
+
+    right.MergeApron(left);
+    SpectralReal expected = SpectralReal(table->Evaluate(4.5 - 3.9, 0.0));
+    EXPECT_GT(expected, 0.0);
+    EXPECT_DOUBLE_EQ(right.GetTileSpacePixel({ 0, 2 }).m_TotalSplat, expected);
+    EXPECT_DOUBLE_EQ(right.GetTileSpacePixel({ 1, 2 }).m_TotalSplat, SpectralReal(0.0));
+
+    // Clearing the apron leaves the interior untouched
+    SpectralReal interior = left.GetTileSpacePixel({ 3, 2 }).m_TotalSplat;
+    left.ClearApron();
+    right.MergeApron(left);
+    EXPECT_DOUBLE_EQ(right.GetTileSpacePixel({ 0, 2 }).m_TotalSplat, expected);
+    EXPECT_DOUBLE_EQ(left.GetTileSpacePixel({ 3, 2 }).m_TotalSplat, interior);
+}
+
+TEST(FilmTileTest, RecordsFilteredSampleStatistics)
+{
+    auto table = std::make_shared<FilterTable>(GaussianFilter(Vector2(1.5, 1.5)));
+    FilmTile filmTile({ 10, 10 }, { 4, 4 }, table);
+    EXPECT_FALSE(filmTile.HasStatistics());
+    EXPECT_THROW(filmTile.GetStatistics(), std::runtime_error);
+    EXPECT_TRUE(std::isinf(filmTile.GetError()));
+
+    filmTile.EnableStatistics();
+    filmTile.AddFilteredSample({ 12.2, 13.9 }, { 0.0, 1.0, 0.0 });
+    filmTile.AddFilteredSample({ 12.7, 13.1 }, { 0.0, 3.0, 0.0 });
+
+    // Statistics count the pixel the sample lies in, regardless of the filter footprint
+    const PixelStatistics& statistics = filmTile.GetStatistics();
+    EXPECT_EQ(statistics.GetNumSamples({ 2, 3 }), 2);
+    EXPECT_EQ(statistics.GetNumSamples({ 1, 3 }), 0);
+    EXPECT_DOUBLE_EQ(statistics.GetMean({ 2, 3 }), 2.0);
+
+    filmTile.ResetPixels();
+    EXPECT_EQ(statistics.GetNumSamples({ 2, 3 }), 0);
+}
@@ -0,0 +1,102 @@
+/*
+    This file is part of Spectre, an open-source physically based
+    spectral raytracing library.
+
+    Copyright (c) 2020-2023 Samuel Van Allen - All rights reserved.
+
+    Spectre is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "gtest.h"
+#include "core/film/filter/filter.h"
+#include "core/film/filter/boxfilter.h"
+#include "core/film/filter/gaussianfilter.h"
+#include "core/film/filter/mitchellfilter.h"
+#include "core/film/filter/blackmanharrisfilter.h"
+#include "core/film/filter/lanczosfilter.h"
+
+namespace
+{
+    const FilterType AllFilterTypes[] = { FilterType::Box, FilterType::Gaussian, FilterType::Mitchell, FilterType::BlackmanHarris, FilterType::Lanczos };
+}
+
+TEST(FilterTest, CanCreateEveryType)
+{
+    EXPECT_NE(dynamic_cast<BoxFilter*>(CreateFilter(FilterType::Box).get()), nullptr);
+    EXPECT_NE(dynamic_cast<GaussianFilter*>(CreateFilter(FilterType::Gaussian).get()), nullptr);
+    EXPECT_NE(dynamic_cast<MitchellFilter*>(CreateFilter(FilterType::Mitchell).get()), nullptr);
+    EXPECT_NE(dynamic_cast<BlackmanHarrisFilter*>(CreateFilter(FilterType::BlackmanHarris).get()), nullptr);
+    EXPECT_NE(dynamic_cast<LanczosFilter*>(CreateFilter(FilterType::Lanczos).get()), nullptr);
+
+    std::unique_ptr<Filter> filter = CreateFilter(FilterType::Gaussian, { 2.5, 1.0 });
+    EXPECT_EQ(filter->GetRadius(), Vector2(2.5, 1.0));
+}
+
+TEST(FilterTest, ThrowOnInvalidRadius)
+{
+    EXPECT_THROW(BoxFilter(Vector2(0.0, 0.5)), std::invalid_argument);
+    EXPECT_THROW(GaussianFilter(Vector2(1.0, -1.0)), std::invalid_argument);
+    EXPECT_THROW(GaussianFilter(Vector2(1.0, 1.0), 0.0), std::invalid_argument);
+    EXPECT_THROW(LanczosFilter(Vector2(1.0, 1.0), 0.0), std::invalid_argument);
+}
+
+TEST(FilterTest, FiltersAreSymmetricAndBounded)
+{
+    for (FilterType type : AllFilterTypes)
+    {
+        std::unique_ptr<Filter> filter = CreateFilter(type);
+        Vector2 radius = filter->GetRadius();
+
+        EXPECT_GT(filter->Evaluate({ 0.0, 0.0 }), 0.0);
+        EXPECT_EQ(filter->Evaluate({ radius.x, 0.0 }), 0.0);
+        EXPECT_EQ(filter->Evaluate({ 0.0, -radius.y }), 0.0);
+        EXPECT_EQ(filter->Evaluate({ radius.x + 1.0, radius.y + 1.0 }), 0.0);
+
+        for (double x = 0.0; x < radius.x; x += 0.3)
+        {
+            for (double y = 0.0; y < radius.y; y += 0.3)
+            {
+                double value = filter->Evaluate({ x, y });
+                EXPECT_DOUBLE_EQ(filter->Evaluate({ -x, y }), value);
+                EXPECT_DOUBLE_EQ(filter->Evaluate({ x, -y }), value);
+                EXPECT_DOUBLE_EQ(filter->Evaluate({ -x, -y }), value);
+            }
+        }
+    }
+}
+
+TEST(FilterTest, HaveExpectedValues)
+{
+    BoxFilter box;
+    EXPECT_EQ(box.Evaluate({ 0.49, -0.49 }), 1.0);
+
+    GaussianFilter gaussian(Vector2(1.5, 1.5), 0.5);
+    double edge = std::exp(-1.5 * 1.5 / 0.5);
+    EXPECT_NEAR(gaussian.Evaluate({ 0.5, 0.0 }), (std::exp(-0.5) - edge) * (1.0 - edge), 1e-12);
+
+    // The cubic with B = C = 1/3 is 8/9 at the center, and zero at the radius
+    MitchellFilter mitchell(Vector2(2.0, 2.0));
+    EXPECT_NEAR(mitchell.Evaluate({ 0.0, 0.0 }), (8.0 / 9.0) * (8.0 / 9.0), 1e-12);
+    EXPECT_NEAR(mitchell.Evaluate({ 1.999999, 0.0 }), 0.0, 1e-6);
+
+    BlackmanHarrisFilter blackmanHarris;
+    EXPECT_NEAR(blackmanHarris.Evaluate({ 0.0, 0.0 }), 1.0, 1e-12);
+
+    // The windowed sinc passes through zero at every integer offset
+    LanczosFilter lanczos;
+    EXPECT_NEAR(lanczos.Evaluate({ 0.0, 0.0 }), 1.0, 1e-12);
+    EXPECT_NEAR(lanczos.Evaluate({ 1.0, 0.0 }), 0.0, 1e-12);
+    EXPECT_NEAR(lanczos.Evaluate({ 0.0, 2.0 }), 0.0, 1e-12);
+    EXPECT_LT(lanczos.Evaluate({ 1.5, 0.0 }), 0.0);
+}
@@ -0,0 +1,59 @@
+/*
+    This file is part of Spectre, an open-source physically based
+    spectral raytracing library.
+
+    Copyright (c) 2020-2023 Samuel Van Allen - All rights reserved.
+
+    Spectre is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "gtest.h"
+#include "core/film/filter/filtertable.h"
+#include "core/film/filter/gaussianfilter.h"
+#include "core/film/filter/boxfilter.h"
+
+TEST(FilterTableTest, StoresFilterAtCellCenters)
+{
+    GaussianFilter filter(Vector2(2.0, 1.0));
+    FilterTable table(filter, 8);
+
+    ASSERT_EQ(table.GetSize(), 8);
+    EXPECT_EQ(table.GetRadius(), filter.GetRadius());
+
+    for (int y = 0; y < 8; ++y)
+    {
+        for (int x = 0; x < 8; ++x)
+        {
+            Vector2 center((x + 0.5) * 2.0 / 8, (y + 0.5) * 1.0 / 8);
+            EXPECT_DOUBLE_EQ(table.Evaluate(center.x, center.y), filter.Evaluate(center));
+            EXPECT_DOUBLE_EQ(table.Evaluate(-center.x, -center.y), filter.Evaluate(center));
+        }
+    }
+
+    // Offsets beyond the radius clamp to the outermost cells
+    EXPECT_DOUBLE_EQ(table.Evaluate(5.0, 5.0), table.Evaluate(1.99, 0.99));
+}
+
+TEST(FilterTableTest, ApronCoversRadius)
+{
+    EXPECT_EQ(FilterTable(BoxFilter(Vector2(0.5, 0.5))).GetApron(), 0);
+    EXPECT_EQ(FilterTable(BoxFilter(Vector2(1.0, 0.5))).GetApron(), 1);
+    EXPECT_EQ(FilterTable(GaussianFilter(Vector2(1.5, 1.5))).GetApron(), 1);
+    EXPECT_EQ(FilterTable(GaussianFilter(Vector2(2.0, 1.0))).GetApron(), 2);
+}
+
+TEST(FilterTableTest, ThrowOnInvalidSize)
+{
+    EXPECT_THROW(FilterTable(BoxFilter(), 0), std::invalid_argument);
+}
@@ -0,0 +1,154 @@
+/*
+    This file is part of Spectre, an open-source physically based
+    spectral raytracing library.
+
+    Copyright (c) 2020-2023 Samuel Van Allen - All rights reserved.
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "gtest.h"
+#include "core/film/parallelfortiles.h"
+#include "core/film/standardresolution.h"
+
+TEST(ParallelForTilesTest, VisitsEveryTileOnce)
+{
+    Film film;
+    film.SetResolution(Resolution800X600());
+
+    ThreadPool pool(4, SchedulingMode::WorkStealing);
+    std::mutex mutex;
+    std::vector<Point2i> positions;
+
+    ParallelForTiles(pool, film, [&](FilmTile& tile)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        positions.push_back(tile.GetPosition());
+    });
+
+    ASSERT_EQ(positions.size(), film.GetNumTiles());
+    for (int i = 0; i < film.GetNumTiles(); ++i)
+        EXPECT_EQ(std::count(positions.begin(), positions.end(), film.GetTile(i).GetPosition()), 1);
+}
+
+TEST(ParallelForTilesTest, CanWriteEveryPixel)
+{
+    Film film;
+    film.SetResolution(Resolution800X600());
+
+    ThreadPool pool(4, SchedulingMode::WorkStealing);
+    ParallelForTiles(pool, film, [](FilmTile& tile)
+    {
+        for (int y = 0; y < tile.GetSize().y; ++y)
+            for (int x = 0; x < tile.GetSize().x; ++x)
+                tile.SetPixel({ x, y }, { 0.25, 0.5, 0.75 });
+    });
+
+    for (int i = 0; i < film.GetNumTiles(); ++i)
+    {
+        const FilmTile& tile = film.GetTile(i);
+        EXPECT_EQ(tile.GetTileSpacePixel({ 0, 0 }).m_TotalSplat, 1.0);
+        EXPECT_EQ(tile.GetTileSpacePixel({ tile.GetSize().x - 1, tile.GetSize().y - 1 }).m_TotalSplat, 1.0);
+    }
+}
+
+TEST(ParallelForTilesTest, CanDistributeTilesOverNumaNodes)
+{
+    Film film;
+    film.SetResolution(Resolution800X600());
+    film.GetTile(0).SetPixel({ 0, 0 }, { 0.25, 0.5, 0.75 });
+
+    CpuTopology topology({ { 0, 0, 0, 0 }, { 0, 1, 0, 1 } });
+    ThreadPool pool(4, SchedulingMode::WorkStealing, AffinityPolicy::Scatter, topology);
+    DistributeTilesOverNumaNodes(pool, film);
+
+    EXPECT_EQ(film.GetTile(0).GetNumaNode(), 0);
+    EXPECT_EQ(film.GetTile(film.GetNumTiles() - 1).GetNumaNode(), 1);
+    EXPECT_EQ(film.GetTile(0).GetTileSpacePixel({ 0, 0 }).m_TotalSplat, 0.0);
+
+    std::mutex mutex;
+    std::vector<Point2i> positions;
+    ParallelForTiles(pool, film, [&](FilmTile& tile)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        positions.push_back(tile.GetPosition());
+    });
+
+    ASSERT_EQ(positions.size(), film.GetNumTiles());
+    for (int i = 0; i < film.GetNumTiles(); ++i)
+        EXPECT_EQ(std::count(positions.begin(), positions.end(), film.GetTile(i).GetPosition()), 1);
+}
+
+TEST(ParallelForTilesTest, CanMergeTileAprons)
+{
+    Film parallelFilm, serialFilm;
+    for (Film* film : { &parallelFilm, &serialFilm })
+    {
+        film->SetResolution(Resolution640X360());
+        film->SetFilter(CreateFilter(FilterType::Gaussian));
+    }
+
+    Pcg32 rng(3, 0);
+    for (int i = 0; i < 5000; ++i)
+    {
+        Point2 position(rng.NextDouble() * 640, rng.NextDouble() * 360);
+        Point2i pixel((int)position.x, (int)position.y);
+        parallelFilm.GetTile(pixel).AddFilteredSample(position, 1.0);
+        serialFilm.GetTile(pixel).AddFilteredSample(position, 1.0);
+    }
+
+    ThreadPool pool(4, SchedulingMode::WorkStealing);
+    MergeTileAprons(pool, parallelFilm);
+    serialFilm.MergeAprons();
+
+    for (int y = 0; y < 360; ++y)
+    {
+        for (int x = 0; x < 640; ++x)
+        {
+            EXPECT_EQ(parallelFilm.GetTile({ x, y }).GetFilmSpacePixel({ x, y }).m_TotalSplat,
+                      serialFilm.GetTile({ x, y }).GetFilmSpacePixel({ x, y }).m_TotalSplat);
+        }
+    }
+}
+
+TEST(ParallelForTilesTest, CanRenderAdaptively)
+{
+    Film film;
+    film.SetResolution(Resolution640X360());
+    film.EnableStatistics();
+
+    AdaptiveSamplingSettings settings;
+    settings.m_MinSamples = 4;
+    settings.m_MaxSamples = 32;
+    AdaptiveTileScheduler scheduler(film, settings);
+
+    // Only the left column of tiles is noisy
+    ThreadPool pool(4, SchedulingMode::WorkStealing);
+    ParallelForAdaptiveTiles(pool, film, scheduler, [](FilmTile& tile, int firstSample, int numSamples)
+    {
+        Pcg32 rng(firstSample, tile.GetPosition().y);
+        for (int y = 0; y < tile.GetSize().y; ++y)
+        {
+            for (int x = 0; x < tile.GetSize().x; ++x)
+            {
+                for (int s = 0; s < numSamples; ++s)
+                    tile.RecordSample({ x, y }, tile.GetPosition().x == 0 ? rng.NextDouble() : 1.0);
+            }
+        }
+    });
+
+    for (int i = 0; i < film.GetNumTiles(); ++i)
+    {
+        bool isNoisy = film.GetTile(i).GetPosition().x == 0;
+        EXPECT_EQ(scheduler.GetNumSamples(i), isNoisy ? settings.m_MaxSamples : settings.m_MinSamples);
+    }
+}
@@ -0,0 +1,88 @@
+/*
+    This file is part of Spectre, an open-source physically based
+    spectral raytracing library.
+
+    Copyright (c) 2020-2023 Samuel Van Allen - All rights reserved.
+
+    Spectre is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "gtest.h"
+#include "core/film/pixelstatistics.h"
+
+#include <numeric>
+
+TEST(PixelStatisticsTest, MatchesTwoPassMoments)
+{
+    PixelStatistics statistics({ 4, 2 });
+    std::vector<double> values = { 0.3, 1.7, 0.2, 5.0, 0.9, 1.1, 2.4 };
+    for (double value : values)
+        statistics.AddSample({ 3, 1 }, value);
+
+    double mean = std::accumulate(values.begin(), values.end(), 0.0) / values.size();
+    double sumSquares = 0.0;
+    for (double value : values)
+        sumSquares += (value - mean) * (value - mean);
+    double variance = sumSquares / (values.size() - 1);
+
+    EXPECT_EQ(statistics.GetNumSamples({ 3, 1 }), values.size());
+    EXPECT_NEAR(statistics.GetMean({ 3, 1 }), mean, 1e-12);
+    EXPECT_NEAR(statistics.GetVariance({ 3, 1 }), variance, 1e-12);
+    EXPECT_NEAR(statistics.GetRelativeError({ 3, 1 }), std::sqrt(variance / values.size()) / mean, 1e-12);
+
+    EXPECT_EQ(statistics.GetNumSamples({ 0, 0 }), 0);
+    EXPECT_EQ(statistics.GetVariance({ 0, 0 }), 0.0);
+}
+
+TEST(PixelStatisticsTest, ErrorNeedsTwoSamples)
+{
+    PixelStatistics statistics({ 2, 2 });
+    EXPECT_TRUE(std::isinf(statistics.GetRelativeError({ 0, 0 })));
+
+    statistics.AddSample({ 0, 0 }, 1.0);
+    EXPECT_TRUE(std::isinf(statistics.GetRelativeError({ 0, 0 })));
+
+    statistics.AddSample({ 0, 0 }, 1.0);
+    EXPECT_EQ(statistics.GetRelativeError({ 0, 0 }), 0.0);
+    EXPECT_TRUE(std::isinf(statistics.GetMaxRelativeError()));
+}
+
+TEST(PixelStatisticsTest, DarkPixelsUseMinimumLuminance)
+{
+    PixelStatistics statistics({ 1, 1 });
+    statistics.AddSample({ 0, 0 }, 0.0);
+    statistics.AddSample({ 0, 0 }, 2e-4);
+
+    double standardError = std::sqrt(2e-8 / 2.0);
+    EXPECT_NEAR(statistics.GetRelativeError({ 0, 0 }), standardError / PixelStatistics::MinLuminance, 1e-12);
+}
+
+TEST(PixelStatisticsTest, CanClear)
+{
+    PixelStatistics statistics({ 2, 2 });
+    statistics.AddSample({ 1, 1 }, 3.0);
+    statistics.Clear();
+
+    EXPECT_EQ(statistics.GetNumSamples({ 1, 1 }), 0);
+    EXPECT_EQ(statistics.GetMean({ 1, 1 }), 0.0);
+}
+
+TEST(PixelStatisticsTest, ThrowOnInvalidInput)
+{
+    EXPECT_THROW(PixelStatistics({ 0, 2 }), std::invalid_argument);
+
+    PixelStatistics statistics({ 2, 2 });
+    EXPECT_THROW(statistics.GetMean({ 2, 0 }), std::invalid_argument);
+    EXPECT_THROW(statistics.GetVariance({ 0, -1 }), std::invalid_argument);
+}
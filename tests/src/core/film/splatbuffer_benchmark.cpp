@@ -0,0 +1,105 @@
+/*
+    This file is part of Spectre, an open-source physically based
+    spectral raytracing library.
+
+    Copyright (c) 2020-2023 Samuel Van Allen - All rights reserved.
+
+    Spectre is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "gtest.h"
+#include "core/film/splatbuffer.h"
+#include "core/film/standardresolution.h"
+
+#include <chrono>
+#include <iostream>
+
+// Contention benchmark for splatting from many threads. Light paths spread
+// splats over the frame, while caustics and small bright lights pile them
+// onto a few pixels; both patterns are measured. Disabled in the regular test
+// run, run it with --gtest_also_run_disabled_tests and raise NumSplats on a
+// many-core machine.
+namespace
+{
+    const int NumSplats = 200000;
+
+    // Mutex guarded layer as the baseline the lock-free modes replace
+    class LockedSplats
+    {
+    public:
+        LockedSplats(const Resolution& resolution) : m_Width(resolution.GetWidth()), m_Pixels(resolution.GetArea()) {}
+
+        void AddSplat(const Point2& position, const XyzCoefficients& xyz)
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_Pixels[(int)position.x + (int)position.y * m_Width] += xyz;
+        }
+
+    private:
+        int m_Width;
+        std::mutex m_Mutex;
+        std::vector<XyzCoefficients> m_Pixels;
+    };
+
+    template <typename Splats>
+    double RunSplats(Splats& splats, const Resolution& resolution, int numThreads, int hotspotSize)
+    {
+        auto start = std::chrono::steady_clock::now();
+
+        std::vector<std::thread> threads;
+        for (int t = 0; t < numThreads; ++t)
+        {
+            threads.emplace_back([&, t]()
+            {
+                Pcg32 rng(t, 17);
+                int width = hotspotSize > 0 ? hotspotSize : resolution.GetWidth();
+                int height = hotspotSize > 0 ? hotspotSize : resolution.GetHeight();
+                for (int i = 0; i < NumSplats / numThreads; ++i)
+                    splats.AddSplat({ rng.NextDouble() * width, rng.NextDouble() * height }, 0.1);
+            });
+        }
+
+        for (std::thread& thread : threads)
+            thread.join();
+
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+TEST(SplatBufferBenchmark, DISABLED_SplatContention)
+{
+    int numThreads = std::max(2, (int)std::thread::hardware_concurrency());
+    Resolution resolution = Resolution640X360();
+
+    for (int hotspotSize : { 0, 4 })
+    {
+        const char* pattern = hotspotSize > 0 ? "hotspot" : "spread";
+
+        LockedSplats locked(resolution);
+        double lockedMs = RunSplats(locked, resolution, numThreads, hotspotSize);
+
+        SplatBuffer atomic(resolution, SplatMode::Atomic);
+        double atomicMs = RunSplats(atomic, resolution, numThreads, hotspotSize);
+
+        SplatBuffer perThread(resolution, SplatMode::PerThread);
+        double perThreadMs = RunSplats(perThread, resolution, numThreads, hotspotSize);
+        auto reduceStart = std::chrono::steady_clock::now();
+        perThread.Reduce();
+        double reduceMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - reduceStart).count();
+
+        std::cout << "[ BENCHMARK ] Splats " << pattern << " (" << numThreads << " threads, " << NumSplats << " splats): "
+                  << "mutex " << lockedMs << " ms, atomic " << atomicMs << " ms, per thread " << perThreadMs
+                  << " ms + reduce " << reduceMs << " ms" << std::endl;
+    }
+}
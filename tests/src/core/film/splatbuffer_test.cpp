@@ -0,0 +1,154 @@
+/*
+    This file is part of Spectre, an open-source physically based
+    spectral raytracing library.
+
+    Copyright (c) 2020-2023 Samuel Van Allen - All rights reserved.
+
+    Spectre is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "gtest.h"
+#include "core/film/splatbuffer.h"
+#include "core/film/standardresolution.h"
+
+namespace
+{
+    Resolution SmallResolution()
+    {
+        Resolution resolution;
+        resolution.SetWidth(16);
+        resolution.SetHeight(8);
+        return resolution;
+    }
+
+    // Every thread splats one unit into every pixel, repeated a few times
+    void SplatFromThreads(SplatBuffer& buffer, int numThreads, int repeats)
+    {
+        std::vector<std::thread> threads;
+        for (int t = 0; t < numThreads; ++t)
+        {
+            threads.emplace_back([&buffer, repeats]()
+            {
+                for (int r = 0; r < repeats; ++r)
+                {
+                    for (int y = 0; y < 8; ++y)
+                    {
+                        for (int x = 0; x < 16; ++x)
+                            buffer.AddSplat({ x + 0.5, y + 0.5 }, { 1.0, 2.0, 0.5 });
+                    }
+                }
+            });
+        }
+
+        for (std::thread& thread : threads)
+            thread.join();
+    }
+}
+
+TEST(SplatBufferTest, AtomicSplatsFromManyThreads)
+{
+    SplatBuffer buffer(SmallResolution(), SplatMode::Atomic);
+    SplatFromThreads(buffer, 4, 50);
+    buffer.Reduce();
+
+    EXPECT_EQ(buffer.GetNumThreadLayers(), 0);
+    for (int y = 0; y < 8; ++y)
+    {
+        for (int x = 0; x < 16; ++x)
+        {
+            XyzCoefficients xyz = buffer.GetPixel({ x, y });
+            EXPECT_DOUBLE_EQ(xyz[0], SpectralReal(200.0));
+            EXPECT_DOUBLE_EQ(xyz[1], SpectralReal(400.0));
+            EXPECT_DOUBLE_EQ(xyz[2], SpectralReal(100.0));
+        }
+    }
+}
+
+TEST(SplatBufferTest, PerThreadSplatsCountAfterReduce)
+{
+    SplatBuffer buffer(SmallResolution(), SplatMode::PerThread);
+    SplatFromThreads(buffer, 4, 50);
+
+    EXPECT_EQ(buffer.GetNumThreadLayers(), 4);
+    EXPECT_TRUE(buffer.HasUnreducedSplats());
+    EXPECT_THROW(buffer.GetPixel({ 3, 3 }), std::runtime_error);
+
+    buffer.Reduce();
+    for (int y = 0; y < 8; ++y)
+    {
+        for (int x = 0; x < 16; ++x)
+        {
+            XyzCoefficients xyz = buffer.GetPixel({ x, y });
+            EXPECT_DOUBLE_EQ(xyz[0], SpectralReal(200.0));
+            EXPECT_DOUBLE_EQ(xyz[1], SpectralReal(400.0));
+            EXPECT_DOUBLE_EQ(xyz[2], SpectralReal(100.0));
+        }
+    }
+
+    // Reducing again must not count the layers twice
+    buffer.Reduce();
+    EXPECT_DOUBLE_EQ(buffer.GetPixel({ 3, 3 })[0], SpectralReal(200.0));
+}
+
+TEST(SplatBufferTest, DropsSplatsOutsideOfFilm)
+{
+    for (SplatMode mode : { SplatMode::Atomic, SplatMode::PerThread })
+    {
+        SplatBuffer buffer(SmallResolution(), mode);
+        buffer.AddSplat({ -0.5, 2.0 }, 1.0);
+        buffer.AddSplat({ 16.0, 2.0 }, 1.0);
+        buffer.AddSplat({ 2.0, 8.5 }, 1.0);
+        buffer.AddSplat({ 15.9, 7.9 }, 1.0);
+        buffer.Reduce();
+
+        SpectralReal total = 0;
+        for (int y = 0; y < 8; ++y)
+        {
+            for (int x = 0; x < 16; ++x)
+                total += buffer.GetPixel({ x, y })[0];
+        }
+
+        EXPECT_DOUBLE_EQ(total, SpectralReal(1.0));
+        EXPECT_DOUBLE_EQ(buffer.GetPixel({ 15, 7 })[0], SpectralReal(1.0));
+        EXPECT_THROW(buffer.GetPixel({ 16, 0 }), std::invalid_argument);
+    }
+}
+
+TEST(SplatBufferTest, CanClear)
+{
+    SplatBuffer buffer(SmallResolution(), SplatMode::PerThread);
+    buffer.AddSplat({ 1.5, 1.5 }, 1.0);
+    buffer.Reduce();
+    buffer.AddSplat({ 1.5, 1.5 }, 1.0);
+    buffer.Clear();
+    buffer.Reduce();
+
+    EXPECT_DOUBLE_EQ(buffer.GetPixel({ 1, 1 })[0], SpectralReal(0.0));
+}
+
+TEST(SplatBufferTest, SeparateBuffersOnOneThread)
+{
+    SplatBuffer first(SmallResolution(), SplatMode::PerThread);
+    SplatBuffer second(SmallResolution(), SplatMode::PerThread);
+
+    first.AddSplat({ 0.5, 0.5 }, 1.0);
+    second.AddSplat({ 0.5, 0.5 }, 2.0);
+    first.AddSplat({ 0.5, 0.5 }, 1.0);
+    first.Reduce();
+    second.Reduce();
+
+    EXPECT_EQ(first.GetNumThreadLayers(), 1);
+    EXPECT_DOUBLE_EQ(first.GetPixel({ 0, 0 })[0], SpectralReal(2.0));
+    EXPECT_DOUBLE_EQ(second.GetPixel({ 0, 0 })[0], SpectralReal(2.0));
+}
@@ -32,12 +32,12 @@ TEST(TonemapperTest, CanApplyGammaCorrection)
     TonemapperStub stub;
     RgbCoefficients col = 0.5;
 
-    EXPECT_DOUBLE_EQ(stub.ApplyGammaCorrection(col)[0], std::pow(col[0], 1.0 / 2.2));
-    EXPECT_DOUBLE_EQ(stub.ApplyGammaCorrection(col)[1], std::pow(col[1], 1.0 / 2.2));
-    EXPECT_DOUBLE_EQ(stub.ApplyGammaCorrection(col)[2], std::pow(col[2], 1.0 / 2.2));
+    EXPECT_DOUBLE_EQ(stub.ApplyGammaCorrection(col)[0], SpectralReal(std::pow(col[0], 1.0 / 2.2)));
+    EXPECT_DOUBLE_EQ(stub.ApplyGammaCorrection(col)[1], SpectralReal(std::pow(col[1], 1.0 / 2.2)));
+    EXPECT_DOUBLE_EQ(stub.ApplyGammaCorrection(col)[2], SpectralReal(std::pow(col[2], 1.0 / 2.2)));
 
-    EXPECT_DOUBLE_EQ(stub.ApplyGammaCorrection(col, 2.0)[0], std::sqrt(col[0]));
-    EXPECT_DOUBLE_EQ(stub.ApplyGammaCorrection(col, 2.0)[1], std::sqrt(col[1]));
-    EXPECT_DOUBLE_EQ(stub.ApplyGammaCorrection(col, 2.0)[2], std::sqrt(col[2]));
+    EXPECT_DOUBLE_EQ(stub.ApplyGammaCorrection(col, 2.0)[0], SpectralReal(std::sqrt(col[0])));
+    EXPECT_DOUBLE_EQ(stub.ApplyGammaCorrection(col, 2.0)[1], SpectralReal(std::sqrt(col[1])));
+    EXPECT_DOUBLE_EQ(stub.ApplyGammaCorrection(col, 2.0)[2], SpectralReal(std::sqrt(col[2])));
 }
 
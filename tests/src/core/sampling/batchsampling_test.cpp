@@ -0,0 +1,138 @@
+/*
+    This file is part of Spectre, an open-source physically based
+    spectral raytracing library.
+
+    Copyright (c) 2020-2023 Samuel Van Allen - All rights reserved.
+
+    Spectre is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "gtest.h"
+#include "core/sampling/sampling.h"
+#include "core/sampling/batchsampling.h"
+
+namespace
+{
+    // An odd count exercises the scalar remainder after the full packs, and
+    // the first entries hit the edges of the unit square
+    struct Inputs
+    {
+        Inputs()
+        {
+            Pcg32 rng;
+            u0 = { 0.0, 0.5, 0.5, 0.9999999, 0.25 };
+            u1 = { 0.0, 0.5, 0.9, 0.9999999, 0.75 };
+            while (u0.size() < 1001)
+            {
+                u0.push_back(rng.NextDouble());
+                u1.push_back(rng.NextDouble());
+            }
+        }
+
+        inline Point2 Get(size_t i) const { return Point2(u0[i], u1[i]); }
+        inline size_t GetSize() const { return u0.size(); }
+
+        std::vector<double> u0;
+        std::vector<double> u1;
+    };
+
+    const double Tolerance = 1e-12;
+}
+
+TEST(BatchSamplingTest, MatchesScalarSphericalWarps)
+{
+    Inputs inputs;
+    size_t count = inputs.GetSize();
+    std::vector<double> x(count), y(count), z(count);
+
+    Sampling::UniformSampleHemisphere(inputs.u0, inputs.u1, x, y, z);
+    for (size_t i = 0; i < count; ++i)
+    {
+        Point3 expected = Sampling::UniformSampleHemisphere(inputs.Get(i));
+        ASSERT_NEAR(x[i], expected.x, Tolerance);
+        ASSERT_NEAR(y[i], expected.y, Tolerance);
+        ASSERT_NEAR(z[i], expected.z, Tolerance);
+    }
+
+    Sampling::UniformSampleSphere(inputs.u0, inputs.u1, x, y, z);
+    for (size_t i = 0; i < count; ++i)
+    {
+        Point3 expected = Sampling::UniformSampleSphere(inputs.Get(i));
+        ASSERT_NEAR(x[i], expected.x, Tolerance);
+        ASSERT_NEAR(y[i], expected.y, Tolerance);
+        ASSERT_NEAR(z[i], expected.z, Tolerance);
+    }
+
+    Sampling::UniformSampleCone(inputs.u0, inputs.u1, 0.8, x, y, z);
+    for (size_t i = 0; i < count; ++i)
+    {
+        Point3 expected = Sampling::UniformSampleCone(inputs.Get(i), 0.8);
+        ASSERT_NEAR(x[i], expected.x, Tolerance);
+        ASSERT_NEAR(y[i], expected.y, Tolerance);
+        ASSERT_NEAR(z[i], expected.z, Tolerance);
+        ASSERT_GE(z[i], 0.8 - Tolerance);
+    }
+}
+
+TEST(BatchSamplingTest, MatchesScalarDiskWarps)
+{
+    Inputs inputs;
+    size_t count = inputs.GetSize();
+    std::vector<double> x(count), y(count), z(count);
+
+    Sampling::ConcentricSampleDisk(inputs.u0, inputs.u1, x, y);
+    for (size_t i = 0; i < count; ++i)
+    {
+        Point2 expected = Sampling::ConcentricSampleDisk(inputs.Get(i));
+        ASSERT_NEAR(x[i], expected.x, Tolerance);
+        ASSERT_NEAR(y[i], expected.y, Tolerance);
+    }
+
+    Sampling::CosineSampleHemisphere(inputs.u0, inputs.u1, x, y, z);
+    for (size_t i = 0; i < count; ++i)
+    {
+        Point3 expected = Sampling::CosineSampleHemisphere(inputs.Get(i));
+        ASSERT_NEAR(x[i], expected.x, Tolerance);
+        ASSERT_NEAR(y[i], expected.y, Tolerance);
+        ASSERT_NEAR(z[i], expected.z, Tolerance);
+    }
+
+    Sampling::UniformSampleTriangle(inputs.u0, inputs.u1, x, y);
+    for (size_t i = 0; i < count; ++i)
+    {
+        Point2 expected = Sampling::UniformSampleTriangle(inputs.Get(i));
+        ASSERT_NEAR(x[i], expected.x, Tolerance);
+        ASSERT_NEAR(y[i], expected.y, Tolerance);
+        ASSERT_LE(x[i] + y[i], 1.0 + Tolerance);
+    }
+}
+
+TEST(BatchSamplingTest, AcceptsUnalignedSpans)
+{
+    Inputs inputs;
+    std::vector<double> x(inputs.GetSize() + 1), y(inputs.GetSize() + 1);
+
+    std::span<const double> u0 = std::span<const double>(inputs.u0).subspan(1);
+    std::span<const double> u1 = std::span<const double>(inputs.u1).subspan(1);
+    Sampling::ConcentricSampleDisk(u0, u1, std::span<double>(x).subspan(1, u0.size()), std::span<double>(y).subspan(1, u0.size()));
+
+    for (size_t i = 0; i < u0.size(); ++i)
+        ASSERT_NEAR(x[i + 1], Sampling::ConcentricSampleDisk(Point2(u0[i], u1[i])).x, Tolerance);
+}
+
+TEST(BatchSamplingTest, ThrowOnMismatchedSizes)
+{
+    std::vector<double> u(8), x(8), y(7);
+    EXPECT_THROW(Sampling::ConcentricSampleDisk(u, u, x, y), std::invalid_argument);
+}
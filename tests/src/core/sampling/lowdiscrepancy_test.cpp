@@ -0,0 +1,137 @@
+/*
+    This file is part of Spectre, an open-source physically based
+    spectral raytracing library.
+
+    Copyright (c) 2020-2023 Samuel Van Allen - All rights reserved.
+
+    Spectre is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "gtest.h"
+#include "core/sampling/lowdiscrepancy.h"
+
+namespace
+{
+    // Every 2^a by 2^b cell with a + b = log2(count) holds exactly one point
+    bool IsZeroTwoNet(const std::vector<Point2>& points)
+    {
+        int m = std::countr_zero(points.size());
+        for (int a = 0; a <= m; ++a)
+        {
+            int cellsX = 1 << a;
+            int cellsY = 1 << (m - a);
+            std::vector<int> counts(points.size(), 0);
+            for (const Point2& p : points)
+                ++counts[(int)(p.x * cellsX) + (int)(p.y * cellsY) * cellsX];
+
+            if (std::count(counts.begin(), counts.end(), 1) != (int)points.size())
+                return false;
+        }
+
+        return true;
+    }
+}
+
+TEST(LowDiscrepancyTest, CanReverseBits)
+{
+    EXPECT_EQ(LowDiscrepancy::ReverseBits32(1), 0x80000000u);
+    EXPECT_EQ(LowDiscrepancy::ReverseBits32(0x0000f00fu), 0xf00f0000u);
+}
+
+TEST(LowDiscrepancyTest, OwenScramblePreservesIntervals)
+{
+    // Values that share their top bits keep sharing them after scrambling
+    for (uint32_t seed : { 1u, 1234u, 0xdeadbeefu })
+    {
+        uint32_t a = LowDiscrepancy::OwenScramble(0xab000000u, seed);
+        uint32_t b = LowDiscrepancy::OwenScramble(0xab00ffffu, seed);
+        EXPECT_EQ(a >> 24, b >> 24);
+    }
+}
+
+TEST(LowDiscrepancyTest, SobolFirstDimensionsFormZeroTwoNets)
+{
+    for (uint32_t seed : { 0u, 7u, 99991u })
+    {
+        for (int count : { 16, 64, 256 })
+        {
+            std::vector<Point2> points;
+            for (int i = 0; i < count; ++i)
+                points.push_back({ LowDiscrepancy::SobolSample(i, 0, seed), LowDiscrepancy::SobolSample(i, 1, seed * 3 + 1) });
+
+            EXPECT_TRUE(IsZeroTwoNet(points));
+        }
+    }
+}
+
+TEST(LowDiscrepancyTest, SobolDimensionsAreStratified)
+{
+    const int NumSamples = 64;
+    for (int dimension = 0; dimension < LowDiscrepancy::NumSobolDimensions; ++dimension)
+    {
+        std::vector<int> counts(NumSamples, 0);
+        for (int i = 0; i < NumSamples; ++i)
+        {
+            double u = LowDiscrepancy::SobolSample(i, dimension, 42);
+            ASSERT_GE(u, 0.0);
+            ASSERT_LT(u, 1.0);
+            ++counts[(int)(u * NumSamples)];
+        }
+
+        EXPECT_EQ(std::count(counts.begin(), counts.end(), 1), NumSamples) << "dimension " << dimension;
+    }
+}
+
+TEST(LowDiscrepancyTest, CanPermuteIndices)
+{
+    for (uint32_t count : { 1u, 7u, 16u, 100u })
+    {
+        std::vector<bool> seen(count, false);
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            uint32_t permuted = LowDiscrepancy::PermuteIndex(i, count, 12345);
+            ASSERT_LT(permuted, count);
+            EXPECT_FALSE(seen[permuted]);
+            seen[permuted] = true;
+        }
+    }
+}
+
+TEST(LowDiscrepancyTest, HaltonUsesPrimeBases)
+{
+    EXPECT_EQ(LowDiscrepancy::GetHaltonBase(0), 2);
+    EXPECT_EQ(LowDiscrepancy::GetHaltonBase(1), 3);
+    EXPECT_EQ(LowDiscrepancy::GetHaltonBase(4), 11);
+    EXPECT_EQ(LowDiscrepancy::GetHaltonBase(LowDiscrepancy::NumHaltonDimensions - 1), 311);
+}
+
+TEST(LowDiscrepancyTest, ScrambledRadicalInverseIsStratified)
+{
+    // base^2 consecutive indices land in distinct intervals of size 1/base^2
+    for (int dimension : { 0, 1, 2, 5 })
+    {
+        int base = LowDiscrepancy::GetHaltonBase(dimension);
+        int count = base * base;
+        std::vector<int> counts(count, 0);
+        for (int i = 0; i < count; ++i)
+        {
+            double u = LowDiscrepancy::ScrambledRadicalInverse(i, dimension, 777);
+            ASSERT_GE(u, 0.0);
+            ASSERT_LT(u, 1.0);
+            ++counts[(int)(u * count)];
+        }
+
+        EXPECT_EQ(std::count(counts.begin(), counts.end(), 1), count) << "base " << base;
+    }
+}
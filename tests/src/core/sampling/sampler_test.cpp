@@ -0,0 +1,158 @@
+/*
+    This file is part of Spectre, an open-source physically based
+    spectral raytracing library.
+
+    Copyright (c) 2020-2023 Samuel Van Allen - All rights reserved.
+
+    Spectre is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "gtest.h"
+#include "core/sampling/sampler.h"
+
+namespace
+{
+    const SamplerType AllSamplerTypes[] = { SamplerType::Independent, SamplerType::Halton, SamplerType::Sobol, SamplerType::Pmj02 };
+}
+
+TEST(SamplerTest, ThrowOnInvalidArguments)
+{
+    EXPECT_THROW(CreateSampler(SamplerType::Sobol, 0), std::invalid_argument);
+
+    auto sampler = CreateSampler(SamplerType::Sobol, 16);
+    EXPECT_THROW(sampler->StartPixelSample({ 0, 0 }, -1), std::invalid_argument);
+}
+
+TEST(SamplerTest, TracksDimensions)
+{
+    for (SamplerType type : AllSamplerTypes)
+    {
+        auto sampler = CreateSampler(type, 16);
+        sampler->StartPixelSample({ 3, 4 }, 5);
+        EXPECT_EQ(sampler->GetPixel(), Point2i(3, 4));
+        EXPECT_EQ(sampler->GetSampleIndex(), 5);
+
+        sampler->Get1D();
+        sampler->Get2D();
+        EXPECT_EQ(sampler->GetDimension(), 3);
+
+        sampler->StartPixelSample({ 3, 4 }, 6, 10);
+        EXPECT_EQ(sampler->GetDimension(), 10);
+    }
+}
+
+TEST(SamplerTest, IsReproducible)
+{
+    for (SamplerType type : AllSamplerTypes)
+    {
+        auto sampler = CreateSampler(type, 16, 3);
+        auto clone = sampler->Clone();
+
+        // Samples taken out of order and from different copies must agree
+        std::vector<double> values;
+        for (int i = 0; i < 16; ++i)
+        {
+            sampler->StartPixelSample({ 7, 9 }, i);
+            values.push_back(sampler->Get1D());
+            values.push_back(sampler->Get2D().y);
+        }
+
+        for (int i = 15; i >= 0; --i)
+        {
+            clone->StartPixelSample({ 7, 9 }, i);
+            EXPECT_EQ(clone->Get1D(), values[i * 2]);
+            EXPECT_EQ(clone->Get2D().y, values[i * 2 + 1]);
+        }
+
+        // Starting at a later dimension skips the earlier ones
+        clone->StartPixelSample({ 7, 9 }, 4, 1);
+        EXPECT_EQ(clone->Get2D().y, values[4 * 2 + 1]);
+    }
+}
+
+TEST(SamplerTest, DecorrelatesPixelsAndSeeds)
+{
+    for (SamplerType type : AllSamplerTypes)
+    {
+        auto sampler = CreateSampler(type, 16);
+        auto seeded = CreateSampler(type, 16, 1);
+
+        sampler->StartPixelSample({ 0, 0 }, 0);
+        double reference = sampler->Get1D();
+
+        sampler->StartPixelSample({ 1, 0 }, 0);
+        EXPECT_NE(sampler->Get1D(), reference);
+
+        seeded->StartPixelSample({ 0, 0 }, 0);
+        EXPECT_NE(seeded->Get1D(), reference);
+    }
+}
+
+TEST(SamplerTest, StratifiesEveryDimension)
+{
+    const int NumSamples = 64;
+    for (SamplerType type : { SamplerType::Sobol, SamplerType::Pmj02 })
+    {
+        auto sampler = CreateSampler(type, NumSamples);
+
+        // Dimensions 0 and 1 as well as the later 2D dimensions 5 and 6
+        for (int dimension : { 0, 5 })
+        {
+            std::vector<int> countsX(NumSamples, 0);
+            std::vector<int> countsY(NumSamples, 0);
+            for (int i = 0; i < NumSamples; ++i)
+            {
+                sampler->StartPixelSample({ 11, 2 }, i, dimension);
+                Point2 u = sampler->Get2D();
+                ++countsX[(int)(u.x * NumSamples)];
+                ++countsY[(int)(u.y * NumSamples)];
+            }
+
+            EXPECT_EQ(std::count(countsX.begin(), countsX.end(), 1), NumSamples);
+            EXPECT_EQ(std::count(countsY.begin(), countsY.end(), 1), NumSamples);
+        }
+    }
+}
+
+TEST(SamplerTest, ReducesIntegrationError)
+{
+    // Integrates x * y over the unit square, which is 1/4, across many pixels
+    const int NumSamples = 64;
+    const int NumPixels = 64;
+
+    auto computeError = [](SamplerType type)
+    {
+        auto sampler = CreateSampler(type, NumSamples);
+        double totalError = 0;
+        for (int pixel = 0; pixel < NumPixels; ++pixel)
+        {
+            double sum = 0;
+            for (int i = 0; i < NumSamples; ++i)
+            {
+                sampler->StartPixelSample({ pixel, 0 }, i);
+                Point2 u = sampler->Get2D();
+                sum += u.x * u.y;
+            }
+
+            totalError += std::abs(sum / NumSamples - 0.25);
+        }
+
+        return totalError / NumPixels;
+    };
+
+    double independentError = computeError(SamplerType::Independent);
+    EXPECT_LT(computeError(SamplerType::Halton), independentError);
+    EXPECT_LT(computeError(SamplerType::Sobol), independentError);
+    EXPECT_LT(computeError(SamplerType::Pmj02), independentError);
+}
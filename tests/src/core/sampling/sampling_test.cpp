@@ -160,3 +160,18 @@ TEST(SamplingTest, CanSampleDiskUniformly_ConcentricMethod)
 
     CheckUniformity(samples, Math::Pi);
 }
+
+TEST(SamplingTest, WarpsExplicitSamples)
+{
+    EXPECT_EQ(Sampling::ConcentricSampleDisk(Point2(0.5, 0.5)), Point2(0, 0));
+    EXPECT_NEAR(Sampling::ConcentricSampleDisk(Point2(1.0, 0.5)).x, 1.0, 1e-12);
+    EXPECT_NEAR(Sampling::UniformSampleHemisphere(Point2(1.0, 0.0)).y, 1.0, 1e-12);
+    EXPECT_NEAR(Sampling::UniformSampleSphere(Point2(0.0, 0.0)).z, 1.0, 1e-12);
+    EXPECT_NEAR(Sampling::CosineSampleHemisphere(Point2(0.5, 0.5)).z, 1.0, 1e-12);
+
+    // Stratified inputs stay stratified: every quadrant of u maps to one
+    // quadrant of the disk
+    Point2 disk = Sampling::ConcentricSampleDisk(Point2(0.9, 0.9));
+    EXPECT_GT(disk.x, 0.0);
+    EXPECT_GT(disk.y, 0.0);
+}
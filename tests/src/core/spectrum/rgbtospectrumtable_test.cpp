@@ -0,0 +1,87 @@
+/*
+    This file is part of Spectre, an open-source physically based
+    spectral raytracing library.
+
+    Copyright (c) 2020-2023 Samuel Van Allen - All rights reserved.
+
+    Spectre is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "gtest.h"
+#include "core/spectrum/reflectantspectrum.h"
+#include "system/platform/executablepath.h"
+
+TEST(RgbToSpectrumTableTest, CanLoadGeneratedTable)
+{
+    RgbToSpectrumTable table;
+    EXPECT_GT(table.GetResolution(), 1);
+}
+
+TEST(RgbToSpectrumTableTest, IsFoundNextToTheExecutable)
+{
+    if (std::getenv("SPC_DATA_DIR") != nullptr)
+        GTEST_SKIP();
+
+    std::filesystem::path path = RgbToSpectrumTable::GetDefaultPath();
+    EXPECT_EQ(path.parent_path(), GetExecutableDirectory() / "data");
+    EXPECT_TRUE(std::filesystem::exists(path));
+}
+
+TEST(RgbToSpectrumTableTest, InvalidFilesThrow)
+{
+    EXPECT_THROW(RgbToSpectrumTable("does/not/exist.spec"), std::runtime_error);
+}
+
+TEST(RgbToSpectrumTableTest, GreysAreConstant)
+{
+    RgbToSpectrumTable table;
+
+    SigmoidPolynomial grey = table.Lookup({ 0.25, 0.25, 0.25 });
+    EXPECT_NEAR(grey.Evaluate(400.0), 0.25, 1e-12);
+    EXPECT_NEAR(grey.Evaluate(700.0), 0.25, 1e-12);
+
+    EXPECT_DOUBLE_EQ(table.Lookup({ 0.0, 0.0, 0.0 }).Evaluate(550.0), 0.0);
+    EXPECT_DOUBLE_EQ(table.Lookup({ 1.0, 1.0, 1.0 }).Evaluate(550.0), 1.0);
+}
+
+TEST(RgbToSpectrumTableTest, UpliftFollowsDominantComponent)
+{
+    RgbToSpectrumTable table;
+
+    SigmoidPolynomial red = table.Lookup({ 0.8, 0.1, 0.1 });
+    SigmoidPolynomial blue = table.Lookup({ 0.1, 0.1, 0.8 });
+    EXPECT_GT(red.Evaluate(650.0), red.Evaluate(450.0));
+    EXPECT_GT(blue.Evaluate(450.0), blue.Evaluate(650.0));
+}
+
+TEST(RgbToSpectrumTableTest, UpliftedReflectanceMatchesSmits)
+{
+    // Both uplifts should agree on the colour of a moderately saturated
+    // reflectance, even though their spectra differ
+    RgbToSpectrumTable table;
+    RgbCoefficients rgb = { 0.6, 0.4, 0.2 };
+
+    XyzCoefficients fitted = ReflectantSpectrum(rgb, table).ToXyz();
+    XyzCoefficients smits = ReflectantSpectrum(rgb).ToXyz();
+
+    for (int i = 0; i < 3; ++i)
+        EXPECT_NEAR(fitted[i], smits[i], 0.05);
+
+    ReflectantSpectrum s(rgb, table);
+    for (int i = 0; i < NumSpectralSamples; ++i)
+    {
+        EXPECT_GE(s.m_Coefficients[i], 0.0);
+        EXPECT_LE(s.m_Coefficients[i], 1.0);
+    }
+}
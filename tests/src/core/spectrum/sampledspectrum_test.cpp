@@ -22,6 +22,60 @@
 #include "core/spectrum/sampledspectrum.h"
 #include "core/spectrum/spectralconstants.h"
 
+namespace
+{
+    // Per bin reference for the single pass resampling: the area under the
+    // piecewise linear samples within a range, with the end samples extended
+    // as constants beyond the data
+    double ComputeSegmentArea(const SpectralSample& s1, const SpectralSample& s2, double leftBound, double rightBound)
+    {
+        double sampleRangeL = std::max(s1.m_Wavelength, leftBound);
+        double sampleRangeR = std::min(s2.m_Wavelength, rightBound);
+
+        double unclampedRange = s2.m_Wavelength - s1.m_Wavelength;
+        double clampedRange = sampleRangeR - sampleRangeL;
+
+        double powerL = std::lerp(s1.m_Power, s2.m_Power, (sampleRangeL - s1.m_Wavelength) / unclampedRange);
+        double powerR = std::lerp(s1.m_Power, s2.m_Power, (sampleRangeR - s1.m_Wavelength) / unclampedRange);
+        return ((powerL + powerR) / 2) * clampedRange;
+    }
+
+    double ComputeBoundaryArea(const SampleArray& samples, double leftBound, double rightBound)
+    {
+        double leftBoundRange = std::max(0.0, samples.front().m_Wavelength - leftBound);
+        double rightBoundRange = std::max(0.0, rightBound - samples.back().m_Wavelength);
+        return samples.front().m_Power * leftBoundRange + samples.back().m_Power * rightBoundRange;
+    }
+
+    double ComputeAreaSum(const SampleArray& samples, double leftBound, double rightBound)
+    {
+        double sum = 0;
+        int i = 0;
+        while (samples[i + 1].m_Wavelength < leftBound) ++i;
+
+        for (; i + 1 < samples.size(); ++i)
+        {
+            if (samples[i].m_Wavelength > rightBound)
+                break;
+
+            sum += ComputeSegmentArea(samples[i], samples[i + 1], leftBound, rightBound);
+        }
+
+        return sum + ComputeBoundaryArea(samples, leftBound, rightBound);
+    }
+
+    double ComputeAverageInRange(const SampleArray& samples, double leftBound, double rightBound)
+    {
+        if (samples.size() == 1 || samples.front().m_Wavelength >= rightBound)
+            return samples.front().m_Power;
+
+        if (samples.back().m_Wavelength <= leftBound)
+            return samples.back().m_Power;
+
+        return ComputeAreaSum(samples, leftBound, rightBound) / (rightBound - leftBound);
+    }
+}
+
 TEST(SampledSpectrumTest, CanBeCreated)
 {
     SampleArray samples = { {400, 0.1}, {410, 0.1}, {420, 0.1}, {430, 0.1}, {440, 0.1} };
@@ -64,28 +118,26 @@ TEST(SampledSpectrumTest, CanComputeWavelengthRange)
 
 TEST(SampledSpectrumTest, CanComputeAreaSum)
 {
-    SampledSpectrum s;
     SampleArray samples = { {400, 1}, {410, 2}, {420, 5}, {430, 3}, {440, 8} };
 
-    EXPECT_DOUBLE_EQ(s.ComputeAreaSum(samples, 400, 410), 15);
-    EXPECT_DOUBLE_EQ(s.ComputeAreaSum(samples, 390, 410), 25);
-    EXPECT_DOUBLE_EQ(s.ComputeAreaSum(samples, 405, 410), 1.75 * 5);
-    EXPECT_DOUBLE_EQ(s.ComputeAreaSum(samples, 410, 430), 75);
-    EXPECT_DOUBLE_EQ(s.ComputeAreaSum(samples, 430, 440), 55);
-    EXPECT_DOUBLE_EQ(s.ComputeAreaSum(samples, 435, 445), 40 + 6.75 * 5);
+    EXPECT_DOUBLE_EQ(ComputeAreaSum(samples, 400, 410), 15);
+    EXPECT_DOUBLE_EQ(ComputeAreaSum(samples, 390, 410), 25);
+    EXPECT_DOUBLE_EQ(ComputeAreaSum(samples, 405, 410), 1.75 * 5);
+    EXPECT_DOUBLE_EQ(ComputeAreaSum(samples, 410, 430), 75);
+    EXPECT_DOUBLE_EQ(ComputeAreaSum(samples, 430, 440), 55);
+    EXPECT_DOUBLE_EQ(ComputeAreaSum(samples, 435, 445), 40 + 6.75 * 5);
 }
 
 TEST(SampledSpectrumTest, CanComputeAverageSamples)
 {
-    SampledSpectrum a;
     SampleArray samples = { {400, 0.2}, {410, 0.3}, {420, 0.4}, {430, 0.5}, {440, 0.6}, {500, 0.3}, {600, 0.2}, {650, 0.5}, {700, 0.9} };
 
-    EXPECT_DOUBLE_EQ(a.ComputeAverageInRange(samples, 300, 400), 0.2);
-    EXPECT_DOUBLE_EQ(a.ComputeAverageInRange(samples, 400, 410), 0.25);
-    EXPECT_DOUBLE_EQ(a.ComputeAverageInRange(samples, 400, 420), 0.3);
-    EXPECT_DOUBLE_EQ(a.ComputeAverageInRange(samples, 415, 425), 0.4);
-    EXPECT_DOUBLE_EQ(a.ComputeAverageInRange(samples, 440, 500), 0.45);
-    EXPECT_DOUBLE_EQ(a.ComputeAverageInRange(samples, 700, 800), 0.9);
+    EXPECT_DOUBLE_EQ(ComputeAverageInRange(samples, 300, 400), 0.2);
+    EXPECT_DOUBLE_EQ(ComputeAverageInRange(samples, 400, 410), 0.25);
+    EXPECT_DOUBLE_EQ(ComputeAverageInRange(samples, 400, 420), 0.3);
+    EXPECT_DOUBLE_EQ(ComputeAverageInRange(samples, 415, 425), 0.4);
+    EXPECT_DOUBLE_EQ(ComputeAverageInRange(samples, 440, 500), 0.45);
+    EXPECT_DOUBLE_EQ(ComputeAverageInRange(samples, 700, 800), 0.9);
 }
 
 TEST(SampledSpectrumTest, CanBeCreatedFromRawSamples)
@@ -178,3 +230,115 @@ TEST(SampledSpectrumTest, CanConvertToRgb)
     EXPECT_LT(abs(rgb[2] - 0.909), tolerance);
 }
 
+
+TEST(SampledSpectrumTest, FusedXyzMatchesReferenceIntegration)
+{
+    SampledSpectrum s;
+    for (int i = 0; i < NumSpectralSamples; ++i)
+        s.m_Coefficients[i] = 0.5 + 0.5 * std::sin(i * 0.3);
+
+    XyzCoefficients reference;
+    for (int i = 0; i < NumSpectralSamples; ++i)
+    {
+        reference[0] += SampledSpectrum::cieX.m_Coefficients[i] * s.m_Coefficients[i];
+        reference[1] += SampledSpectrum::cieY.m_Coefficients[i] * s.m_Coefficients[i];
+        reference[2] += SampledSpectrum::cieZ.m_Coefficients[i] * s.m_Coefficients[i];
+    }
+    reference = reference * SampledSpectrum::GetXyzNormalizationConstant();
+
+    const double tolerance = std::is_same_v<SpectralReal, float> ? 1e-5 : 1e-12;
+    XyzCoefficients xyz = s.ToXyz();
+    EXPECT_NEAR(xyz[0], reference[0], tolerance);
+    EXPECT_NEAR(xyz[1], reference[1], tolerance);
+    EXPECT_NEAR(xyz[2], reference[2], tolerance);
+}
+
+TEST(SampledSpectrumTest, CanConvertBatchToXyz)
+{
+    const int numSpectra = 11;
+    std::vector<SampledSpectrum> spectra(numSpectra);
+    for (int i = 0; i < numSpectra; ++i)
+        for (int j = 0; j < NumSpectralSamples; ++j)
+            spectra[i].m_Coefficients[j] = (i + 1) * 0.05 + j * 0.01;
+
+    std::vector<XyzCoefficients> xyz(numSpectra);
+    SampledSpectrum::ToXyz(spectra, xyz);
+
+    for (int i = 0; i < numSpectra; ++i)
+    {
+        XyzCoefficients expected = spectra[i].ToXyz();
+        EXPECT_DOUBLE_EQ(xyz[i][0], expected[0]);
+        EXPECT_DOUBLE_EQ(xyz[i][1], expected[1]);
+        EXPECT_DOUBLE_EQ(xyz[i][2], expected[2]);
+    }
+
+    std::vector<XyzCoefficients> tooSmall(numSpectra - 1);
+    EXPECT_THROW(SampledSpectrum::ToXyz(spectra, tooSmall), std::invalid_argument);
+}
+
+TEST(SampledSpectrumTest, CompileTimeCurvesMatchRuntimeResampling)
+{
+    constexpr SampledSpectrum white = SampledSpectrum::FromSortedRawSamples(stdLambda, stdReflSamplesW, numStdSamples);
+    EXPECT_TRUE(white == SampledSpectrum::stdReflW);
+
+    SampleArray samples(numCieSamples);
+    for (int i = 0; i < numCieSamples; ++i)
+        samples[i] = { cieLambda[i], cieSamplesY[i] };
+
+    // The compiler may contract the runtime multiply-adds into FMAs, which constant
+    // evaluation never does, so the results can differ in the last few bits
+    SampledSpectrum runtimeY(samples);
+    for (int i = 0; i < NumSpectralSamples; ++i)
+    {
+        SpectralReal expected = SampledSpectrum::cieY.m_Coefficients[i];
+        SpectralReal tolerance = 16 * std::numeric_limits<SpectralReal>::epsilon() * std::abs(expected);
+        EXPECT_NEAR(runtimeY.m_Coefficients[i], expected, tolerance);
+    }
+}
+
+TEST(SampledSpectrumTest, SinglePassResamplingMatchesPerBinAverage)
+{
+    // Dense measured-style data that extends past both ends of the visible range
+    const int numSamples = 5000;
+    SampleArray samples(numSamples);
+    for (int i = 0; i < numSamples; ++i)
+    {
+        double lambda = 300.0 + i * 0.125;
+        samples[i] = { lambda, 1.0 + std::sin(lambda * 0.05) };
+    }
+
+    SampledSpectrum s = SampledSpectrum::FromSortedSamples(samples.data(), numSamples);
+    for (int i = 0; i < NumSpectralSamples; ++i)
+    {
+        double start, end;
+        s.ComputeRangeAtIndex(i, start, end);
+        EXPECT_DOUBLE_EQ(s.m_Coefficients[i], SpectralReal(ComputeAverageInRange(samples, start, end)));
+    }
+
+    EXPECT_EQ(s, SampledSpectrum(samples));
+}
+
+TEST(SampledSpectrumTest, FloatTablesMatchDouble)
+{
+    using FloatSpectrum = BasicSampledSpectrum<float, NumSpectralSamples>;
+    using DoubleSpectrum = BasicSampledSpectrum<double, NumSpectralSamples>;
+
+    for (int i = 0; i < NumSpectralSamples; ++i)
+    {
+        EXPECT_NEAR(FloatSpectrum::cieY.m_Coefficients[i], DoubleSpectrum::cieY.m_Coefficients[i], 1e-5);
+        EXPECT_NEAR(FloatSpectrum::cieZ.m_Coefficients[i], DoubleSpectrum::cieZ.m_Coefficients[i], 1e-5);
+    }
+
+    FloatSpectrum f;
+    DoubleSpectrum d;
+    for (int i = 0; i < NumSpectralSamples; ++i)
+    {
+        d.m_Coefficients[i] = 0.5 + 0.5 * std::cos(i * 0.2);
+        f.m_Coefficients[i] = float(d.m_Coefficients[i]);
+    }
+
+    BasicSpectralCoefficients<float> xyzFloat = f.ToXyz();
+    BasicSpectralCoefficients<double> xyzDouble = d.ToXyz();
+    for (int c = 0; c < 3; ++c)
+        EXPECT_NEAR(xyzFloat[c], xyzDouble[c], 1e-5);
+}
@@ -0,0 +1,63 @@
+/*
+    This file is part of Spectre, an open-source physically based
+    spectral raytracing library.
+
+    Copyright (c) 2020-2023 Samuel Van Allen - All rights reserved.
+
+    Spectre is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "gtest.h"
+#include "core/spectrum/sampledspectrum.h"
+
+TEST(SampledWavelengthsTest, CanSampleUniformly)
+{
+    SampledWavelengths wavelengths = SampledWavelengths::SampleUniform(0.0);
+    EXPECT_DOUBLE_EQ(wavelengths[0], MinWavelength);
+
+    for (int i = 1; i < NumHeroWavelengths; ++i)
+        EXPECT_DOUBLE_EQ(wavelengths[i] - wavelengths[i - 1], WavelengthRange / double(NumHeroWavelengths));
+
+    for (int i = 0; i < NumHeroWavelengths; ++i)
+        EXPECT_DOUBLE_EQ(wavelengths.GetPdf(i), 1.0 / WavelengthRange);
+}
+
+TEST(SampledWavelengthsTest, WavelengthsStayInVisibleRange)
+{
+    for (double u = 0; u < 1.0; u += 0.01)
+    {
+        SampledWavelengths wavelengths = SampledWavelengths::SampleUniform(u);
+        for (int i = 0; i < NumHeroWavelengths; ++i)
+        {
+            EXPECT_GE(wavelengths[i], MinWavelength);
+            EXPECT_LE(wavelengths[i], MaxWavelength);
+        }
+    }
+}
+
+TEST(SampledWavelengthsTest, CanTerminateSecondary)
+{
+    SampledWavelengths wavelengths = SampledWavelengths::SampleUniform(0.5);
+    EXPECT_FALSE(wavelengths.IsSecondaryTerminated());
+
+    wavelengths.TerminateSecondary();
+    EXPECT_TRUE(wavelengths.IsSecondaryTerminated());
+    EXPECT_DOUBLE_EQ(wavelengths.GetPdf(0), 1.0 / WavelengthRange / NumHeroWavelengths);
+
+    for (int i = 1; i < NumHeroWavelengths; ++i)
+        EXPECT_EQ(wavelengths.GetPdf(i), 0.0);
+
+    wavelengths.TerminateSecondary();
+    EXPECT_DOUBLE_EQ(wavelengths.GetPdf(0), 1.0 / WavelengthRange / NumHeroWavelengths);
+}
@@ -0,0 +1,53 @@
+/*
+    This file is part of Spectre, an open-source physically based
+    spectral raytracing library.
+
+    Copyright (c) 2020-2023 Samuel Van Allen - All rights reserved.
+
+    Spectre is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "gtest.h"
+#include "core/spectrum/sigmoidpolynomial.h"
+
+TEST(SigmoidPolynomialTest, ZeroPolynomialIsHalf)
+{
+    SigmoidPolynomial p;
+    EXPECT_DOUBLE_EQ(p.Evaluate(400.0), 0.5);
+    EXPECT_DOUBLE_EQ(p.Evaluate(700.0), 0.5);
+}
+
+TEST(SigmoidPolynomialTest, StaysWithinUnitRange)
+{
+    SigmoidPolynomial p(0.01, -10.0, 2000.0);
+    for (double lambda = 360.0; lambda <= 830.0; lambda += 10.0)
+    {
+        double v = p.Evaluate(lambda);
+        EXPECT_GE(v, 0.0);
+        EXPECT_LE(v, 1.0);
+    }
+
+    EXPECT_DOUBLE_EQ(SigmoidPolynomial(0, 0, INFINITY).Evaluate(500.0), 1.0);
+    EXPECT_DOUBLE_EQ(SigmoidPolynomial(0, 0, -INFINITY).Evaluate(500.0), 0.0);
+}
+
+TEST(SigmoidPolynomialTest, CanEvaluateWavelengths)
+{
+    SigmoidPolynomial p(0.0, 0.01, -5.5);
+    SampledWavelengths wavelengths = SampledWavelengths::SampleUniform(0.3);
+    SpectralPacket packet = p.Evaluate(wavelengths);
+
+    for (int i = 0; i < NumHeroWavelengths; ++i)
+        EXPECT_DOUBLE_EQ(packet[i], p.Evaluate(wavelengths[i]));
+}
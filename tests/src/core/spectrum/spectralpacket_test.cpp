@@ -0,0 +1,92 @@
+/*
+    This file is part of Spectre, an open-source physically based
+    spectral raytracing library.
+
+    Copyright (c) 2020-2023 Samuel Van Allen - All rights reserved.
+
+    Spectre is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "gtest.h"
+#include "core/spectrum/reflectantspectrum.h"
+
+TEST(SpectralPacketTest, CanBeCreated)
+{
+    ASSERT_NO_THROW(SpectralPacket packet);
+    EXPECT_TRUE(SpectralPacket().IsBlack());
+    EXPECT_FALSE(SpectralPacket(0.1).IsBlack());
+}
+
+TEST(SpectralPacketTest, FitsInASimdRegister)
+{
+    EXPECT_LE(sizeof(SpectralPacket), 64);
+}
+
+TEST(SpectralPacketTest, CanDoArithmetic)
+{
+    EXPECT_EQ(SpectralPacket(1) + SpectralPacket(2), SpectralPacket(3));
+    EXPECT_EQ(SpectralPacket(1) - SpectralPacket(2), SpectralPacket(-1));
+    EXPECT_EQ(SpectralPacket(3) * SpectralPacket(2), SpectralPacket(6));
+    EXPECT_EQ(SpectralPacket(3) / SpectralPacket(2), SpectralPacket(1.5));
+
+    SpectralPacket p(2);
+    p *= 3;
+    EXPECT_EQ(p, SpectralPacket(6));
+    p += 1;
+    EXPECT_EQ(p, SpectralPacket(7));
+    p -= 3;
+    EXPECT_EQ(p, SpectralPacket(4));
+    p /= 2;
+    EXPECT_EQ(p, SpectralPacket(2));
+    EXPECT_DOUBLE_EQ(p.Average(), 2);
+}
+
+TEST(SpectralPacketTest, CanEvaluateSampledSpectra)
+{
+    SampledSpectrum s;
+    for (int i = 0; i < NumSpectralSamples; ++i)
+        s.m_Coefficients[i] = i;
+
+    double binWidth = WavelengthRange / double(NumSpectralSamples - 1);
+    EXPECT_DOUBLE_EQ(s.Evaluate(MinWavelength), 0);
+    EXPECT_DOUBLE_EQ(s.Evaluate(MaxWavelength), NumSpectralSamples - 1);
+    EXPECT_DOUBLE_EQ(s.Evaluate(MinWavelength + binWidth * 2.5), 2.5);
+    EXPECT_DOUBLE_EQ(s.Evaluate(MinWavelength - 100), 0);
+    EXPECT_DOUBLE_EQ(s.Evaluate(MaxWavelength + 100), NumSpectralSamples - 1);
+
+    SampledWavelengths wavelengths = SampledWavelengths::SampleUniform(0.3);
+    SpectralPacket packet = s.Evaluate(wavelengths);
+    for (int i = 0; i < NumHeroWavelengths; ++i)
+        EXPECT_DOUBLE_EQ(packet[i], s.Evaluate(wavelengths[i]));
+}
+
+TEST(SpectralPacketTest, ConvergesToFullSpectrumXyz)
+{
+    const int numSamples = 4096;
+    ReflectantSpectrum spectrum({ 0.2, 0.5, 0.8 });
+
+    XyzCoefficients estimate;
+    for (int i = 0; i < numSamples; ++i)
+    {
+        SampledWavelengths wavelengths = SampledWavelengths::SampleUniform((i + 0.5) / numSamples);
+        estimate += spectrum.Evaluate(wavelengths).ToXyz(wavelengths);
+    }
+    estimate = estimate / numSamples;
+
+    XyzCoefficients reference = spectrum.ToXyz();
+    static const double tolerance = 0.02;
+    EXPECT_LT(abs(estimate[0] - reference[0]), tolerance);
+    EXPECT_LT(abs(estimate[1] - reference[1]), tolerance);
+    EXPECT_LT(abs(estimate[2] - reference[2]), tolerance);
+}
@@ -0,0 +1,62 @@
+/*
+    This file is part of Spectre, an open-source physically based
+    spectral raytracing library.
+
+    Copyright (c) 2020-2023 Samuel Van Allen - All rights reserved.
+
+    Spectre is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "gtest.h"
+#include "core/spectrum/spectralresolution.h"
+#include "core/spectrum/sampledspectrum.h"
+
+TEST(SpectralResolutionTest, CanDispatchToBinCount)
+{
+    for (SpectralResolution resolution : { SpectralResolution::Preview, SpectralResolution::Draft, SpectralResolution::Standard, SpectralResolution::Reference })
+    {
+        int numSamples = DispatchSpectralResolution(resolution, [](auto bins)
+        {
+            return BasicSpectrum<SpectralReal, decltype(bins)::value>::NumSamples;
+        });
+
+        EXPECT_EQ(numSamples, GetNumSpectralSamples(resolution));
+    }
+}
+
+TEST(SpectralResolutionTest, ThrowsOnUnsupportedResolution)
+{
+    EXPECT_THROW(DispatchSpectralResolution(SpectralResolution(17), [](auto) { return 0; }), std::invalid_argument);
+}
+
+TEST(SpectralResolutionTest, AllResolutionsAgreeOnXyz)
+{
+    // A smooth spectrum should integrate to nearly the same color whatever the
+    // bin count, only the quadrature gets coarser
+    SampleArray samples;
+    for (int lambda = MinWavelength; lambda <= MaxWavelength; lambda += 5)
+        samples.push_back({ double(lambda), 0.5 + 0.4 * std::sin(lambda * 0.01) });
+
+    XyzCoefficients reference = SampledSpectrum(samples).ToXyz();
+    for (SpectralResolution resolution : { SpectralResolution::Preview, SpectralResolution::Draft, SpectralResolution::Reference })
+    {
+        XyzCoefficients xyz = DispatchSpectralResolution(resolution, [&](auto bins)
+        {
+            return BasicSampledSpectrum<SpectralReal, decltype(bins)::value>(samples).ToXyz();
+        });
+
+        for (int c = 0; c < 3; ++c)
+            EXPECT_NEAR(xyz[c], reference[c], 0.05 * reference[c]);
+    }
+}
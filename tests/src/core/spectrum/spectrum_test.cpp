@@ -166,3 +166,64 @@ TEST(SpectrumTest, CanComputeMax)
     EXPECT_EQ(Spectrum::Max(2, 1), Spectrum(2));
 }
 
+
+TEST(SpectrumTest, CoefficientsAreSimdAligned)
+{
+    Spectrum s;
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(s.m_Coefficients) % Simd::Alignment, 0);
+
+    std::vector<Spectrum> spectra(3);
+    for (const Spectrum& spectrum : spectra)
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(spectrum.m_Coefficients) % Simd::Alignment, 0);
+}
+
+TEST(SpectrumTest, KernelsCoverEveryCoefficient)
+{
+    for (int i = 0; i < NumSpectralSamples; ++i)
+    {
+        Spectrum s;
+        s.m_Coefficients[i] = -1;
+        EXPECT_FALSE(s.IsBlack());
+
+        s.ClampZero();
+        EXPECT_TRUE(s.IsBlack());
+
+        s.m_Coefficients[i] = std::numeric_limits<double>::quiet_NaN();
+        EXPECT_TRUE(s.HasNans());
+
+        Spectrum a(1), b(2);
+        a.m_Coefficients[i] = 3;
+        Spectrum sum = a + b;
+        EXPECT_EQ(sum.m_Coefficients[i], 5);
+        EXPECT_EQ(Spectrum::Max(a, b).m_Coefficients[i], 3);
+        EXPECT_EQ(Spectrum::Min(a, b).m_Coefficients[i], 2);
+        EXPECT_EQ(Spectrum::Lerp(a, b, 0.5).m_Coefficients[i], 2.5);
+    }
+}
+
+TEST(SpectrumTest, SinglePrecisionKernelsCoverEveryCoefficient)
+{
+    using FloatSpectrum = BasicSpectrum<float, NumSpectralSamples>;
+
+    for (int i = 0; i < NumSpectralSamples; ++i)
+    {
+        FloatSpectrum s;
+        s.m_Coefficients[i] = -1;
+        EXPECT_FALSE(s.IsBlack());
+
+        s.ClampZero();
+        EXPECT_TRUE(s.IsBlack());
+
+        s.m_Coefficients[i] = std::numeric_limits<float>::quiet_NaN();
+        EXPECT_TRUE(s.HasNans());
+
+        FloatSpectrum a(1), b(2);
+        a.m_Coefficients[i] = 3;
+        FloatSpectrum sum = a * 2.0 + b;
+        EXPECT_EQ(sum.m_Coefficients[i], 8.0f);
+        EXPECT_EQ(FloatSpectrum::Max(a, b).m_Coefficients[i], 3.0f);
+        EXPECT_EQ(FloatSpectrum::Min(a, b).m_Coefficients[i], 2.0f);
+        EXPECT_EQ(FloatSpectrum::Lerp(a, b, 0.5).m_Coefficients[i], 2.5f);
+        EXPECT_EQ(FloatSpectrum::Sqrt(FloatSpectrum(4)), FloatSpectrum(2));
+    }
+}
@@ -0,0 +1,75 @@
+/*
+    This file is part of Spectre, an open-source physically based
+    spectral raytracing library.
+
+    Copyright (c) 2020-2023 Samuel Van Allen - All rights reserved.
+
+    Spectre is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "gtest.h"
+#include "core/spectrum/sampledspectrum.h"
+
+TEST(SpectrumExpressionTest, CanEvaluateChainedExpressions)
+{
+    Spectrum a(1), b(2), c(3);
+    Spectrum result = a + b * c - c / b;
+    EXPECT_EQ(result, Spectrum(5.5));
+    EXPECT_EQ((a + b) * (c - a), Spectrum(6));
+}
+
+TEST(SpectrumExpressionTest, CanMixScalarsAndSpectra)
+{
+    Spectrum a(2);
+    EXPECT_EQ(a * 3.0, Spectrum(6));
+    EXPECT_EQ(3.0 * a, Spectrum(6));
+    EXPECT_EQ(a + 1.0, Spectrum(3));
+    EXPECT_EQ(1.0 + a, Spectrum(3));
+    EXPECT_EQ(a - 1.0, Spectrum(1));
+    EXPECT_EQ(1.0 - a, Spectrum(-1));
+    EXPECT_EQ(a / 4.0, Spectrum(0.5));
+    EXPECT_EQ(4.0 / a, Spectrum(2));
+}
+
+TEST(SpectrumExpressionTest, CanAssignExpressionReferencingItself)
+{
+    Spectrum a(2);
+    Spectrum b(3);
+    a = a * b + a;
+    EXPECT_EQ(a, Spectrum(8));
+
+    a += a * 0.5 + b;
+    EXPECT_EQ(a, Spectrum(15));
+}
+
+TEST(SpectrumExpressionTest, PreservesPerCoefficientValues)
+{
+    Spectrum a, b;
+    for (int i = 0; i < NumSpectralSamples; ++i)
+    {
+        a.m_Coefficients[i] = i;
+        b.m_Coefficients[i] = 2.0 * i;
+    }
+
+    Spectrum result = a * 2.0 + b * 0.5 - 1.0;
+    for (int i = 0; i < NumSpectralSamples; ++i)
+        EXPECT_DOUBLE_EQ(result.m_Coefficients[i], 3.0 * i - 1.0);
+}
+
+TEST(SpectrumExpressionTest, CanConstructDerivedSpectraFromExpressions)
+{
+    SampledSpectrum a(1), b(2);
+    SampledSpectrum result = a * b + 1.0;
+    EXPECT_EQ(result, Spectrum(3));
+}
@@ -0,0 +1,152 @@
+/*
+    This file is part of Spectre, an open-source physically based
+    spectral raytracing library.
+
+    Copyright (c) 2020-2023 Samuel Van Allen - All rights reserved.
+
+    Spectre is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "gtest.h"
+
+#include <thread>
+
+TEST(Pcg32Test, MatchesReferenceOutput)
+{
+    // First outputs of the reference pcg32-demo, seeded with (42, 54)
+    Pcg32 rng(54, 42);
+    EXPECT_EQ(rng.NextUInt(), 0xa15c02b7u);
+    EXPECT_EQ(rng.NextUInt(), 0x7b47f409u);
+    EXPECT_EQ(rng.NextUInt(), 0xba1d3330u);
+    EXPECT_EQ(rng.NextUInt(), 0x83d2f293u);
+    EXPECT_EQ(rng.NextUInt(), 0xbfa4784bu);
+    EXPECT_EQ(rng.NextUInt(), 0xcbed606eu);
+}
+
+TEST(Pcg32Test, CanAdvance)
+{
+    Pcg32 stepped(7, 3);
+    Pcg32 advanced = stepped;
+
+    for (int i = 0; i < 1000; ++i)
+        stepped.NextUInt();
+
+    advanced.Advance(1000);
+    EXPECT_EQ(advanced, stepped);
+
+    advanced.Advance(-1000);
+    EXPECT_EQ(advanced, Pcg32(7, 3));
+}
+
+TEST(Pcg32Test, GeneratesUnitInterval)
+{
+    Pcg32 rng;
+    double sum = 0;
+    for (int i = 0; i < 100000; ++i)
+    {
+        float f = rng.NextFloat();
+        double d = rng.NextDouble();
+        ASSERT_GE(f, 0.0f);
+        ASSERT_LT(f, 1.0f);
+        ASSERT_GE(d, 0.0);
+        ASSERT_LT(d, 1.0);
+        sum += d;
+    }
+
+    EXPECT_NEAR(sum / 100000, 0.5, 0.01);
+}
+
+TEST(Pcg32Test, BatchesMatchSingleValues)
+{
+    Pcg32 single(1, 2);
+    Pcg32 batched(1, 2);
+
+    std::vector<float> floats(37);
+    batched.NextFloats(floats);
+    for (float f : floats)
+        EXPECT_EQ(f, single.NextFloat());
+
+    std::vector<double> doubles(37);
+    batched.NextDoubles(doubles);
+    for (double d : doubles)
+        EXPECT_EQ(d, single.NextDouble());
+}
+
+TEST(Pcg32Test, BoundedIntegersStayInRange)
+{
+    Pcg32 rng;
+    std::vector<int> counts(6, 0);
+    for (int i = 0; i < 60000; ++i)
+        ++counts[rng.NextUInt(6)];
+
+    for (int count : counts)
+        EXPECT_NEAR(count, 10000, 500);
+}
+
+TEST(Pcg32Test, SampleGeneratorsAreReproducible)
+{
+    Pcg32 a = Pcg32::ForSample({ 12, 34 }, 5, 2);
+    Pcg32 b = Pcg32::ForSample({ 12, 34 }, 5, 2);
+    EXPECT_EQ(a.NextUInt(), b.NextUInt());
+
+    // Neighbouring pixels, samples and dimensions start at different numbers
+    uint32_t reference = Pcg32::ForSample({ 12, 34 }, 5, 2).NextUInt();
+    EXPECT_NE(Pcg32::ForSample({ 13, 34 }, 5, 2).NextUInt(), reference);
+    EXPECT_NE(Pcg32::ForSample({ 12, 35 }, 5, 2).NextUInt(), reference);
+    EXPECT_NE(Pcg32::ForSample({ 12, 34 }, 6, 2).NextUInt(), reference);
+    EXPECT_NE(Pcg32::ForSample({ 12, 34 }, 5, 3).NextUInt(), reference);
+    EXPECT_NE(Pcg32::ForSample({ 12, 34 }, 5, 2, 1).NextUInt(), reference);
+
+    // Dimensions are consecutive positions within the sample's block
+    Pcg32 c = Pcg32::ForSample({ 12, 34 }, 5, 2);
+    c.NextUInt();
+    EXPECT_EQ(c.NextUInt(), Pcg32::ForSample({ 12, 34 }, 5, 3).NextUInt());
+}
+
+TEST(RandomTest, ThreadsOwnTheirGenerator)
+{
+    Random::Seed(11);
+    int first = Random::UniformInt();
+
+    // Another thread seeded the same way sees the same numbers, and does not
+    // advance this thread's generator
+    int other = 0;
+    std::thread thread([&other]()
+    {
+        Random::Seed(11);
+        other = Random::UniformInt();
+    });
+    thread.join();
+    EXPECT_EQ(other, first);
+
+    Random::Seed(11);
+    EXPECT_EQ(Random::UniformInt(), first);
+}
+
+TEST(RandomTest, UniformIntIsInclusive)
+{
+    bool sawMin = false;
+    bool sawMax = false;
+    for (int i = 0; i < 1000; ++i)
+    {
+        int value = Random::UniformInt(-2, 2);
+        ASSERT_GE(value, -2);
+        ASSERT_LE(value, 2);
+        sawMin |= value == -2;
+        sawMax |= value == 2;
+    }
+
+    EXPECT_TRUE(sawMin);
+    EXPECT_TRUE(sawMax);
+}
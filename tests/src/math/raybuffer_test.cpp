@@ -0,0 +1,81 @@
+/*
+    This file is part of Spectre, an open-source physically based
+    spectral raytracing library.
+
+    Copyright (c) 2020-2023 Samuel Van Allen - All rights reserved.
+
+    Spectre is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "gtest.h"
+#include "math/raybuffer.h"
+#include "core/film/filmtile.h"
+
+TEST(RayBufferTest, CanBeCreated)
+{
+    RayBuffer rays(10);
+    EXPECT_EQ(rays.GetSize(), 10);
+    EXPECT_GE(rays.GetCapacity(), 10);
+    EXPECT_THROW(RayBuffer(-1), std::invalid_argument);
+}
+
+TEST(RayBufferTest, ArraysAreAligned)
+{
+    RayBuffer rays(13);
+    for (const void* p : { (const void*)rays.GetPixelX(), (const void*)rays.GetPixelY(), (const void*)rays.GetOffsetX(),
+        (const void*)rays.GetOriginX(), (const void*)rays.GetOriginZ(), (const void*)rays.GetDirectionY() })
+    {
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(p) % Simd::Alignment, 0u);
+    }
+}
+
+TEST(RayBufferTest, CanSetAndGetRays)
+{
+    RayBuffer rays(2);
+    rays.SetSample(1, { 3, 4 }, { 0.5, 0.25 });
+    rays.SetRay(1, Ray({ 1, 2, 3 }, { 0, 0, 2 }));
+
+    EXPECT_EQ(rays.GetPixel(1), Point2i(3, 4));
+    EXPECT_EQ(rays.GetOffset(1), Vector2(0.5, 0.25));
+    EXPECT_EQ(rays.GetRay(1), Ray({ 1, 2, 3 }, { 0, 0, 1 }));
+}
+
+TEST(RayBufferTest, KeepsRaysWhenGrowing)
+{
+    RayBuffer rays(1);
+    rays.SetSample(0, { 7, 8 }, {});
+    rays.SetRay(0, Ray({ 1, 1, 1 }, { 1, 0, 0 }));
+
+    rays.Resize(1000);
+    EXPECT_EQ(rays.GetSize(), 1000);
+    EXPECT_EQ(rays.GetPixel(0), Point2i(7, 8));
+    EXPECT_EQ(rays.GetRay(0), Ray({ 1, 1, 1 }, { 1, 0, 0 }));
+
+    int capacity = rays.GetCapacity();
+    rays.Resize(10);
+    EXPECT_EQ(rays.GetCapacity(), capacity);
+}
+
+TEST(RayBufferTest, CanLayOutTileSamples)
+{
+    FilmTile tile({ 64, 128 }, { 3, 2 });
+    RayBuffer rays;
+    rays.SetTileSamples(tile, { 0.5, 0.5 });
+
+    ASSERT_EQ(rays.GetSize(), 6);
+    EXPECT_EQ(rays.GetPixel(0), Point2i(64, 128));
+    EXPECT_EQ(rays.GetPixel(2), Point2i(66, 128));
+    EXPECT_EQ(rays.GetPixel(3), Point2i(64, 129));
+    EXPECT_EQ(rays.GetOffset(5), Vector2(0.5, 0.5));
+}
@@ -0,0 +1,82 @@
+/*
+    This file is part of Spectre, an open-source physically based
+    spectral raytracing library.
+
+    Copyright (c) 2020-2023 Samuel Van Allen - All rights reserved.
+
+    Spectre is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "gtest.h"
+
+namespace
+{
+    template <typename T>
+    void CheckSinCos(double tolerance)
+    {
+        using Pack = Simd::Pack<T>;
+        alignas(Simd::Alignment) T x[Pack::Width];
+        alignas(Simd::Alignment) T sine[Pack::Width];
+        alignas(Simd::Alignment) T cosine[Pack::Width];
+
+        for (double start = -20; start < 20; start += 0.0137 * Pack::Width)
+        {
+            for (int i = 0; i < Pack::Width; ++i)
+                x[i] = T(start + i * 0.0137);
+
+            Pack s, c;
+            Simd::SinCos(Pack::Load(x), s, c);
+            s.Store(sine);
+            c.Store(cosine);
+
+            for (int i = 0; i < Pack::Width; ++i)
+            {
+                ASSERT_NEAR(sine[i], std::sin(x[i]), tolerance) << x[i];
+                ASSERT_NEAR(cosine[i], std::cos(x[i]), tolerance) << x[i];
+            }
+        }
+    }
+}
+
+TEST(SimdTest, CanComputeSinCos)
+{
+    CheckSinCos<double>(1e-14);
+    CheckSinCos<float>(1e-5);
+
+    Simd::Scalar<double> s, c;
+    Simd::SinCos(Simd::Scalar<double>(Math::PiOver2), s, c);
+    EXPECT_NEAR(s.m_Data, 1.0, 1e-15);
+    EXPECT_NEAR(c.m_Data, 0.0, 1e-15);
+}
+
+TEST(SimdTest, CanFloorAndSelect)
+{
+    using Pack = Simd::Pack<double>;
+    alignas(Simd::Alignment) double values[Pack::Width];
+    alignas(Simd::Alignment) double floors[Pack::Width];
+    alignas(Simd::Alignment) double selected[Pack::Width];
+
+    for (int i = 0; i < Pack::Width; ++i)
+        values[i] = i * 0.75 - 1.3;
+
+    Pack v = Pack::LoadUnaligned(values);
+    Simd::Floor(v).Store(floors);
+    Simd::SelectLess(v, Pack(0.0), Pack(-1.0), v).Store(selected);
+
+    for (int i = 0; i < Pack::Width; ++i)
+    {
+        EXPECT_EQ(floors[i], std::floor(values[i]));
+        EXPECT_EQ(selected[i], values[i] < 0 ? -1.0 : values[i]);
+    }
+}
@@ -403,3 +403,78 @@ TEST(TransformTest, CorrectOrderOfTransformations)
     EXPECT_EQ(t3(forwardRay).GetOrigin(), Point3(0, 0.5, -10));
 }
 
+
+TEST(TransformTest, BatchedTransformsMatchScalar)
+{
+    Transform t;
+    t.SetTranslation({ 1, -2, 3 });
+    t.SetScale({ 2, 1, 0.5 });
+    t.SetRotation({ 0.3, -1.2, 2.1 });
+
+    std::vector<Point3> points = { { 0, 0, 0 }, { 1, 2, 3 }, { -4.5, 0.25, 7 } };
+    std::vector<Vector3> vectors = { { 1, 0, 0 }, { 0, -1, 0.5 }, { 3, 2, 1 } };
+
+    std::vector<Point3> transformedPoints(points.size());
+    std::vector<Vector3> transformedVectors(vectors.size());
+    t.TransformPoints(points, transformedPoints);
+    t.TransformVectors(vectors, transformedVectors);
+
+    std::vector<double> px, py, pz, vx, vy, vz;
+    for (size_t i = 0; i < points.size(); i++)
+    {
+        px.push_back(points[i].x); py.push_back(points[i].y); pz.push_back(points[i].z);
+        vx.push_back(vectors[i].x); vy.push_back(vectors[i].y); vz.push_back(vectors[i].z);
+    }
+    t.TransformPoints(px, py, pz);
+    t.TransformVectors(vx, vy, vz);
+
+    for (size_t i = 0; i < points.size(); i++)
+    {
+        EXPECT_EQ(transformedPoints[i], t(points[i]));
+        EXPECT_EQ(transformedVectors[i], t(vectors[i]));
+        EXPECT_EQ(Point3(px[i], py[i], pz[i]), t(points[i]));
+        EXPECT_EQ(Vector3(vx[i], vy[i], vz[i]), t(vectors[i]));
+    }
+
+    // In place
+    t.TransformPoints(points, points);
+    EXPECT_EQ(points, transformedPoints);
+}
+
+TEST(TransformTest, BatchedTransformsRejectMismatchedSizes)
+{
+    Transform t;
+    std::vector<Point3> points(3);
+    std::vector<Point3> out(2);
+    std::vector<double> x(3), y(3), z(2);
+
+    EXPECT_THROW(t.TransformPoints(points, out), std::invalid_argument);
+    EXPECT_THROW(t.TransformPoints(x, y, z), std::invalid_argument);
+    EXPECT_THROW(t.TransformVectors(x, y, z), std::invalid_argument);
+}
+
+TEST(TransformTest, RevisionChangesWithMatrices)
+{
+    Transform t;
+    uint64_t revision = t.GetRevision();
+
+    t.SetTranslation({ 1, 2, 3 });
+    EXPECT_NE(t.GetRevision(), revision);
+    revision = t.GetRevision();
+
+    t.SetScale({ 2, 2, 2 });
+    EXPECT_NE(t.GetRevision(), revision);
+}
+
+TEST(TransformTest, RevisionsAreUniqueAcrossTransforms)
+{
+    Transform a;
+    Transform b;
+    a.SetTranslation({ 1, 0, 0 });
+    b.SetTranslation({ 0, 1, 0 });
+    EXPECT_NE(a.GetRevision(), b.GetRevision());
+    EXPECT_NE(a.Inversed().GetRevision(), a.GetRevision());
+
+    Transform copy = a;
+    EXPECT_EQ(copy.GetRevision(), a.GetRevision());
+}
@@ -0,0 +1,86 @@
+/*
+    This file is part of Spectre, an open-source physically based
+    spectral raytracing library.
+
+    Copyright (c) 2020-2023 Samuel Van Allen - All rights reserved.
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "gtest.h"
+#include "system/platform/cputopology.h"
+
+namespace
+{
+    // Two NUMA nodes with two cores each, every core with two SMT siblings
+    CpuTopology CreateTwoNodeTopology()
+    {
+        return CpuTopology({
+            { 0, 0, 0, 0 }, { 1, 1, 0, 0 }, { 2, 0, 1, 1 }, { 3, 1, 1, 1 },
+            { 4, 0, 0, 0 }, { 5, 1, 0, 0 }, { 6, 0, 1, 1 }, { 7, 1, 1, 1 }
+        });
+    }
+
+    std::vector<int> GetIds(const std::vector<LogicalCpu>& cpus)
+    {
+        std::vector<int> ids;
+        for (const LogicalCpu& cpu : cpus)
+            ids.push_back(cpu.m_Id);
+
+        return ids;
+    }
+}
+
+TEST(CpuTopologyTest, CanParseCpuList)
+{
+    EXPECT_EQ(CpuTopology::ParseCpuList("0-3,8,10-11\n"), std::vector<int>({ 0, 1, 2, 3, 8, 10, 11 }));
+    EXPECT_EQ(CpuTopology::ParseCpuList("5"), std::vector<int>({ 5 }));
+    EXPECT_TRUE(CpuTopology::ParseCpuList("").empty());
+}
+
+TEST(CpuTopologyTest, ThrowOnInvalidCpuList)
+{
+    EXPECT_THROW(CpuTopology::ParseCpuList("a-b"), std::invalid_argument);
+    EXPECT_THROW(CpuTopology::ParseCpuList("4-2"), std::invalid_argument);
+}
+
+TEST(CpuTopologyTest, MapsIdsToDenseIndices)
+{
+    CpuTopology topology = CreateTwoNodeTopology();
+    EXPECT_EQ(topology.GetNumLogicalCpus(), 8);
+    EXPECT_EQ(topology.GetNumPhysicalCores(), 4);
+    EXPECT_EQ(topology.GetNumNumaNodes(), 2);
+
+    CpuTopology sparse({ { 0, 12, 3, 7 }, { 1, 20, 3, 9 } });
+    EXPECT_EQ(sparse.GetCpus()[0].m_Core, 0);
+    EXPECT_EQ(sparse.GetCpus()[1].m_Core, 1);
+    EXPECT_EQ(sparse.GetCpus()[1].m_NumaNode, 1);
+}
+
+TEST(CpuTopologyTest, CanSelectCpus)
+{
+    CpuTopology topology = CreateTwoNodeTopology();
+
+    EXPECT_TRUE(topology.SelectCpus(AffinityPolicy::None, 4).empty());
+    EXPECT_EQ(GetIds(topology.SelectCpus(AffinityPolicy::Compact, 4)), std::vector<int>({ 0, 4, 1, 5 }));
+    EXPECT_EQ(GetIds(topology.SelectCpus(AffinityPolicy::Scatter, 8)), std::vector<int>({ 0, 2, 1, 3, 4, 6, 5, 7 }));
+    EXPECT_EQ(GetIds(topology.SelectCpus(AffinityPolicy::PhysicalCores, 6)), std::vector<int>({ 0, 1, 2, 3, 0, 1 }));
+}
+
+TEST(CpuTopologyTest, CanDetectTopology)
+{
+    CpuTopology topology = CpuTopology::Detect();
+    EXPECT_GE(topology.GetNumLogicalCpus(), 1);
+    EXPECT_GE(topology.GetNumPhysicalCores(), 1);
+    EXPECT_GE(topology.GetNumNumaNodes(), 1);
+    EXPECT_LE(topology.GetNumPhysicalCores(), topology.GetNumLogicalCpus());
+}
@@ -0,0 +1,99 @@
+/*
+    This file is part of Spectre, an open-source physically based
+    spectral raytracing library.
+
+    Copyright (c) 2020-2023 Samuel Van Allen - All rights reserved.
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "gtest.h"
+#include "system/threading/inlinetask.h"
+
+namespace
+{
+    struct CountedFunctor
+    {
+        CountedFunctor(int* numAlive, int* numCalls) : m_NumAlive(numAlive), m_NumCalls(numCalls) { ++*m_NumAlive; }
+        CountedFunctor(CountedFunctor&& other) noexcept : m_NumAlive(other.m_NumAlive), m_NumCalls(other.m_NumCalls) { ++*m_NumAlive; }
+        ~CountedFunctor() { --*m_NumAlive; }
+
+        void operator()() { ++*m_NumCalls; }
+
+        int* m_NumAlive;
+        int* m_NumCalls;
+    };
+}
+
+TEST(InlineTaskTest, DefaultsToEmpty)
+{
+    InlineTask<32> task;
+    EXPECT_FALSE(task);
+}
+
+TEST(InlineTaskTest, CanInvokeCallable)
+{
+    int value = 0;
+    InlineTask<32> task([&value]() { value = 42; });
+    ASSERT_TRUE(task);
+
+    task();
+    EXPECT_EQ(value, 42);
+}
+
+TEST(InlineTaskTest, SupportsMoveOnlyCaptures)
+{
+    auto owned = std::make_unique<int>(7);
+    int result = 0;
+
+    InlineTask<32> task([owned = std::move(owned), &result]() { result = *owned; });
+    task();
+    EXPECT_EQ(result, 7);
+}
+
+TEST(InlineTaskTest, ChecksCapacity)
+{
+    struct Small { char m_Data[16]; void operator()() {} };
+    struct Large { char m_Data[64]; void operator()() {} };
+
+    EXPECT_TRUE(InlineTask<32>::Fits<Small>);
+    EXPECT_FALSE(InlineTask<32>::Fits<Large>);
+    EXPECT_TRUE(InlineTask<64>::Fits<Large>);
+}
+
+TEST(InlineTaskTest, MovesAndDestroysTarget)
+{
+    int numAlive = 0;
+    int numCalls = 0;
+
+    {
+        InlineTask<32> a(CountedFunctor(&numAlive, &numCalls));
+        EXPECT_EQ(numAlive, 1);
+
+        InlineTask<32> b(std::move(a));
+        EXPECT_FALSE(a);
+        EXPECT_EQ(numAlive, 1);
+
+        b();
+        EXPECT_EQ(numCalls, 1);
+
+        InlineTask<32> c([]() {});
+        c = std::move(b);
+        EXPECT_FALSE(b);
+        EXPECT_EQ(numAlive, 1);
+
+        c();
+        EXPECT_EQ(numCalls, 2);
+    }
+
+    EXPECT_EQ(numAlive, 0);
+}
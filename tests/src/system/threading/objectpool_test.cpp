@@ -0,0 +1,103 @@
+/*
+    This file is part of Spectre, an open-source physically based
+    spectral raytracing library.
+
+    Copyright (c) 2020-2023 Samuel Van Allen - All rights reserved.
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "gtest.h"
+#include "system/threading/objectpool.h"
+
+#include <set>
+#include <thread>
+
+namespace
+{
+    struct PooledObject
+    {
+        PooledObject(int value) : m_Value(value) { ++numAlive; }
+        ~PooledObject() { --numAlive; }
+
+        int m_Value;
+        char m_Padding[60];
+
+        static inline std::atomic_int numAlive = 0;
+    };
+}
+
+TEST(ObjectPoolTest, ConstructsAndDestroysObjects)
+{
+    PooledObject* object = ObjectPool<PooledObject>::Allocate(5);
+    EXPECT_EQ(object->m_Value, 5);
+    EXPECT_EQ(PooledObject::numAlive, 1);
+
+    ObjectPool<PooledObject>::Free(object);
+    EXPECT_EQ(PooledObject::numAlive, 0);
+
+    EXPECT_NO_THROW(ObjectPool<PooledObject>::Free(nullptr));
+}
+
+TEST(ObjectPoolTest, ReusesFreedSlots)
+{
+    PooledObject* first = ObjectPool<PooledObject>::Allocate(1);
+    ObjectPool<PooledObject>::Free(first);
+
+    PooledObject* second = ObjectPool<PooledObject>::Allocate(2);
+    EXPECT_EQ(first, second);
+    ObjectPool<PooledObject>::Free(second);
+}
+
+TEST(ObjectPoolTest, HandsOutDistinctSlots)
+{
+    std::vector<PooledObject*> objects;
+    for (int i = 0; i < 3 * ObjectPool<PooledObject>::BatchSize; ++i)
+        objects.push_back(ObjectPool<PooledObject>::Allocate(i));
+
+    std::set<PooledObject*> unique(objects.begin(), objects.end());
+    EXPECT_EQ(unique.size(), objects.size());
+
+    for (int i = 0; i < (int)objects.size(); ++i)
+    {
+        EXPECT_EQ(objects[i]->m_Value, i);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(objects[i]) % alignof(PooledObject), 0);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(objects[i]) % 64, 0);
+        ObjectPool<PooledObject>::Free(objects[i]);
+    }
+}
+
+TEST(ObjectPoolTest, CanFreeOnOtherThreads)
+{
+    // Producer allocates, consumer frees, which moves slots between threads
+    const int NumObjects = 20000;
+    std::vector<PooledObject*> objects(NumObjects);
+
+    for (int round = 0; round < 3; ++round)
+    {
+        std::thread producer([&]()
+        {
+            for (int i = 0; i < NumObjects; ++i)
+                objects[i] = ObjectPool<PooledObject>::Allocate(i);
+        });
+        producer.join();
+
+        std::thread consumer([&]()
+        {
+            for (int i = 0; i < NumObjects; ++i)
+                ObjectPool<PooledObject>::Free(objects[i]);
+        });
+        consumer.join();
+    }
+
+    EXPECT_EQ(PooledObject::numAlive, 0);
+}
@@ -0,0 +1,126 @@
+/*
+    This file is part of Spectre, an open-source physically based
+    spectral raytracing library.
+
+    Copyright (c) 2020-2023 Samuel Van Allen - All rights reserved.
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "gtest.h"
+#include "system/threading/parallelfor.h"
+
+TEST(ParallelForTest, VisitsEveryIndexOnce)
+{
+    for (SchedulingMode mode : { SchedulingMode::GlobalPriority, SchedulingMode::WorkStealing })
+    {
+        ThreadPool pool(4, mode);
+        std::vector<std::atomic_int> visits(10007);
+
+        ParallelFor(pool, 0, (int64_t)visits.size(), [&](int64_t i) { visits[i]++; });
+
+        for (size_t i = 0; i < visits.size(); ++i)
+            ASSERT_EQ(visits[i], 1) << "Index " << i;
+    }
+}
+
+TEST(ParallelForTest, HandlesEmptyAndOffsetRanges)
+{
+    ThreadPool pool(2, SchedulingMode::WorkStealing);
+    std::atomic_int sum = 0;
+
+    ParallelFor(pool, 5, 5, [&](int64_t) { sum++; });
+    ParallelFor(pool, 10, 3, [&](int64_t) { sum++; });
+    EXPECT_EQ(sum, 0);
+
+    ParallelFor(pool, -10, 11, [&](int64_t i) { sum += (int)i; });
+    EXPECT_EQ(sum, 0);
+}
+
+TEST(ParallelForTest, RunsOnCallerWithoutWorkers)
+{
+    ThreadPool pool(0);
+    int sum = 0;
+
+    ParallelFor(pool, 0, 100, [&](int64_t i) { sum += (int)i; });
+    EXPECT_EQ(sum, 4950);
+}
+
+TEST(ParallelForTest, CanComputeChunkSize)
+{
+    EXPECT_EQ(ParallelForLoop::ComputeChunkSize(1000, 1, 0), 125);
+    EXPECT_EQ(ParallelForLoop::ComputeChunkSize(1000, 4, 0), 32);
+    EXPECT_EQ(ParallelForLoop::ComputeChunkSize(1000, 4, 100), 100);
+    EXPECT_EQ(ParallelForLoop::ComputeChunkSize(3, 64, 0), 1);
+    EXPECT_THROW(ParallelForLoop::ComputeChunkSize(10, 4, -1), std::invalid_argument);
+}
+
+TEST(ParallelForTest, UsesFixedChunkSize)
+{
+    ThreadPool pool(3, SchedulingMode::WorkStealing);
+    std::mutex mutex;
+    std::vector<int64_t> chunkStarts;
+
+    ParallelForChunks(pool, 0, 100, 10, [&](int64_t i)
+    {
+        if (i % 10 == 0)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            chunkStarts.push_back(i);
+        }
+    });
+
+    std::sort(chunkStarts.begin(), chunkStarts.end());
+    ASSERT_EQ(chunkStarts.size(), 10);
+    for (int i = 0; i < 10; ++i)
+        EXPECT_EQ(chunkStarts[i], i * 10);
+}
+
+TEST(ParallelForTest, PropagatesExceptions)
+{
+    for (SchedulingMode mode : { SchedulingMode::GlobalPriority, SchedulingMode::WorkStealing })
+    {
+        ThreadPool pool(4, mode);
+        std::atomic_int numInvokes = 0;
+
+        EXPECT_THROW(ParallelFor(pool, 0, 100000, [&](int64_t i)
+        {
+            numInvokes++;
+            if (i == 500)
+                throw std::runtime_error("Failed iteration");
+        }, 100), std::runtime_error);
+
+        // Remaining chunks are cancelled rather than run to completion
+        EXPECT_LT(numInvokes, 100000);
+
+        // The pool stays usable afterwards
+        std::atomic_int sum = 0;
+        ParallelFor(pool, 0, 100, [&](int64_t) { sum++; });
+        EXPECT_EQ(sum, 100);
+    }
+}
+
+TEST(ParallelForTest, CanBeNested)
+{
+    for (SchedulingMode mode : { SchedulingMode::GlobalPriority, SchedulingMode::WorkStealing })
+    {
+        ThreadPool pool(4, mode);
+        std::atomic_int numInvokes = 0;
+
+        ParallelFor(pool, 0, 16, [&](int64_t)
+        {
+            ParallelFor(pool, 0, 64, [&](int64_t) { numInvokes++; });
+        }, 1);
+
+        EXPECT_EQ(numInvokes, 16 * 64);
+    }
+}
@@ -0,0 +1,172 @@
+/*
+    This file is part of Spectre, an open-source physically based
+    spectral raytracing library.
+
+    Copyright (c) 2020-2023 Samuel Van Allen - All rights reserved.
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "gtest.h"
+#include "system/threading/taskgraph.h"
+
+TEST(TaskGraphTest, CanAddNodes)
+{
+    TaskGraph graph;
+    TaskGraph::NodeId a = graph.AddNode([]() {});
+    TaskGraph::NodeId b = graph.AddNode([]() {}, { a });
+
+    EXPECT_EQ(a, 0);
+    EXPECT_EQ(b, 1);
+    EXPECT_EQ(graph.GetNumNodes(), 2);
+
+    EXPECT_THROW(graph.AddNode(nullptr), std::invalid_argument);
+    EXPECT_THROW(graph.AddNode([]() {}, { 5 }), std::invalid_argument);
+    EXPECT_THROW(graph.AddDependency(a, a), std::invalid_argument);
+}
+
+TEST(TaskGraphTest, RunsNodesAfterTheirDependencies)
+{
+    ThreadPool pool(4, SchedulingMode::WorkStealing);
+    TaskGraph graph;
+
+    // A diamond: render -> (tonemap, thumbnail) -> export
+    std::atomic_int step = 0;
+    int renderStep = -1, tonemapStep = -1, thumbnailStep = -1, exportStep = -1;
+
+    TaskGraph::NodeId render = graph.AddNode([&]() { renderStep = step++; });
+    TaskGraph::NodeId tonemap = graph.AddNode([&]() { tonemapStep = step++; }, { render });
+    TaskGraph::NodeId thumbnail = graph.AddNode([&]() { thumbnailStep = step++; }, { render });
+    graph.AddNode([&]() { exportStep = step++; }, { tonemap, thumbnail });
+
+    graph.Run(pool);
+
+    EXPECT_EQ(step, 4);
+    EXPECT_EQ(renderStep, 0);
+    EXPECT_GT(tonemapStep, renderStep);
+    EXPECT_GT(thumbnailStep, renderStep);
+    EXPECT_EQ(exportStep, 3);
+}
+
+TEST(TaskGraphTest, OverlapsIndependentChains)
+{
+    ThreadPool pool(2, SchedulingMode::WorkStealing);
+    TaskGraph graph;
+
+    // Exporting frame 0 blocks until frame 1 has started rendering, which can
+    // only happen if independent nodes do not wait for a stage barrier
+    std::promise<void> secondFrameStarted;
+    std::shared_future<void> started = secondFrameStarted.get_future().share();
+
+    TaskGraph::NodeId render0 = graph.AddNode([]() {});
+    TaskGraph::NodeId render1 = graph.AddNode([&]() { secondFrameStarted.set_value(); }, { render0 });
+    graph.AddNode([started]() { started.wait(); }, { render0 });
+    graph.AddNode([]() {}, { render1 });
+
+    graph.Run(pool);
+    EXPECT_EQ(started.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+}
+
+TEST(TaskGraphTest, DetectsCycles)
+{
+    ThreadPool pool(1, SchedulingMode::WorkStealing);
+    TaskGraph graph;
+
+    TaskGraph::NodeId a = graph.AddNode([]() {});
+    TaskGraph::NodeId b = graph.AddNode([]() {}, { a });
+    TaskGraph::NodeId c = graph.AddNode([]() {}, { b });
+    graph.AddDependency(c, a);
+
+    EXPECT_THROW(graph.Run(pool), std::invalid_argument);
+}
+
+TEST(TaskGraphTest, SkipsDependantsOfFailedNodes)
+{
+    ThreadPool pool(2, SchedulingMode::WorkStealing);
+    TaskGraph graph;
+
+    std::atomic_bool dependantRan = false;
+    std::atomic_bool unrelatedRan = false;
+
+    TaskGraph::NodeId failing = graph.AddNode([]() { throw std::runtime_error("Render failed"); });
+    TaskGraph::NodeId dependant = graph.AddNode([&]() { dependantRan = true; }, { failing });
+    graph.AddNode([&]() { dependantRan = true; }, { dependant });
+    graph.AddNode([&]() { unrelatedRan = true; });
+
+    EXPECT_THROW(graph.Run(pool), std::runtime_error);
+    EXPECT_FALSE(dependantRan);
+    EXPECT_TRUE(unrelatedRan);
+}
+
+TEST(TaskGraphTest, CanRunRepeatedly)
+{
+    for (SchedulingMode mode : { SchedulingMode::GlobalPriority, SchedulingMode::WorkStealing })
+    {
+        ThreadPool pool(3, mode);
+        TaskGraph graph;
+        std::atomic_int numInvokes = 0;
+
+        TaskGraph::NodeId root = graph.AddNode([&]() { numInvokes++; });
+        for (int i = 0; i < 10; ++i)
+            graph.AddNode([&]() { numInvokes++; }, { root });
+
+        for (int run = 0; run < 5; ++run)
+            graph.Run(pool);
+
+        EXPECT_EQ(numInvokes, 55);
+    }
+}
+
+TEST(TaskGraphTest, EmptyGraphRuns)
+{
+    ThreadPool pool(1);
+    TaskGraph graph;
+    EXPECT_NO_THROW(graph.Run(pool));
+}
+
+TEST(TaskGraphTest, ThrowsWhenThePoolDiscardsNodes)
+{
+    for (SchedulingMode mode : { SchedulingMode::GlobalPriority, SchedulingMode::WorkStealing })
+    {
+        ThreadPool pool(1, mode);
+        TaskGraph graph;
+        std::atomic_bool rootStarted = false;
+        std::atomic_bool dependantRan = false;
+
+        // The root outlives the shutdown, so its dependant is discarded
+        TaskGraph::NodeId root = graph.AddNode([&]()
+        {
+            rootStarted = true;
+            while (!pool.ShouldStop())
+                std::this_thread::yield();
+        });
+        graph.AddNode([&]() { dependantRan = true; }, { root });
+
+        std::thread runner([&]() { EXPECT_THROW(graph.Run(pool), std::runtime_error); });
+        while (!rootStarted)
+            std::this_thread::yield();
+
+        pool.Shutdown(ShutdownMode::Discard);
+        runner.join();
+        EXPECT_FALSE(dependantRan);
+    }
+}
+
+TEST(TaskGraphTest, ThrowsOnAStoppedPool)
+{
+    ThreadPool pool(1);
+    pool.Shutdown();
+
+    TaskGraph graph;
+    graph.AddNode([]() {});
+    EXPECT_THROW(graph.Run(pool), std::runtime_error);
+}
@@ -0,0 +1,81 @@
+/*
+    This file is part of Spectre, an open-source physically based
+    spectral raytracing library.
+
+    Copyright (c) 2020-2023 Samuel Van Allen - All rights reserved.
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "gtest.h"
+#include "system/threading/threadpool.h"
+
+#include <chrono>
+#include <iostream>
+
+// Contention benchmark comparing the scheduling modes on fine-grained tasks.
+// Disabled in the regular test run, run it with --gtest_also_run_disabled_tests
+// and raise NumTasks on a many-core machine to get meaningful numbers.
+namespace
+{
+    const int NumTasks = 50000;
+
+    double RunExternalSubmissions(SchedulingMode mode, int numThreads)
+    {
+        std::atomic_int numInvokes = 0;
+        auto start = std::chrono::steady_clock::now();
+        {
+            ThreadPool pool(numThreads, mode);
+            for (int i = 0; i < NumTasks; ++i)
+                pool.SpawnTask([&]() { numInvokes.fetch_add(1, std::memory_order_relaxed); });
+        }
+
+        EXPECT_EQ(numInvokes, NumTasks);
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    double RunNestedSubmissions(SchedulingMode mode, int numThreads)
+    {
+        const int NumRoots = 64;
+        std::atomic_int numInvokes = 0;
+        auto start = std::chrono::steady_clock::now();
+        {
+            ThreadPool pool(numThreads, mode);
+            for (int root = 0; root < NumRoots; ++root)
+            {
+                pool.SpawnTask([&]()
+                {
+                    for (int i = 0; i < NumTasks / NumRoots; ++i)
+                        pool.SpawnTask([&]() { numInvokes.fetch_add(1, std::memory_order_relaxed); });
+                });
+            }
+        }
+
+        EXPECT_EQ(numInvokes, (NumTasks / NumRoots) * NumRoots);
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+TEST(ThreadPoolBenchmark, DISABLED_FineGrainedTaskContention)
+{
+    int numThreads = std::max(2, (int)std::thread::hardware_concurrency());
+
+    for (SchedulingMode mode : { SchedulingMode::GlobalPriority, SchedulingMode::WorkStealing })
+    {
+        const char* name = mode == SchedulingMode::GlobalPriority ? "GlobalPriority" : "WorkStealing";
+        double externalMs = RunExternalSubmissions(mode, numThreads);
+        double nestedMs = RunNestedSubmissions(mode, numThreads);
+
+        std::cout << "[ BENCHMARK ] " << name << " (" << numThreads << " threads, " << NumTasks << " tasks): "
+                  << "external " << externalMs << " ms, nested " << nestedMs << " ms" << std::endl;
+    }
+}
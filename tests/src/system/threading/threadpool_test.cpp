@@ -146,3 +146,334 @@ TEST(ThreadPoolTest, TaskCanHavePriority)
     }
 }
 
+
+TEST(ThreadPoolTest, DefaultsToGlobalPriorityScheduling)
+{
+    ThreadPool pool(2);
+    EXPECT_EQ(pool.GetSchedulingMode(), SchedulingMode::GlobalPriority);
+    EXPECT_EQ(pool.GetNumThreads(), 2);
+}
+
+TEST(ThreadPoolTest, WorkStealingWillJoinThreadsOnDestroy)
+{
+    const int NumThreads = 4;
+    std::atomic_int numInvokes = 0;
+
+    {
+        ThreadPool pool(NumThreads, SchedulingMode::WorkStealing);
+        for (int i = 0; i < 100; ++i)
+            pool.SpawnTask([&]() { numInvokes++; });
+
+        for (int i = 0; i < 100; ++i)
+            pool.ScheduleTask(i, [&]() { numInvokes++; });
+    }
+
+    EXPECT_EQ(numInvokes, 200);
+}
+
+TEST(ThreadPoolTest, WorkStealingTasksCanSpawnTasks)
+{
+    const int NumThreads = 4;
+    std::atomic_int numLeaves = 0;
+
+    std::function<void(ThreadPool&, int)> split = [&](ThreadPool& pool, int depth)
+    {
+        if (depth == 0)
+        {
+            numLeaves++;
+            return;
+        }
+
+        pool.SpawnTask(split, std::ref(pool), depth - 1);
+        pool.SpawnTask(split, std::ref(pool), depth - 1);
+    };
+
+    {
+        ThreadPool pool(NumThreads, SchedulingMode::WorkStealing);
+        pool.SpawnTask(split, std::ref(pool), 12);
+    }
+
+    EXPECT_EQ(numLeaves, 1 << 12);
+}
+
+TEST(ThreadPoolTest, WorkStealingKeepsPriorityLaneOrder)
+{
+    const int NumThreads = 1;
+
+    std::queue<int> order;
+    std::mutex mutex;
+    mutex.lock();
+
+    {
+        ThreadPool pool(NumThreads, SchedulingMode::WorkStealing);
+
+        // Lockup first thread to give time to adding other tasks
+        pool.ScheduleTask(99999, [&]()
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+        });
+
+        for (int i = 0; i < 20; ++i)
+            pool.ScheduleTask(i, [&order](int i) { order.emplace(i); }, i);
+
+        mutex.unlock();
+    }
+
+    for (int i = 19; i > 0; --i)
+    {
+        EXPECT_EQ(order.front(), i);
+        order.pop();
+    }
+}
+
+TEST(ThreadPoolTest, WorkStealingNeedsWorkers)
+{
+    EXPECT_THROW(ThreadPool pool(0, SchedulingMode::WorkStealing), std::invalid_argument);
+}
+
+TEST(ThreadPoolTest, FuturesReturnResults)
+{
+    for (SchedulingMode mode : { SchedulingMode::GlobalPriority, SchedulingMode::WorkStealing })
+    {
+        ThreadPool pool(2, mode);
+
+        std::future<int> scheduled = pool.ScheduleFuture(1, [](int a, int b) { return a + b; }, 2, 3);
+        std::future<std::string> spawned = pool.SpawnFuture([]() { return std::string("spawned"); });
+        std::future<void> empty = pool.SpawnFuture([]() {});
+
+        EXPECT_EQ(scheduled.get(), 5);
+        EXPECT_EQ(spawned.get(), "spawned");
+        EXPECT_NO_THROW(empty.get());
+    }
+}
+
+TEST(ThreadPoolTest, FuturesPropagateExceptions)
+{
+    ThreadPool pool(2, SchedulingMode::WorkStealing);
+
+    std::future<int> future = pool.SpawnFuture([]() -> int { throw std::runtime_error("Task failed"); });
+    EXPECT_THROW(future.get(), std::runtime_error);
+}
+
+TEST(ThreadPoolTest, CanWaitForAllTasks)
+{
+    for (SchedulingMode mode : { SchedulingMode::GlobalPriority, SchedulingMode::WorkStealing })
+    {
+        ThreadPool pool(4, mode);
+        std::atomic_int numInvokes = 0;
+
+        for (int i = 0; i < 100; ++i)
+        {
+            pool.SpawnTask([&]()
+            {
+                numInvokes++;
+                pool.SpawnTask([&]() { numInvokes++; });
+            });
+        }
+
+        pool.WaitAll();
+        EXPECT_EQ(numInvokes, 200);
+        EXPECT_FALSE(pool.HasTasksLeft());
+
+        // The barrier can be reused for the next stage
+        pool.SpawnTask([&]() { numInvokes++; });
+        pool.WaitAll();
+        EXPECT_EQ(numInvokes, 201);
+    }
+}
+
+TEST(ThreadPoolTest, CannotWaitAllFromWorker)
+{
+    ThreadPool pool(1, SchedulingMode::WorkStealing);
+    std::future<void> future = pool.SpawnFuture([&]() { pool.WaitAll(); });
+    EXPECT_THROW(future.get(), std::runtime_error);
+}
+
+TEST(ThreadPoolTest, CanScheduleLargeAndMoveOnlyTasks)
+{
+    for (SchedulingMode mode : { SchedulingMode::GlobalPriority, SchedulingMode::WorkStealing })
+    {
+        std::atomic_int sum = 0;
+
+        {
+            ThreadPool pool(2, mode);
+
+            // Too large for the inline task buffer, so it is boxed
+            std::array<int, 64> values;
+            values.fill(1);
+            EXPECT_FALSE(ThreadPool::Task::Fits<decltype(values)>);
+            pool.SpawnTask([values, &sum]() { for (int v : values) sum += v; });
+
+            auto owned = std::make_unique<int>(100);
+            pool.SpawnTask([owned = std::move(owned), &sum]() { sum += *owned; });
+        }
+
+        EXPECT_EQ(sum, 164);
+    }
+}
+
+TEST(ThreadPoolTest, ReleasesUnstartedTasks)
+{
+    auto shared = std::make_shared<int>(0);
+
+    {
+        ThreadPool pool(0);
+        pool.ScheduleTask(0, [shared]() {});
+        EXPECT_EQ(shared.use_count(), 2);
+    }
+
+    EXPECT_EQ(shared.use_count(), 1);
+}
+
+TEST(ThreadPoolTest, CanPinWorkers)
+{
+    for (SchedulingMode mode : { SchedulingMode::GlobalPriority, SchedulingMode::WorkStealing })
+    {
+        std::atomic_int count = 0;
+
+        {
+            ThreadPool pool(2, mode, AffinityPolicy::Compact);
+            EXPECT_EQ(pool.GetAffinityPolicy(), AffinityPolicy::Compact);
+
+            for (int i = 0; i < 16; ++i)
+                pool.SpawnTask([&count]() { ++count; });
+        }
+
+        EXPECT_EQ(count, 16);
+    }
+}
+
+TEST(ThreadPoolTest, CanSpawnTasksOnNumaNodes)
+{
+    // Both nodes map onto CPU 0, which always exists
+    CpuTopology topology({ { 0, 0, 0, 0 }, { 0, 1, 0, 1 } });
+    ThreadPool pool(4, SchedulingMode::WorkStealing, AffinityPolicy::Scatter, topology);
+    ASSERT_EQ(pool.GetNumNumaNodes(), 2);
+    EXPECT_EQ(pool.GetNumWorkersOnNode(0), 2);
+    EXPECT_EQ(pool.GetNumWorkersOnNode(1), 2);
+    EXPECT_EQ(pool.GetCurrentNumaNode(), 0);
+
+    std::atomic_int count = 0;
+    std::atomic_int numOnNode = 0;
+    for (int i = 0; i < 64; ++i)
+    {
+        int node = i % 2;
+        pool.SpawnTaskOnNode(node, [&, node]()
+        {
+            if (pool.GetCurrentNumaNode() == node)
+                ++numOnNode;
+
+            ++count;
+        });
+    }
+
+    pool.WaitAll();
+    EXPECT_EQ(count, 64);
+    EXPECT_GT(numOnNode, 0);
+
+    EXPECT_THROW(pool.SpawnTaskOnNode(2, []() {}), std::invalid_argument);
+    EXPECT_THROW(pool.SpawnTaskOnNode(-1, []() {}), std::invalid_argument);
+}
+
+TEST(ThreadPoolTest, UnpinnedPoolsHaveOneNumaNode)
+{
+    ThreadPool pool(2, SchedulingMode::WorkStealing);
+    EXPECT_EQ(pool.GetNumNumaNodes(), 1);
+    EXPECT_EQ(pool.GetNumWorkersOnNode(0), 2);
+}
+
+TEST(ThreadPoolTest, SkipsCancelledTasks)
+{
+    for (SchedulingMode mode : { SchedulingMode::GlobalPriority, SchedulingMode::WorkStealing })
+    {
+        ThreadPool pool(2, mode);
+        pool.Pause();
+
+        CancellationToken stale;
+        CancellationToken fresh;
+        std::atomic_int numStale = 0;
+        std::atomic_int numFresh = 0;
+        for (int i = 0; i < 8; ++i)
+        {
+            pool.SpawnCancellableTask(stale, [&numStale]() { ++numStale; });
+            pool.ScheduleCancellableTask(fresh, 1, [&numFresh]() { ++numFresh; });
+        }
+
+        stale.Cancel();
+        pool.Resume();
+        pool.WaitAll();
+
+        EXPECT_EQ(numStale, 0);
+        EXPECT_EQ(numFresh, 8);
+
+        ThreadPoolProgress progress = pool.GetProgress();
+        EXPECT_EQ(progress.m_NumQueued, 0);
+        EXPECT_EQ(progress.m_NumRunning, 0);
+        EXPECT_EQ(progress.m_NumFinished, 16);
+        EXPECT_EQ(progress.m_NumCancelled, 8);
+    }
+}
+
+TEST(ThreadPoolTest, CanPauseAndResume)
+{
+    for (SchedulingMode mode : { SchedulingMode::GlobalPriority, SchedulingMode::WorkStealing })
+    {
+        ThreadPool pool(2, mode);
+        pool.Pause();
+        EXPECT_TRUE(pool.IsPaused());
+
+        std::atomic_int count = 0;
+        for (int i = 0; i < 8; ++i)
+            pool.SpawnTask([&count]() { ++count; });
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        EXPECT_EQ(count, 0);
+        EXPECT_EQ(pool.GetProgress().m_NumQueued, 8);
+
+        pool.Resume();
+        EXPECT_FALSE(pool.IsPaused());
+        pool.WaitAll();
+        EXPECT_EQ(count, 8);
+    }
+}
+
+TEST(ThreadPoolTest, ShutdownCanDrainOrDiscard)
+{
+    for (SchedulingMode mode : { SchedulingMode::GlobalPriority, SchedulingMode::WorkStealing })
+    {
+        for (ShutdownMode shutdownMode : { ShutdownMode::Drain, ShutdownMode::Discard })
+        {
+            ThreadPool pool(2, mode);
+            pool.Pause();
+
+            std::atomic_int count = 0;
+            for (int i = 0; i < 8; ++i)
+                pool.SpawnTask([&count]() { ++count; });
+
+            pool.Shutdown(shutdownMode);
+            EXPECT_TRUE(pool.ShouldStop());
+            EXPECT_EQ(count, shutdownMode == ShutdownMode::Drain ? 8 : 0);
+            EXPECT_EQ(pool.GetProgress().m_NumFinished, 8);
+            EXPECT_EQ(pool.GetProgress().m_NumCancelled, shutdownMode == ShutdownMode::Drain ? 0 : 8);
+
+            EXPECT_THROW(pool.SpawnTask([]() {}), std::runtime_error);
+        }
+    }
+}
+
+TEST(ThreadPoolTest, DiscardedFuturesAreBroken)
+{
+    ThreadPool pool(1, SchedulingMode::WorkStealing);
+    pool.Pause();
+
+    std::future<int> future = pool.SpawnFuture([]() { return 1; });
+    pool.Shutdown(ShutdownMode::Discard);
+    EXPECT_THROW(future.get(), std::future_error);
+}
+
+TEST(ThreadPoolTest, CannotShutdownFromWorker)
+{
+    ThreadPool pool(1);
+    std::future<void> future = pool.SpawnFuture([&pool]() { pool.Shutdown(); });
+    EXPECT_THROW(future.get(), std::runtime_error);
+}
@@ -0,0 +1,120 @@
+/*
+    This file is part of Spectre, an open-source physically based
+    spectral raytracing library.
+
+    Copyright (c) 2020-2023 Samuel Van Allen - All rights reserved.
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "gtest.h"
+#include "system/threading/workstealingdeque.h"
+
+#include <thread>
+
+TEST(WorkStealingDequeTest, RejectsInvalidCapacity)
+{
+    EXPECT_THROW(WorkStealingDeque<int> deque(0), std::invalid_argument);
+    EXPECT_THROW(WorkStealingDeque<int> deque(12), std::invalid_argument);
+}
+
+TEST(WorkStealingDequeTest, OwnerPopsInLifoOrder)
+{
+    WorkStealingDeque<int> deque;
+    for (int i = 0; i < 10; ++i)
+        deque.Push(i);
+
+    EXPECT_EQ(deque.GetSize(), 10);
+
+    int item;
+    for (int i = 9; i >= 0; --i)
+    {
+        ASSERT_TRUE(deque.Pop(item));
+        EXPECT_EQ(item, i);
+    }
+
+    EXPECT_FALSE(deque.Pop(item));
+    EXPECT_TRUE(deque.IsEmpty());
+}
+
+TEST(WorkStealingDequeTest, ThievesStealInFifoOrder)
+{
+    WorkStealingDeque<int> deque;
+    for (int i = 0; i < 10; ++i)
+        deque.Push(i);
+
+    int item;
+    for (int i = 0; i < 10; ++i)
+    {
+        ASSERT_TRUE(deque.Steal(item));
+        EXPECT_EQ(item, i);
+    }
+
+    EXPECT_FALSE(deque.Steal(item));
+}
+
+TEST(WorkStealingDequeTest, GrowsPastInitialCapacity)
+{
+    WorkStealingDeque<int> deque(4);
+    for (int i = 0; i < 1000; ++i)
+        deque.Push(i);
+
+    int item;
+    ASSERT_TRUE(deque.Steal(item));
+    EXPECT_EQ(item, 0);
+
+    for (int i = 999; i > 0; --i)
+    {
+        ASSERT_TRUE(deque.Pop(item));
+        EXPECT_EQ(item, i);
+    }
+}
+
+TEST(WorkStealingDequeTest, EveryItemIsTakenExactlyOnce)
+{
+    const int NumItems = 100000;
+    const int NumThieves = 3;
+
+    WorkStealingDeque<int> deque(16);
+    std::vector<std::atomic_int> taken(NumItems);
+    std::atomic_bool done = false;
+
+    std::vector<std::thread> thieves;
+    for (int t = 0; t < NumThieves; ++t)
+    {
+        thieves.emplace_back([&]()
+        {
+            int item;
+            while (!done || !deque.IsEmpty())
+                if (deque.Steal(item))
+                    ++taken[item];
+        });
+    }
+
+    int item;
+    for (int i = 0; i < NumItems; ++i)
+    {
+        deque.Push(i);
+        if (i % 3 == 0 && deque.Pop(item))
+            ++taken[item];
+    }
+
+    while (deque.Pop(item))
+        ++taken[item];
+
+    done = true;
+    for (std::thread& thief : thieves)
+        thief.join();
+
+    for (int i = 0; i < NumItems; ++i)
+        ASSERT_EQ(taken[i], 1) << "Item " << i;
+}
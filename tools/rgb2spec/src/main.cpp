@@ -0,0 +1,345 @@
+/*
+    This file is part of Spectre, an open-source physically based
+    spectral raytracing library.
+
+    Copyright (c) 2020-2023 Samuel Van Allen - All rights reserved.
+
+    Spectre is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Offline fitter for the RGB to spectrum coefficient table, following
+// Jakob & Hanika, "A Low-Dimensional Function Space for Efficient Spectral
+// Upsampling" (2019). For every cell of a res^3 grid over (linear) sRGB it
+// finds the coefficients of a quadratic polynomial whose sigmoid, lit by D65,
+// reproduces that colour. The grid is parameterized by the largest component
+// z and the two others relative to it, x and y, once for each choice of
+// largest component.
+//
+// Output layout (native endianness), read back by RgbToSpectrumTable:
+//   char     magic[4]                       "SPEC"
+//   uint32   resolution
+//   float    zNodes[resolution]
+//   float    coefficients[3][resolution (z)][resolution (y)][resolution (x)][3]
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "core/spectrum/spectralconstants.h"
+
+namespace
+{
+    // The CIE tables are tabulated at 1nm, fitting against every 5th sample is
+    // plenty accurate and keeps the build step short
+    const int SampleStride = 5;
+    const int NumFitSamples = (numCieSamples - 1) / SampleStride + 1;
+    const double FitMinWavelength = 360.0;
+    const double FitMaxWavelength = 830.0;
+
+    // CIE standard illuminant D65 at 10nm from 360nm to 830nm
+    const double d65Samples[] = {
+        46.6383, 52.0891, 49.9755, 54.6482, 82.7549, 91.4860, 93.4318, 86.6823, 104.865, 117.008,
+        117.812, 114.861, 115.923, 108.811, 109.354, 107.802, 104.790, 107.689, 104.405, 104.046,
+        100.000, 96.3342, 95.7880, 88.6856, 90.0062, 89.5991, 87.6987, 83.2886, 83.6992, 80.0268,
+        80.2146, 82.2778, 78.2842, 69.7213, 71.6091, 74.3490, 61.6040, 69.8856, 75.0870, 63.5927,
+        46.4182, 66.8054, 63.3828, 64.3040, 59.4519, 51.9590, 57.4406, 60.3125
+    };
+
+    const double xyzToRgb[3][3] = {
+        {  3.240479, -1.537150, -0.498535 },
+        { -0.969256,  1.875991,  0.041556 },
+        {  0.055648, -0.204043,  1.057311 }
+    };
+
+    const double rgbToXyz[3][3] = {
+        { 0.412453, 0.357580, 0.180423 },
+        { 0.212671, 0.715160, 0.072169 },
+        { 0.019334, 0.119193, 0.950227 }
+    };
+
+    double fitLambda[NumFitSamples];
+    double rgbWeights[3][NumFitSamples];
+    double whitePoint[3];
+
+    double EvaluateD65(double lambda)
+    {
+        double offset = (lambda - 360.0) / 10.0;
+        int index = std::min((int)offset, 46);
+        double t = offset - index;
+        return d65Samples[index] * (1 - t) + d65Samples[index + 1] * t;
+    }
+
+    void InitWeights()
+    {
+        double xyzWeights[3][NumFitSamples];
+        double normalization = 0;
+        whitePoint[0] = whitePoint[1] = whitePoint[2] = 0;
+
+        for (int i = 0; i < NumFitSamples; ++i)
+        {
+            int cieIndex = i * SampleStride;
+            double lambda = cieLambda[cieIndex];
+            double weight = (i == 0 || i == NumFitSamples - 1) ? 0.5 : 1.0;
+            double illum = EvaluateD65(lambda) * weight;
+
+            fitLambda[i] = (lambda - FitMinWavelength) / (FitMaxWavelength - FitMinWavelength);
+            xyzWeights[0][i] = cieSamplesX[cieIndex] * illum;
+            xyzWeights[1][i] = cieSamplesY[cieIndex] * illum;
+            xyzWeights[2][i] = cieSamplesZ[cieIndex] * illum;
+            normalization += xyzWeights[1][i];
+        }
+
+        for (int i = 0; i < NumFitSamples; ++i)
+        {
+            for (int c = 0; c < 3; ++c)
+            {
+                xyzWeights[c][i] /= normalization;
+                whitePoint[c] += xyzWeights[c][i];
+            }
+
+            for (int c = 0; c < 3; ++c)
+                rgbWeights[c][i] = xyzToRgb[c][0] * xyzWeights[0][i] + xyzToRgb[c][1] * xyzWeights[1][i] + xyzToRgb[c][2] * xyzWeights[2][i];
+        }
+    }
+
+    double Sigmoid(double x)
+    {
+        return 0.5 + x / (2.0 * std::sqrt(1.0 + x * x));
+    }
+
+    // Converts linear sRGB to CIELAB in place, residuals are measured in Lab so
+    // that the fit error is roughly perceptually uniform
+    void RgbToLab(double* p)
+    {
+        double xyz[3];
+        for (int c = 0; c < 3; ++c)
+            xyz[c] = rgbToXyz[c][0] * p[0] + rgbToXyz[c][1] * p[1] + rgbToXyz[c][2] * p[2];
+
+        auto f = [](double t) {
+            const double delta = 6.0 / 29.0;
+            return t > delta * delta * delta ? std::cbrt(t) : t / (3 * delta * delta) + 4.0 / 29.0;
+        };
+
+        double fx = f(xyz[0] / whitePoint[0]);
+        double fy = f(xyz[1] / whitePoint[1]);
+        double fz = f(xyz[2] / whitePoint[2]);
+        p[0] = 116.0 * fy - 16.0;
+        p[1] = 500.0 * (fx - fy);
+        p[2] = 200.0 * (fy - fz);
+    }
+
+    void EvaluateResidual(const double* coeffs, const double* rgb, double* residual)
+    {
+        double out[3] = { 0, 0, 0 };
+        for (int i = 0; i < NumFitSamples; ++i)
+        {
+            double x = fitLambda[i];
+            double s = Sigmoid((coeffs[0] * x + coeffs[1]) * x + coeffs[2]);
+            for (int c = 0; c < 3; ++c)
+                out[c] += rgbWeights[c][i] * s;
+        }
+
+        RgbToLab(out);
+        std::memcpy(residual, rgb, sizeof(double) * 3);
+        RgbToLab(residual);
+
+        for (int c = 0; c < 3; ++c)
+            residual[c] -= out[c];
+    }
+
+    void EvaluateJacobian(const double* coeffs, const double* rgb, double jacobian[3][3])
+    {
+        const double epsilon = 1e-5;
+        for (int i = 0; i < 3; ++i)
+        {
+            double tmp[3] = { coeffs[0], coeffs[1], coeffs[2] };
+            double r0[3], r1[3];
+
+            tmp[i] = coeffs[i] - epsilon;
+            EvaluateResidual(tmp, rgb, r0);
+            tmp[i] = coeffs[i] + epsilon;
+            EvaluateResidual(tmp, rgb, r1);
+
+            for (int j = 0; j < 3; ++j)
+                jacobian[j][i] = (r1[j] - r0[j]) / (2 * epsilon);
+        }
+    }
+
+    // Solves a * x = b with partial pivoting, returns false if a is singular
+    bool Solve3x3(double a[3][3], double* b, double* x)
+    {
+        for (int col = 0; col < 3; ++col)
+        {
+            int pivot = col;
+            for (int row = col + 1; row < 3; ++row)
+                if (std::abs(a[row][col]) > std::abs(a[pivot][col]))
+                    pivot = row;
+
+            if (std::abs(a[pivot][col]) < 1e-15)
+                return false;
+
+            std::swap(a[col], a[pivot]);
+            std::swap(b[col], b[pivot]);
+
+            for (int row = col + 1; row < 3; ++row)
+            {
+                double factor = a[row][col] / a[col][col];
+                for (int k = col; k < 3; ++k)
+                    a[row][k] -= factor * a[col][k];
+                b[row] -= factor * b[col];
+            }
+        }
+
+        for (int row = 2; row >= 0; --row)
+        {
+            double sum = b[row];
+            for (int k = row + 1; k < 3; ++k)
+                sum -= a[row][k] * x[k];
+            x[row] = sum / a[row][row];
+        }
+
+        return true;
+    }
+
+    void GaussNewton(const double* rgb, double* coeffs)
+    {
+        for (int iteration = 0; iteration < 15; ++iteration)
+        {
+            double residual[3], jacobian[3][3], step[3];
+            EvaluateResidual(coeffs, rgb, residual);
+            EvaluateJacobian(coeffs, rgb, jacobian);
+
+            if (!Solve3x3(jacobian, residual, step))
+                break;
+
+            double error = 0;
+            for (int i = 0; i < 3; ++i)
+            {
+                coeffs[i] -= step[i];
+                error += residual[i] * residual[i];
+            }
+
+            // Keep the polynomial from blowing up for saturated colours
+            double largest = std::max(std::max(std::abs(coeffs[0]), std::abs(coeffs[1])), std::abs(coeffs[2]));
+            if (largest > 200)
+                for (int i = 0; i < 3; ++i)
+                    coeffs[i] *= 200 / largest;
+
+            if (error < 1e-6)
+                break;
+        }
+    }
+
+    double SmoothStep(double x)
+    {
+        return x * x * (3.0 - 2.0 * x);
+    }
+
+    // Converts coefficients of the polynomial over the normalized [0, 1] range
+    // into coefficients over wavelengths in nm
+    void StoreCoefficients(const double* coeffs, float* out)
+    {
+        double c0 = FitMinWavelength;
+        double c1 = 1.0 / (FitMaxWavelength - FitMinWavelength);
+        double a = coeffs[0], b = coeffs[1], c = coeffs[2];
+
+        out[0] = float(a * c1 * c1);
+        out[1] = float(b * c1 - 2 * a * c0 * c1 * c1);
+        out[2] = float(c - b * c0 * c1 + a * c0 * c0 * c1 * c1);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc != 3)
+    {
+        fprintf(stderr, "Usage: Rgb2Spec <resolution> <output file>\n");
+        return EXIT_FAILURE;
+    }
+
+    const int res = atoi(argv[1]);
+    if (res < 2)
+    {
+        fprintf(stderr, "Rgb2Spec: resolution must be at least 2\n");
+        return EXIT_FAILURE;
+    }
+
+    InitWeights();
+
+    std::vector<float> zNodes(res);
+    for (int k = 0; k < res; ++k)
+        zNodes[k] = float(SmoothStep(SmoothStep(k / double(res - 1))));
+
+    std::vector<float> table(size_t(3) * res * res * res * 3);
+
+    // Start from a neutral guess where the fit is easy and walk outwards along
+    // z, reusing each solution as the initial guess for its neighbour
+    const int start = res / 5;
+    for (int l = 0; l < 3; ++l)
+    {
+        for (int j = 0; j < res; ++j)
+        {
+            const double y = j / double(res - 1);
+            for (int i = 0; i < res; ++i)
+            {
+                const double x = i / double(res - 1);
+                auto fitRange = [&](int from, int to, int step) {
+                    double coeffs[3] = { 0, 0, 0 };
+                    for (int k = from; k != to; k += step)
+                    {
+                        double z = zNodes[k];
+                        double rgb[3];
+                        rgb[l] = z;
+                        rgb[(l + 1) % 3] = x * z;
+                        rgb[(l + 2) % 3] = y * z;
+
+                        GaussNewton(rgb, coeffs);
+
+                        size_t index = ((size_t(l) * res + k) * res + j) * res + i;
+                        StoreCoefficients(coeffs, &table[index * 3]);
+                    }
+                };
+
+                fitRange(start, res, 1);
+                fitRange(start, -1, -1);
+            }
+        }
+    }
+
+    FILE* file = fopen(argv[2], "wb");
+    if (!file)
+    {
+        fprintf(stderr, "Rgb2Spec: could not open %s for writing\n", argv[2]);
+        return EXIT_FAILURE;
+    }
+
+    uint32_t resolution = uint32_t(res);
+    bool ok = fwrite("SPEC", 4, 1, file) == 1 &&
+              fwrite(&resolution, sizeof(resolution), 1, file) == 1 &&
+              fwrite(zNodes.data(), sizeof(float), zNodes.size(), file) == zNodes.size() &&
+              fwrite(table.data(), sizeof(float), table.size(), file) == table.size();
+    fclose(file);
+
+    if (!ok)
+    {
+        fprintf(stderr, "Rgb2Spec: failed to write %s\n", argv[2]);
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}